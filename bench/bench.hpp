@@ -0,0 +1,65 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+
+
+namespace bench
+{
+// HELPERS
+// -------
+
+
+/** \brief Prevent the optimizer from discarding a computed value.
+ */
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T *sink;
+    sink = &value;
+#endif
+}
+
+
+/** \brief Time `function` and print nanoseconds per call and throughput.
+ *
+ *  The function is called repeatedly until at least 200ms elapse, so
+ *  short kernels are measured over many iterations.
+ *
+ *  \param bytes        Bytes processed per call, or 0 to omit throughput.
+ */
+template <typename Function>
+void run(const char *name,
+    size_t bytes,
+    Function &&function)
+{
+    typedef std::chrono::steady_clock clock;
+    const auto budget = std::chrono::milliseconds(200);
+
+    size_t iterations = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    do {
+        for (size_t i = 0; i < 16; ++i) {
+            function();
+        }
+        iterations += 16;
+        elapsed = clock::now() - start;
+    } while (elapsed < budget);
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    if (bytes) {
+        std::printf("%-40s %12.1f ns %10.2f GB/s\n", name, ns, bytes / ns);
+    } else {
+        std::printf("%-40s %12.1f ns\n", name, ns);
+    }
+}
+
+}   /* bench */
@@ -0,0 +1,170 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+
+#include <string>
+#include <vector>
+
+// noipa also stops GCC from hoisting calls it proves are pure.
+#if defined(__GNUC__) && !defined(__clang__)
+#   define BENCH_NOINLINE __attribute__((noipa))
+#elif defined(__clang__)
+#   define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#   define BENCH_NOINLINE __declspec(noinline)
+#else
+#   define BENCH_NOINLINE
+#endif
+
+// HELPERS
+// -------
+
+
+/** \brief View with a user-provided copy constructor, as `wtl::string` had.
+ *
+ *  Non-trivially-copyable arguments are passed by hidden reference to a
+ *  temporary in memory, rather than in two registers.
+ */
+struct legacy_string
+{
+    const char *data_;
+    size_t length_;
+
+    legacy_string(const char *data, size_t length):
+        data_(data),
+        length_(length)
+    {}
+
+    legacy_string(const legacy_string &other):
+        data_(other.data_),
+        length_(other.length_)
+    {}
+};
+
+
+BENCH_NOINLINE size_t by_value(wtl::string str)
+{
+    return str.size() + static_cast<unsigned char>(str.front());
+}
+
+
+BENCH_NOINLINE size_t by_reference(const wtl::string &str)
+{
+    return str.size() + static_cast<unsigned char>(str.front());
+}
+
+
+BENCH_NOINLINE size_t by_pointer(const char *data,
+    size_t length)
+{
+    return length + static_cast<unsigned char>(*data);
+}
+
+
+BENCH_NOINLINE size_t by_legacy(legacy_string str)
+{
+    return str.length_ + static_cast<unsigned char>(*str.data_);
+}
+
+
+BENCH_NOINLINE wtl::string return_value(const char *data,
+    size_t length)
+{
+    return wtl::string(data, length);
+}
+
+
+BENCH_NOINLINE legacy_string return_legacy(const char *data,
+    size_t length)
+{
+    return legacy_string(data, length);
+}
+
+
+BENCH_NOINLINE size_t vector_by_value(wtl::vector<int> vec)
+{
+    return vec.size() + static_cast<size_t>(vec.front());
+}
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    const size_t calls = 4096;
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < calls; ++i) {
+        strings.push_back(std::string(1 + i % 24, static_cast<char>('a' + i % 26)));
+    }
+    std::vector<wtl::string> views(strings.begin(), strings.end());
+    std::vector<legacy_string> legacy;
+    for (const std::string &str: strings) {
+        legacy.emplace_back(str.data(), str.size());
+    }
+    std::vector<int> ints(16, 1);
+    const wtl::vector<int> vec(ints);
+
+    std::printf("%zu calls per iteration\n", calls);
+    bench::run("  wtl::string by value", 0, [&] {
+        size_t sum = 0;
+        for (const wtl::string &view: views) {
+            sum += by_value(view);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  wtl::string by reference", 0, [&] {
+        size_t sum = 0;
+        for (const wtl::string &view: views) {
+            sum += by_reference(view);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  pointer and length", 0, [&] {
+        size_t sum = 0;
+        for (const wtl::string &view: views) {
+            sum += by_pointer(view.data(), view.size());
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  non-trivial view by value", 0, [&] {
+        size_t sum = 0;
+        for (const legacy_string &view: legacy) {
+            sum += by_legacy(view);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  wtl::string returned", 0, [&] {
+        size_t sum = 0;
+        for (const wtl::string &view: views) {
+            sum += return_value(view.data(), view.size()).size();
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  non-trivial view returned", 0, [&] {
+        size_t sum = 0;
+        for (const wtl::string &view: views) {
+            sum += return_legacy(view.data(), view.size()).length_;
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  wtl::vector by value", 0, [&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < calls; ++i) {
+            sum += vector_by_value(vec);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    return 0;
+}
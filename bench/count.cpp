@@ -0,0 +1,86 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+template <typename T>
+static void bench_vector(const char *type,
+    size_t length)
+{
+    std::mt19937 gen(42);
+    std::vector<T> data(length);
+    for (T &value: data) {
+        value = static_cast<T>(gen() % 100);
+    }
+    const wtl::vector<T> vector(data);
+    const size_t bytes = length * sizeof(T);
+
+    std::string name = std::string("  std::count<") + type + ">";
+    bench::run(name.data(), bytes, [&] {
+        bench::do_not_optimize(std::count(data.begin(), data.end(), T(7)));
+    });
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::isa level = wtl::set_isa(static_cast<wtl::isa>(i));
+        name = std::string("  wtl::vector<") + type + ">::count [" + wtl::isa_name(level) + "]";
+        bench::run(name.data(), bytes, [&] {
+            bench::do_not_optimize(vector.count(T(7)));
+        });
+    }
+    wtl::reset_isa();
+}
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    const size_t length = 1 << 22;
+    std::mt19937 gen(42);
+    std::string data(length, 'x');
+    for (char &c: data) {
+        unsigned value = gen() % 64;
+        c = value == 0 ? '\n' : value < 4 ? ',' : 'a' + value % 26;
+    }
+    const wtl::string str(data);
+    const wtl::byteset delimiters(",\n");
+
+    std::printf("string (%zu bytes)\n", length);
+    bench::run("  std::count('\\n')", length, [&] {
+        bench::do_not_optimize(std::count(data.begin(), data.end(), '\n'));
+    });
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::isa level = wtl::set_isa(static_cast<wtl::isa>(i));
+        std::string name = std::string("  wtl::string::count('\\n') [") + wtl::isa_name(level) + "]";
+        bench::run(name.data(), length, [&] {
+            bench::do_not_optimize(str.count('\n'));
+        });
+        name = std::string("  wtl::string::count_of(\",\\n\") [") + wtl::isa_name(level) + "]";
+        bench::run(name.data(), length, [&] {
+            bench::do_not_optimize(str.count_of(delimiters));
+        });
+    }
+    wtl::reset_isa();
+
+    std::printf("vector (%zu elements)\n", length / 4);
+    bench_vector<uint8_t>("uint8_t", length / 4);
+    bench_vector<uint16_t>("uint16_t", length / 4);
+    bench_vector<int32_t>("int32_t", length / 4);
+    bench_vector<int64_t>("int64_t", length / 4);
+    bench_vector<float>("float", length / 4);
+    bench_vector<double>("double", length / 4);
+
+    return 0;
+}
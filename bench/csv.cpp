@@ -0,0 +1,109 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/csv.hpp>
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+/** \brief Parser materializing each field, as a typical CSV library.
+ */
+static size_t naive_fields(const std::string &data)
+{
+    std::vector<std::string> row;
+    std::string field;
+    bool inside = false;
+    size_t count = 0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        const char c = data[i];
+        if (c == '"') {
+            if (inside && i + 1 < data.size() && data[i + 1] == '"') {
+                field.push_back('"');
+                ++i;
+            } else {
+                inside = !inside;
+            }
+        } else if (!inside && (c == ',' || c == '\n')) {
+            row.push_back(field);
+            field.clear();
+            if (c == '\n') {
+                count += row.size();
+                row.clear();
+            }
+        } else {
+            field.push_back(c);
+        }
+    }
+    return count;
+}
+
+
+static size_t wtl_fields(const wtl::string &str)
+{
+    wtl::arena scratch;
+    wtl::csv_reader reader(str, wtl::csv_dialect(), &scratch);
+    wtl::vector<wtl::string> row;
+    size_t count = 0;
+    while (reader.next(row)) {
+        count += row.size();
+    }
+    return count;
+}
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    // numeric columns, text, and a quoted column with occasional escapes
+    const size_t length = 1 << 26;
+    std::mt19937 gen(42);
+    std::string data;
+    data.reserve(length + 200);
+    while (data.size() < length) {
+        data += std::to_string(gen() % 100000) + ',';
+        data += std::to_string(gen()) + '.' + std::to_string(gen() % 100) + ',';
+        data.append(4 + gen() % 24, 'x');
+        data += ",\"";
+        data.append(gen() % 40, 'y');
+        data += gen() % 8 ? "" : "\"\"z\"\"";
+        data += ",y\"\n";
+    }
+    const wtl::string str(data);
+
+    bench::run("naive std::string fields", length, [&] {
+        bench::do_not_optimize(naive_fields(data));
+    });
+
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::isa level = wtl::set_isa(static_cast<wtl::isa>(i));
+        std::string name = std::string("wtl::csv_reader [") + wtl::isa_name(level) + "]";
+        bench::run(name.data(), length, [&] {
+            bench::do_not_optimize(wtl_fields(str));
+        });
+    }
+    wtl::reset_isa();
+
+    for (size_t threads = 2; threads <= std::thread::hardware_concurrency(); threads *= 2) {
+        std::string name = "wtl::csv_parallel [" + std::to_string(threads) + " threads]";
+        bench::run(name.data(), length, [&] {
+            std::atomic<size_t> count(0);
+            wtl::csv_parallel(str, threads, [&](size_t, const wtl::string &shard) {
+                count += wtl_fields(shard);
+            });
+            bench::do_not_optimize(count.load());
+        });
+    }
+
+    return 0;
+}
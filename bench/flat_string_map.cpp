@@ -0,0 +1,79 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/flat_string_map.hpp>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    // vocabulary of short tokens, looked up from a separate token stream
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> length(3, 12);
+    std::vector<std::string> vocabulary;
+    for (size_t i = 0; i < 50000; ++i) {
+        std::string word;
+        for (int j = length(gen); j > 0; --j) {
+            word.push_back(static_cast<char>(letter(gen)));
+        }
+        vocabulary.push_back(word);
+    }
+
+    std::uniform_int_distribution<size_t> pick(0, vocabulary.size() - 1);
+    std::string text;
+    std::vector<wtl::string> tokens;
+    std::vector<size_t> offsets;
+    for (size_t i = 0; i < 200000; ++i) {
+        offsets.push_back(text.size());
+        text += vocabulary[pick(gen)];
+        text += ' ';
+    }
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        size_t end = i + 1 < offsets.size() ? offsets[i + 1] - 1 : text.size() - 1;
+        tokens.push_back(wtl::string(text.data() + offsets[i], end - offsets[i]));
+    }
+
+    wtl::flat_string_map<int> flat;
+    std::unordered_map<wtl::string, int> view_map;
+    std::unordered_map<std::string, int> owned_map;
+    for (size_t i = 0; i < vocabulary.size(); ++i) {
+        flat[vocabulary[i]] = static_cast<int>(i);
+        view_map[vocabulary[i]] = static_cast<int>(i);
+        owned_map[vocabulary[i]] = static_cast<int>(i);
+    }
+
+    std::printf("%zu lookups into %zu keys\n", tokens.size(), vocabulary.size());
+    bench::run("  wtl::flat_string_map", 0, [&] {
+        long sum = 0;
+        for (const wtl::string &token: tokens) {
+            sum += flat.find(token)->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("  std::unordered_map<wtl::string>", 0, [&] {
+        long sum = 0;
+        for (const wtl::string &token: tokens) {
+            sum += view_map.find(token)->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("  std::unordered_map<std::string>", 0, [&] {
+        long sum = 0;
+        for (const wtl::string &token: tokens) {
+            sum += owned_map.find(std::string(token))->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/format.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#   if __has_include(<charconv>)
+#       include <charconv>
+#   endif
+#endif
+
+// BENCHMARKS
+// ----------
+
+
+template <typename T>
+static void run_numbers(const char *label,
+    const std::vector<T> &values,
+    const char *printf_spec)
+{
+    // bytes of shortest output
+    char data[64];
+    size_t bytes = 0;
+    for (T value: values) {
+        wtl::format_buffer buffer(data, sizeof(data));
+        bytes += (buffer << value).size();
+    }
+
+    std::printf("%s\n", label);
+    bench::run("  std::ostringstream", bytes, [&] {
+        size_t size = 0;
+        for (T value: values) {
+            std::ostringstream stream;
+            stream << value;
+            size += stream.str().size();
+        }
+        bench::do_not_optimize(size);
+    });
+
+    bench::run("  std::snprintf", bytes, [&] {
+        size_t size = 0;
+        for (T value: values) {
+            size += static_cast<size_t>(std::snprintf(data, sizeof(data), printf_spec, value));
+        }
+        bench::do_not_optimize(size);
+    });
+
+#if defined(__cpp_lib_to_chars)
+    bench::run("  std::to_chars", bytes, [&] {
+        size_t size = 0;
+        for (T value: values) {
+            size += static_cast<size_t>(std::to_chars(data, data + sizeof(data), value).ptr - data);
+        }
+        bench::do_not_optimize(size);
+    });
+#endif
+
+    bench::run("  wtl::format_buffer", bytes, [&] {
+        size_t size = 0;
+        wtl::format_buffer buffer(data, sizeof(data));
+        for (T value: values) {
+            buffer.clear();
+            buffer << value;
+            size += buffer.size();
+        }
+        bench::do_not_optimize(size);
+    });
+}
+
+
+static void run_spec(const std::vector<long long> &integers,
+    const std::vector<double> &doubles)
+{
+    std::vector<std::string> names;
+    for (size_t i = 0; i < integers.size(); ++i) {
+        names.push_back("field" + std::to_string(i % 100));
+    }
+    std::vector<wtl::string> views(names.begin(), names.end());
+    size_t bytes = 0;
+    for (size_t i = 0; i < integers.size(); ++i) {
+        bytes += names[i].size() + std::to_string(integers[i]).size() + 8;
+    }
+    char data[256];
+
+    std::printf("records\n");
+    bench::run("  std::snprintf", bytes, [&] {
+        size_t size = 0;
+        for (size_t i = 0; i < integers.size(); ++i) {
+            size += static_cast<size_t>(std::snprintf(data, sizeof(data), "%s=%lld (%llx) %.17g", names[i].data(), integers[i], static_cast<unsigned long long>(integers[i]), doubles[i]));
+        }
+        bench::do_not_optimize(size);
+    });
+
+    bench::run("  wtl::format", bytes, [&] {
+        size_t size = 0;
+        wtl::format_buffer buffer(data, sizeof(data));
+        for (size_t i = 0; i < integers.size(); ++i) {
+            buffer.clear();
+            size += wtl::format(buffer, WTL_FORMAT("{}={} ({:x}) {}"), views[i], integers[i], integers[i], doubles[i]).size();
+        }
+        bench::do_not_optimize(size);
+    });
+}
+
+
+int main()
+{
+    const size_t count = 1 << 16;
+    std::mt19937_64 gen(42);
+    std::vector<long long> small;
+    std::vector<long long> large;
+    std::vector<double> doubles;
+    for (size_t i = 0; i < count; ++i) {
+        small.push_back(static_cast<long long>(gen() % 100000));
+        large.push_back(static_cast<long long>(gen() | (1ULL << 62)));
+        uint64_t bits = (gen() >> 2) | (1ULL << 61);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        doubles.push_back(value);
+    }
+
+    run_numbers("1-5 digits", small, "%lld");
+    run_numbers("19 digits", large, "%lld");
+    run_numbers("shortest doubles", doubles, "%.17g");
+    run_spec(large, doubles);
+
+    return 0;
+}
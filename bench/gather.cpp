@@ -0,0 +1,96 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/gather.hpp>
+
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(WTL_POSIX)
+
+// HELPERS
+// -------
+
+
+/** \brief `count` disjoint views of `min` to `max` bytes into `pool`.
+ */
+static std::vector<wtl::string> make_views(const std::string &pool,
+    size_t count,
+    size_t min,
+    size_t max)
+{
+    std::mt19937 gen(42);
+    std::vector<wtl::string> views;
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t length = min + gen() % (max - min + 1);
+        views.emplace_back(pool.data() + offset, length);
+        offset += length + 1;
+    }
+    return views;
+}
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    const std::string pool(1 << 20, 'x');
+    const int fd = ::open("/dev/null", O_WRONLY);
+    std::ofstream stream("/dev/null", std::ios::binary);
+
+    struct workload {
+        const char *name;
+        size_t min;
+        size_t max;
+    };
+    for (const workload &load: {workload {"small views", 4, 32}, workload {"large views", 512, 4096}}) {
+        std::vector<wtl::string> views = make_views(pool, 48, load.min, load.max);
+        size_t bytes = 0;
+        for (const wtl::string &view: views) {
+            bytes += view.size();
+        }
+        std::printf("48 %s, %zu bytes\n", load.name, bytes);
+
+        bench::run("  std::ostream", bytes, [&] {
+            for (wtl::string &view: views) {
+                stream << view;
+            }
+            stream.flush();
+        });
+
+        std::string buffer;
+        bench::run("  memcpy + write", bytes, [&] {
+            buffer.clear();
+            for (const wtl::string &view: views) {
+                buffer.append(view.data(), view.size());
+            }
+            bench::do_not_optimize(::write(fd, buffer.data(), buffer.size()));
+        });
+
+        wtl::gather_writer writer;
+        bench::run("  wtl::gather_writer", bytes, [&] {
+            for (const wtl::string &view: views) {
+                writer << view;
+            }
+            bench::do_not_optimize(writer.flush(fd));
+        });
+    }
+
+    ::close(fd);
+    return 0;
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
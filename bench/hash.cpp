@@ -0,0 +1,46 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/hash.hpp>
+
+#include <random>
+#include <string>
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    std::string data(1 << 20, '\0');
+    std::mt19937 gen(42);
+    for (char &c: data) {
+        c = static_cast<char>(gen());
+    }
+
+    for (size_t length: {8, 16, 32, 64, 256, 1024, 4096, 1 << 16, 1 << 20}) {
+        const std::string key = data.substr(0, length);
+        std::printf("key length %zu\n", length);
+
+        bench::run("  wtl::hash_bytes", length, [&] {
+            bench::do_not_optimize(wtl::hash_bytes(key.data(), key.size()));
+        });
+        bench::run("  std::hash<std::string>", length, [&] {
+            bench::do_not_optimize(std::hash<std::string>()(key));
+        });
+        if (length > 256) {
+            for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+                wtl::isa level = wtl::set_isa(static_cast<wtl::isa>(i));
+                std::string name = std::string("  wtl::hash_bytes [") + wtl::isa_name(level) + "]";
+                bench::run(name.data(), length, [&] {
+                    bench::do_not_optimize(wtl::hash_bytes(key.data(), key.size()));
+                });
+            }
+            wtl::reset_isa();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/lines.hpp>
+
+#include <random>
+#include <string>
+#include <thread>
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    const size_t length = 1 << 26;
+    std::mt19937 gen(42);
+    std::string data;
+    data.reserve(length + 200);
+    while (data.size() < length) {
+        data.append(20 + gen() % 120, 'x');
+        data.push_back('\n');
+    }
+    const wtl::string str(data);
+
+    bench::run("wtl::lines", length, [&] {
+        size_t count = 0;
+        for (const wtl::string &line: wtl::lines(str)) {
+            count += line.size();
+        }
+        bench::do_not_optimize(count);
+    });
+
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::isa level = wtl::set_isa(static_cast<wtl::isa>(i));
+        std::string name = std::string("wtl::line_index [") + wtl::isa_name(level) + "]";
+        bench::run(name.data(), length, [&] {
+            bench::do_not_optimize(wtl::line_index(str).size());
+        });
+    }
+    wtl::reset_isa();
+
+    for (size_t threads = 2; threads <= std::thread::hardware_concurrency(); threads *= 2) {
+        std::string name = "wtl::line_index [" + std::to_string(threads) + " threads]";
+        bench::run(name.data(), length, [&] {
+            bench::do_not_optimize(wtl::line_index(str, threads).size());
+        });
+    }
+
+    return 0;
+}
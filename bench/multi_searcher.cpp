@@ -0,0 +1,80 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/multi_searcher.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+static std::string random_word(std::mt19937 &gen,
+    size_t length)
+{
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::string word(length, '\0');
+    for (char &c: word) {
+        c = static_cast<char>(letter(gen));
+    }
+    return word;
+}
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> size(4, 12);
+
+    std::vector<std::string> keywords(300);
+    for (std::string &keyword: keywords) {
+        keyword = random_word(gen, size(gen));
+    }
+    std::vector<std::string> records(2000);
+    size_t bytes = 0;
+    for (std::string &record: records) {
+        while (record.size() < 200) {
+            record += random_word(gen, size(gen)) + ' ';
+        }
+        bytes += record.size();
+    }
+
+    wtl::multi_searcher searcher(keywords);
+    std::printf("%zu keywords, %zu DFA states\n", keywords.size(), searcher.states());
+
+    bench::run("repeated basic_string::find", bytes, [&] {
+        size_t count = 0;
+        for (const std::string &record: records) {
+            wtl::string str(record);
+            for (const std::string &keyword: keywords) {
+                count += str.find(keyword) != wtl::string::npos;
+            }
+        }
+        bench::do_not_optimize(count);
+    });
+    bench::run("multi_searcher::find_all", bytes, [&] {
+        size_t count = 0;
+        for (const std::string &record: records) {
+            searcher.find_all(record, [&count](const wtl::multi_searcher::match &) {
+                ++count;
+            });
+        }
+        bench::do_not_optimize(count);
+    });
+    bench::run("multi_searcher::find_first", bytes, [&] {
+        size_t count = 0;
+        for (const std::string &record: records) {
+            count += searcher.contains(record);
+        }
+        bench::do_not_optimize(count);
+    });
+
+    return 0;
+}
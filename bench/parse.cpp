@@ -0,0 +1,159 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/parse.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#   if __has_include(<charconv>)
+#       include <charconv>
+#   endif
+#endif
+
+// BENCHMARKS
+// ----------
+
+
+static void run_integers(const char *label,
+    const std::vector<std::string> &strings)
+{
+    size_t bytes = 0;
+    for (const std::string &str: strings) {
+        bytes += str.size();
+    }
+    std::vector<wtl::string> views(strings.begin(), strings.end());
+    const wtl::vector<wtl::string> column(views);
+    std::vector<int64_t> out(column.size());
+
+    std::printf("%s\n", label);
+    bench::run("  std::stoll", bytes, [&] {
+        int64_t sum = 0;
+        for (const wtl::string &view: views) {
+            sum += std::stoll(std::string(view));
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  std::strtoll", bytes, [&] {
+        int64_t sum = 0;
+        for (const std::string &str: strings) {
+            sum += std::strtoll(str.data(), nullptr, 10);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  wtl::parse", bytes, [&] {
+        int64_t sum = 0;
+        for (const wtl::string &view: views) {
+            sum += wtl::parse<int64_t>(view).value;
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::isa level = wtl::set_isa(static_cast<wtl::isa>(i));
+        std::string name = std::string("  wtl::parse column [") + wtl::isa_name(level) + "]";
+        bench::run(name.data(), bytes, [&] {
+            bench::do_not_optimize(wtl::parse(column, out.data()));
+            bench::do_not_optimize(out[0]);
+        });
+    }
+    wtl::reset_isa();
+}
+
+
+static void run_floats(const char *label,
+    const std::vector<std::string> &strings)
+{
+    size_t bytes = 0;
+    for (const std::string &str: strings) {
+        bytes += str.size();
+    }
+    std::vector<wtl::string> views(strings.begin(), strings.end());
+    const wtl::vector<wtl::string> column(views);
+    std::vector<double> out(column.size());
+
+    std::printf("%s\n", label);
+    bench::run("  std::strtod via std::string", bytes, [&] {
+        double sum = 0;
+        for (const wtl::string &view: views) {
+            sum += std::strtod(std::string(view).data(), nullptr);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  std::strtod", bytes, [&] {
+        double sum = 0;
+        for (const std::string &str: strings) {
+            sum += std::strtod(str.data(), nullptr);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+#if defined(__cpp_lib_to_chars)
+    bench::run("  std::from_chars", bytes, [&] {
+        double sum = 0;
+        for (const wtl::string &view: views) {
+            double value = 0;
+            std::from_chars(view.data(), view.data() + view.size(), value);
+            sum += value;
+        }
+        bench::do_not_optimize(sum);
+    });
+#endif
+
+    bench::run("  wtl::parse", bytes, [&] {
+        double sum = 0;
+        for (const wtl::string &view: views) {
+            sum += wtl::parse<double>(view).value;
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("  wtl::parse column", bytes, [&] {
+        bench::do_not_optimize(wtl::parse(column, out.data()));
+        bench::do_not_optimize(out[0]);
+    });
+}
+
+
+int main()
+{
+    const size_t count = 1 << 16;
+    std::mt19937_64 gen(42);
+    std::vector<std::string> small;
+    std::vector<std::string> large;
+    for (size_t i = 0; i < count; ++i) {
+        small.push_back(std::to_string(gen() % 100000));
+        large.push_back(std::to_string(static_cast<int64_t>(gen() | (1ULL << 62))));
+    }
+
+    run_integers("1-5 digits", small);
+    run_integers("19 digits", large);
+
+    // prices, and random doubles printed with 17 significant digits
+    std::vector<std::string> prices;
+    std::vector<std::string> doubles;
+    char buffer[64];
+    for (size_t i = 0; i < count; ++i) {
+        prices.push_back(std::to_string(gen() % 100000) + "." + std::to_string(10 + gen() % 90));
+        uint64_t bits = (gen() >> 2) | (1ULL << 61);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        doubles.push_back(buffer);
+    }
+
+    run_floats("prices", prices);
+    run_floats("17 digits", doubles);
+
+    return 0;
+}
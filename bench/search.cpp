@@ -0,0 +1,79 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/string.hpp>
+
+#include <random>
+#include <string>
+#include <string.h>
+
+// HELPERS
+// -------
+
+
+/** \brief Reference implementation: the original sliding `std::equal`.
+ */
+static const char * find_loop(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen)
+{
+    for (; length >= sublen; --length, ++first) {
+        if (std::equal(substr, substr + sublen, first)) {
+            return first;
+        }
+    }
+    return nullptr;
+}
+
+
+static std::string make_haystack(size_t length)
+{
+    static const char words[][8] = {
+        "INFO", "WARN", "request", "GET", "POST", "latency", "user", "id=",
+        "200", "404", "ms", "path=/", "api", "v1", "session", "token",
+    };
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 15);
+    std::string str;
+    while (str.size() < length) {
+        str += words[dist(gen)];
+        str += ' ';
+    }
+    str.resize(length);
+    return str;
+}
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    const std::string haystack = make_haystack(1 << 20);
+    const wtl::string view(haystack);
+
+    for (size_t sublen: {1, 2, 8, 16, 24, 40, 100}) {
+        // needle absent from the haystack, so every call scans it fully,
+        // with common first and last bytes to load the candidate filter
+        std::string needle = "#";
+        if (sublen > 1) {
+            needle = 'l' + std::string(sublen - 2, 'a') + 'y';
+        }
+        std::printf("needle length %zu\n", sublen);
+
+        bench::run("  wtl::string::find", haystack.size(), [&] {
+            bench::do_not_optimize(view.find(needle));
+        });
+        bench::run("  sliding std::equal", haystack.size(), [&] {
+            bench::do_not_optimize(find_loop(haystack.data(), haystack.size(), needle.data(), needle.size()));
+        });
+        bench::run("  memmem", haystack.size(), [&] {
+            bench::do_not_optimize(memmem(haystack.data(), haystack.size(), needle.data(), needle.size()));
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/searcher.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+static std::vector<std::string> make_records(size_t count)
+{
+    static const char words[][8] = {
+        "INFO", "WARN", "request", "GET", "POST", "latency", "user", "id=",
+        "200", "404", "ms", "path=/", "api", "v1", "session", "token",
+    };
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 15);
+    std::vector<std::string> records(count);
+    for (std::string &record: records) {
+        for (int i = 0; i < 12; ++i) {
+            record += words[dist(gen)];
+            record += ' ';
+        }
+    }
+    return records;
+}
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    const std::vector<std::string> records = make_records(10000);
+    size_t bytes = 0;
+    for (const std::string &record: records) {
+        bytes += record.size();
+    }
+
+    for (std::string needle: {"session token", "latency=42ms user=1234567 path=/api/v1/session"}) {
+        wtl::searcher searcher(needle);
+        std::printf("needle length %zu\n", needle.size());
+
+        bench::run("  basic_string::find(const char *)", bytes, [&] {
+            for (const std::string &record: records) {
+                bench::do_not_optimize(wtl::string(record).find(needle.c_str()));
+            }
+        });
+        bench::run("  basic_string::find(searcher)", bytes, [&] {
+            for (const std::string &record: records) {
+                bench::do_not_optimize(wtl::string(record).find(searcher));
+            }
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/tokenizer.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+/** \brief Random words of 1-12 letters, separated by `separator`.
+ */
+static std::string make_feed(size_t length,
+    char separator)
+{
+    std::mt19937 gen(42);
+    std::string str;
+    while (str.size() < length) {
+        str.append(1 + gen() % 12, static_cast<char>('a' + gen() % 26));
+        str.push_back(separator);
+    }
+    str.resize(length);
+    return str;
+}
+
+// BENCHMARKS
+// ----------
+
+
+int main()
+{
+    const size_t length = 1 << 22;
+    std::vector<uint32_t> buffer(wtl::tokenizer::bound(length));
+
+    for (char separator: {' ', ','}) {
+        const std::string feed = make_feed(length, separator);
+        const wtl::string str(feed);
+        const wtl::byteset set(separator == ' ' ? " \t\n" : ",\n");
+        const wtl::split_empty empty = separator == ' ' ? wtl::split_empty::skip : wtl::split_empty::keep;
+        std::printf("separator '%c'\n", separator);
+
+        bench::run("  wtl::split", length, [&] {
+            size_t count = 0;
+            for (const wtl::string &token: wtl::split(str, set, empty)) {
+                buffer[count++] = static_cast<uint32_t>(token.data() - str.data());
+                buffer[count++] = static_cast<uint32_t>(token.size());
+            }
+            bench::do_not_optimize(count);
+        });
+
+        wtl::tokenizer tokenizer(set, empty);
+        for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+            wtl::isa level = wtl::set_isa(static_cast<wtl::isa>(i));
+            std::string name = std::string("  wtl::tokenizer [") + wtl::isa_name(level) + "]";
+            bench::run(name.data(), length, [&] {
+                bench::do_not_optimize(tokenizer.tokenize(str, buffer.data(), buffer.size()));
+            });
+        }
+        wtl::reset_isa();
+    }
+
+    return 0;
+}
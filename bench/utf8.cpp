@@ -0,0 +1,91 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include "bench.hpp"
+
+#include <wtl/utf8.hpp>
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+// HELPERS
+// -------
+
+
+/** \brief Byte-at-a-time validation, as a baseline.
+ */
+static size_t naive_validate(const std::string &str)
+{
+    const unsigned char *data = reinterpret_cast<const unsigned char*>(str.data());
+    size_t i = 0;
+    while (i < str.size()) {
+        const size_t length = wtl::detail::utf8_sequence(str.data() + i, str.size() - i);
+        if (length == 0) {
+            return i;
+        }
+        i += data[i] < 0x80 ? 1 : length;
+    }
+    return i;
+}
+
+
+/** \brief Text with `percent` of its characters outside ASCII.
+ */
+static std::string make_text(size_t size,
+    unsigned percent)
+{
+    static const char *samples[] = {"\xC3\xA9", "\xD0\xB6", "\xE2\x82\xAC", "\xE6\x97\xA5", "\xF0\x9F\x98\x80"};
+    std::mt19937_64 gen(7);
+    std::string str;
+    while (str.size() < size) {
+        if (gen() % 100 < percent) {
+            str += samples[gen() % 5];
+        } else {
+            str.push_back(gen() % 8 ? static_cast<char>('a' + gen() % 26) : ' ');
+        }
+    }
+    return str;
+}
+
+// BENCHMARKS
+// ----------
+
+
+static void run_text(const char *label,
+    const std::string &str)
+{
+    std::printf("%s\n", label);
+    bench::run("  naive", str.size(), [&] {
+        bench::do_not_optimize(naive_validate(str));
+    });
+
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::isa level = wtl::set_isa(static_cast<wtl::isa>(i));
+        std::string name = std::string("  wtl::utf8::validate [") + wtl::isa_name(level) + "]";
+        bench::run(name.data(), str.size(), [&] {
+            bench::do_not_optimize(wtl::utf8::validate(str));
+        });
+    }
+    wtl::reset_isa();
+
+    wtl::utf8::stream_validator validator;
+    bench::run("  wtl::utf8::stream_validator, 4KB chunks", str.size(), [&] {
+        validator.reset();
+        for (size_t offset = 0; offset < str.size(); offset += 4096) {
+            validator.feed(wtl::string(str).substr(offset, 4096));
+        }
+        bench::do_not_optimize(validator.finish());
+    });
+}
+
+
+int main()
+{
+    const size_t size = 1 << 22;
+    run_text("ASCII", make_text(size, 0));
+    run_text("1% multibyte", make_text(size, 1));
+    run_text("50% multibyte", make_text(size, 50));
+
+    return 0;
+}
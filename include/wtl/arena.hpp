@@ -0,0 +1,255 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/string.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Bump allocator handing out memory from large blocks.
+ *
+ *  Allocation advances a cursor within the current block, and a new
+ *  block is started only when one is exhausted. Requests larger than a
+ *  block get a dedicated block. Memory is released all at once by
+ *  `reset`, or by destroying the arena, never per allocation, and
+ *  `rewind` recycles every block in constant time.
+ */
+class arena
+{
+protected:
+    struct block
+    {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<block> blocks_;
+    std::vector<block> large_;
+    size_t block_size_;
+    size_t current_ = 0;
+    size_t large_used_ = 0;
+    char *cursor_ = nullptr;
+    char *limit_ = nullptr;
+    size_t used_ = 0;
+
+    char * next_block();
+    char * large_block(size_t size);
+
+public:
+    // MEMBER VARIABLES
+    // ----------------
+    static const size_t default_block_size = 64 * 1024;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    explicit arena(size_t block_size = default_block_size);
+    arena(const arena &other) = delete;
+    arena & operator=(const arena &other) = delete;
+    arena(arena &&other) noexcept;
+    arena & operator=(arena &&other) noexcept;
+
+    // ALLOCATION
+    void * allocate(size_t n,
+        size_t alignment = alignof(std::max_align_t));
+    string copy(const string &str);
+    void reset() noexcept;
+    void rewind() noexcept;
+
+    // STATISTICS
+    size_t blocks() const noexcept;
+    size_t reserved() const noexcept;
+    size_t used() const noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+inline arena::arena(size_t block_size):
+    block_size_(block_size)
+{
+    if (block_size_ == 0) {
+        block_size_ = default_block_size;
+    }
+}
+
+
+inline arena::arena(arena &&other) noexcept:
+    blocks_(std::move(other.blocks_)),
+    large_(std::move(other.large_)),
+    block_size_(other.block_size_),
+    current_(other.current_),
+    large_used_(other.large_used_),
+    cursor_(other.cursor_),
+    limit_(other.limit_),
+    used_(other.used_)
+{
+    other.blocks_.clear();
+    other.large_.clear();
+    other.current_ = other.large_used_ = 0;
+    other.cursor_ = other.limit_ = nullptr;
+    other.used_ = 0;
+}
+
+
+inline arena & arena::operator=(arena &&other) noexcept
+{
+    std::swap(blocks_, other.blocks_);
+    std::swap(large_, other.large_);
+    std::swap(block_size_, other.block_size_);
+    std::swap(current_, other.current_);
+    std::swap(large_used_, other.large_used_);
+    std::swap(cursor_, other.cursor_);
+    std::swap(limit_, other.limit_);
+    std::swap(used_, other.used_);
+    return *this;
+}
+
+
+/** \brief Open the next block, reusing one kept by `rewind` if any.
+ */
+inline char * arena::next_block()
+{
+    size_t next = cursor_ ? current_ + 1 : 0;
+    if (next == blocks_.size()) {
+        blocks_.push_back(block {std::unique_ptr<char[]>(new char[block_size_]), block_size_});
+    }
+    current_ = next;
+    cursor_ = blocks_[current_].data.get();
+    limit_ = cursor_ + block_size_;
+    return cursor_;
+}
+
+
+/** \brief Dedicated block of at least `size` bytes.
+ *
+ *  Blocks kept by `rewind` are reused in order, and replaced when
+ *  too small for the request.
+ */
+inline char * arena::large_block(size_t size)
+{
+    if (large_used_ == large_.size()) {
+        large_.push_back(block {std::unique_ptr<char[]>(new char[size]), size});
+    } else if (large_[large_used_].size < size) {
+        large_[large_used_] = block {std::unique_ptr<char[]>(new char[size]), size};
+    }
+    return large_[large_used_++].data.get();
+}
+
+
+/** \brief Allocate `n` bytes aligned to `alignment`, a power of 2.
+ *
+ *  Throws `std::bad_alloc` if `n` plus the alignment overflows.
+ */
+inline void * arena::allocate(size_t n,
+    size_t alignment)
+{
+    if (n > SIZE_MAX - alignment) {
+        throw std::bad_alloc();
+    }
+
+    size_t padding = (0 - reinterpret_cast<uintptr_t>(cursor_)) & (alignment - 1);
+    size_t remaining = static_cast<size_t>(limit_ - cursor_);
+    if (cursor_ && n <= remaining && padding <= remaining - n) {
+        char *result = cursor_ + padding;
+        cursor_ = result + n;
+        used_ += n;
+        return result;
+    }
+
+    char *result;
+    if (n + alignment > block_size_ / 2) {
+        // dedicated block, keeping the current block open
+        result = large_block(n + alignment);
+        result += (0 - reinterpret_cast<uintptr_t>(result)) & (alignment - 1);
+    } else {
+        result = next_block();
+        result += (0 - reinterpret_cast<uintptr_t>(result)) & (alignment - 1);
+        cursor_ = result + n;
+    }
+    used_ += n;
+    return result;
+}
+
+
+/** \brief Copy `str` into the arena, followed by a null terminator.
+ */
+inline string arena::copy(const string &str)
+{
+    char *data = static_cast<char*>(allocate(str.size() + 1, 1));
+    if (!str.empty()) {
+        std::memcpy(data, str.data(), str.size());
+    }
+    data[str.size()] = '\0';
+    return string(data, str.size());
+}
+
+
+/** \brief Release every allocation, keeping one block for reuse.
+ *
+ *  Costs one deallocation per extra block, and nothing per allocation.
+ */
+inline void arena::reset() noexcept
+{
+    blocks_.resize(blocks_.empty() ? 0 : 1);
+    large_.clear();
+    current_ = large_used_ = 0;
+    cursor_ = blocks_.empty() ? nullptr : blocks_[0].data.get();
+    limit_ = cursor_ ? cursor_ + block_size_ : nullptr;
+    used_ = 0;
+}
+
+
+/** \brief Release every allocation in constant time, keeping all blocks.
+ *
+ *  Later allocations refill the kept blocks before allocating more, so
+ *  the arena holds its peak footprint until `reset` or destruction.
+ */
+inline void arena::rewind() noexcept
+{
+    current_ = large_used_ = 0;
+    cursor_ = blocks_.empty() ? nullptr : blocks_[0].data.get();
+    limit_ = cursor_ ? cursor_ + block_size_ : nullptr;
+    used_ = 0;
+}
+
+
+inline size_t arena::blocks() const noexcept
+{
+    return blocks_.size() + large_.size();
+}
+
+
+/** \brief Bytes held in blocks, used or not.
+ */
+inline size_t arena::reserved() const noexcept
+{
+    size_t total = blocks_.size() * block_size_;
+    for (const block &b: large_) {
+        total += b.size;
+    }
+    return total;
+}
+
+
+/** \brief Bytes handed out since construction or the last `reset`.
+ */
+inline size_t arena::used() const noexcept
+{
+    return used_;
+}
+
+}   /* wtl */
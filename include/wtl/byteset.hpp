@@ -0,0 +1,652 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/dispatch.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <cstring>
+#include <string>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Precompiled set of bytes for `find_first_of` and friends.
+ *
+ *  Stores the set as a 256-bit bitmap for scalar code, and as a pair
+ *  of nibble lookup tables for the SSSE3/AVX2 `pshufb` classifier, so
+ *  membership of any byte in a set of up to 256 members is tested in
+ *  constant time. The scan kernel is selected for the active `isa`.
+ *  Build the set once and reuse it across searches.
+ */
+class byteset
+{
+protected:
+    uint64_t bits_[4] = {0, 0, 0, 0};
+    uint8_t low_[16] = {};
+    uint8_t high_[16] = {};
+    char members_[16] = {};
+    size_t size_ = 0;
+
+    typedef const char * (byteset::*kernel)(const char *, size_t, bool) const;
+    typedef void (byteset::*classifier)(const char *, size_t, uint64_t *) const;
+
+    const char * find_scalar(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+    const char * rfind_scalar(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+    void classify_scalar(const char *first,
+        size_t length,
+        uint64_t *bits) const noexcept;
+#if defined(WTL_X86)
+    uint32_t match_sse2(const char *block) const noexcept;
+    uint32_t match_ssse3(const char *block) const noexcept;
+    uint32_t match_avx2(const char *block) const noexcept;
+    template <bool Padded>
+    const char * find_sse2(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+    template <bool Padded>
+    const char * find_ssse3(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+    template <bool Padded>
+    const char * find_avx2(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+    template <bool Padded>
+    const char * rfind_sse2(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+    template <bool Padded>
+    const char * rfind_ssse3(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+    template <bool Padded>
+    const char * rfind_avx2(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+    void classify_sse2(const char *first,
+        size_t length,
+        uint64_t *bits) const noexcept;
+    void classify_ssse3(const char *first,
+        size_t length,
+        uint64_t *bits) const noexcept;
+    void classify_avx2(const char *first,
+        size_t length,
+        uint64_t *bits) const noexcept;
+#endif
+
+    template <bool Padded>
+    const char * find(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+    template <bool Padded>
+    const char * rfind(const char *first,
+        size_t length,
+        bool negate) const noexcept;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    byteset() = default;
+    byteset(const byteset &other) = default;
+    byteset & operator=(const byteset &other) = default;
+
+    byteset(const char *set);
+    byteset(const char *set,
+        size_t n);
+    byteset(const std::string &set);
+
+    // CAPACITY
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    // MODIFIERS
+    void insert(char c) noexcept;
+    void insert(const char *set,
+        size_t n) noexcept;
+
+    // LOOKUP
+    bool contains(char c) const noexcept;
+
+    // SEARCH
+    const char * find_first_of(const char *first,
+        size_t length) const noexcept;
+    const char * find_first_not_of(const char *first,
+        size_t length) const noexcept;
+    const char * find_last_of(const char *first,
+        size_t length) const noexcept;
+    const char * find_last_not_of(const char *first,
+        size_t length) const noexcept;
+
+    // PADDED SEARCH
+    const char * find_first_of(const char *first,
+        size_t length,
+        assume_padded_t) const noexcept;
+    const char * find_first_not_of(const char *first,
+        size_t length,
+        assume_padded_t) const noexcept;
+    const char * find_last_of(const char *first,
+        size_t length,
+        assume_padded_t) const noexcept;
+    const char * find_last_not_of(const char *first,
+        size_t length,
+        assume_padded_t) const noexcept;
+
+    // CLASSIFICATION
+    void classify(const char *first,
+        size_t length,
+        uint64_t *bits) const noexcept;
+    size_t count(const char *first,
+        size_t length) const noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+inline byteset::byteset(const char *set)
+{
+    insert(set, set ? strlen(set) : 0);
+}
+
+
+inline byteset::byteset(const char *set,
+    size_t n)
+{
+    insert(set, n);
+}
+
+
+inline byteset::byteset(const std::string &set)
+{
+    insert(set.data(), set.size());
+}
+
+
+inline size_t byteset::size() const noexcept
+{
+    return size_;
+}
+
+
+inline bool byteset::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+inline void byteset::insert(char c) noexcept
+{
+    uint8_t byte = static_cast<uint8_t>(c);
+    if (contains(c)) {
+        return;
+    }
+
+    bits_[byte >> 6] |= uint64_t(1) << (byte & 63);
+    uint8_t nibble = byte & 0x0F;
+    if (byte < 0x80) {
+        low_[nibble] |= uint8_t(1 << (byte >> 4));
+    } else {
+        high_[nibble] |= uint8_t(1 << ((byte >> 4) - 8));
+    }
+    if (size_ < sizeof(members_)) {
+        members_[size_] = c;
+    }
+    ++size_;
+}
+
+
+inline void byteset::insert(const char *set,
+    size_t n) noexcept
+{
+    for (size_t i = 0; i < n; ++i) {
+        insert(set[i]);
+    }
+}
+
+
+inline bool byteset::contains(char c) const noexcept
+{
+    uint8_t byte = static_cast<uint8_t>(c);
+    return (bits_[byte >> 6] >> (byte & 63)) & 1;
+}
+
+/** \brief Forward bitmap scan for the first byte whose membership != `negate`.
+ */
+inline const char * byteset::find_scalar(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+    for (size_t offset = 0; offset < length; ++offset) {
+        if (contains(first[offset]) != negate) {
+            return first + offset;
+        }
+    }
+    return nullptr;
+}
+
+
+/** \brief Backward bitmap scan for the last byte whose membership != `negate`.
+ */
+inline const char * byteset::rfind_scalar(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+    while (length) {
+        --length;
+        if (contains(first[length]) != negate) {
+            return first + length;
+        }
+    }
+    return nullptr;
+}
+
+
+/** \brief Bitmap of members, one bit per byte.
+ */
+inline void byteset::classify_scalar(const char *first,
+    size_t length,
+    uint64_t *bits) const noexcept
+{
+    for (size_t offset = 0; offset < length; offset += 64) {
+        const size_t count = length - offset < 64 ? length - offset : 64;
+        uint64_t word = 0;
+        for (size_t i = 0; i < count; ++i) {
+            word |= uint64_t(contains(first[offset + i])) << i;
+        }
+        bits[offset / 64] = word;
+    }
+}
+
+#if defined(WTL_X86)
+
+/** \brief OR one compare per member, usable while the set is small.
+ */
+WTL_TARGET_SSE2
+inline uint32_t byteset::match_sse2(const char *block) const noexcept
+{
+    __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i eq = _mm_setzero_si128();
+    for (size_t i = 0; i < size_; ++i) {
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi8(data, _mm_set1_epi8(members_[i])));
+    }
+    return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+}
+
+
+/** \brief Nibble-shuffle classifier for 16 bytes.
+ *
+ *  The low nibble selects a row of the set's bitmap from `low_` (bytes
+ *  below 0x80) or `high_` (bytes from 0x80), and the high nibble
+ *  selects the bit within that row. `pshufb` zeroes lanes whose index
+ *  has the top bit set, which picks the correct table for free.
+ */
+WTL_TARGET_SSSE3
+inline uint32_t byteset::match_ssse3(const char *block) const noexcept
+{
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low_));
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high_));
+    const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+    __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i row = _mm_or_si128(_mm_shuffle_epi8(low, data),
+        _mm_shuffle_epi8(high, _mm_xor_si128(data, _mm_set1_epi8(-128))));
+    __m128i column = _mm_and_si128(_mm_srli_epi16(data, 4), _mm_set1_epi8(0x0F));
+    __m128i bit = _mm_shuffle_epi8(bits, column);
+    __m128i eq = _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+    return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+}
+
+
+/** \brief Nibble-shuffle classifier for 32 bytes.
+ */
+WTL_TARGET_AVX2
+inline uint32_t byteset::match_avx2(const char *block) const noexcept
+{
+    const __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(low_)));
+    const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(high_)));
+    const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+    __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i row = _mm256_or_si256(_mm256_shuffle_epi8(low, data),
+        _mm256_shuffle_epi8(high, _mm256_xor_si256(data, _mm256_set1_epi8(-128))));
+    __m256i column = _mm256_and_si256(_mm256_srli_epi16(data, 4), _mm256_set1_epi8(0x0F));
+    __m256i bit = _mm256_shuffle_epi8(bits, column);
+    __m256i eq = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+}
+
+
+/** \brief SSE2 has no byte shuffle, so only small sets are vectorized.
+ */
+template <bool Padded>
+WTL_TARGET_SSE2
+inline const char * byteset::find_sse2(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+    if (size_ > sizeof(members_)) {
+        return find_scalar(first, length, negate);
+    }
+
+    size_t offset = 0;
+    const uint32_t flip = negate ? 0xFFFF : 0;
+    for (; Padded ? offset < length : offset + 16 <= length; offset += 16) {
+        uint32_t mask = (match_sse2(first + offset) ^ flip) & detail::low_mask32(length - offset);
+        if (mask) {
+            return first + offset + detail::ctz32(mask);
+        }
+    }
+    return Padded ? nullptr : find_scalar(first + offset, length - offset, negate);
+}
+
+
+/** \brief Forward scan of 16-byte blocks, masking any block past the end.
+ */
+template <bool Padded>
+WTL_TARGET_SSSE3
+inline const char * byteset::find_ssse3(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+    size_t offset = 0;
+    const uint32_t flip = negate ? 0xFFFF : 0;
+    for (; Padded ? offset < length : offset + 16 <= length; offset += 16) {
+        uint32_t mask = (match_ssse3(first + offset) ^ flip) & detail::low_mask32(length - offset);
+        if (mask) {
+            return first + offset + detail::ctz32(mask);
+        }
+    }
+    return Padded ? nullptr : find_scalar(first + offset, length - offset, negate);
+}
+
+
+template <bool Padded>
+WTL_TARGET_AVX2
+inline const char * byteset::find_avx2(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+    size_t offset = 0;
+    const uint32_t flip = negate ? 0xFFFFFFFF : 0;
+    for (; Padded ? offset < length : offset + 32 <= length; offset += 32) {
+        uint32_t mask = (match_avx2(first + offset) ^ flip) & detail::low_mask32(length - offset);
+        if (mask) {
+            return first + offset + detail::ctz32(mask);
+        }
+    }
+    return Padded ? nullptr : find_ssse3<false>(first + offset, length - offset, negate);
+}
+
+
+/** \brief Backward scan of 16-byte blocks.
+ *
+ *  When `Padded`, blocks are placed from `first` and the topmost one
+ *  reads past the end and is masked, so no scalar head remains.
+ */
+template <bool Padded>
+WTL_TARGET_SSE2
+inline const char * byteset::rfind_sse2(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+    if (size_ > sizeof(members_)) {
+        return rfind_scalar(first, length, negate);
+    }
+
+    const uint32_t flip = negate ? 0xFFFF : 0;
+    while (Padded ? length > 0 : length >= 16) {
+        const size_t start = Padded ? (length - 1) & ~size_t(15) : length - 16;
+        uint32_t mask = (match_sse2(first + start) ^ flip) & detail::low_mask32(length - start);
+        if (mask) {
+            return first + start + 31 - detail::clz32(mask);
+        }
+        length = start;
+    }
+    return rfind_scalar(first, length, negate);
+}
+
+
+template <bool Padded>
+WTL_TARGET_SSSE3
+inline const char * byteset::rfind_ssse3(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+    const uint32_t flip = negate ? 0xFFFF : 0;
+    while (Padded ? length > 0 : length >= 16) {
+        const size_t start = Padded ? (length - 1) & ~size_t(15) : length - 16;
+        uint32_t mask = (match_ssse3(first + start) ^ flip) & detail::low_mask32(length - start);
+        if (mask) {
+            return first + start + 31 - detail::clz32(mask);
+        }
+        length = start;
+    }
+    return rfind_scalar(first, length, negate);
+}
+
+
+template <bool Padded>
+WTL_TARGET_AVX2
+inline const char * byteset::rfind_avx2(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+    const uint32_t flip = negate ? 0xFFFFFFFF : 0;
+    while (Padded ? length > 0 : length >= 32) {
+        const size_t start = Padded ? (length - 1) & ~size_t(31) : length - 32;
+        uint32_t mask = (match_avx2(first + start) ^ flip) & detail::low_mask32(length - start);
+        if (mask) {
+            return first + start + 31 - detail::clz32(mask);
+        }
+        length = start;
+    }
+    return rfind_ssse3<false>(first, length, negate);
+}
+
+
+WTL_TARGET_SSE2
+inline void byteset::classify_sse2(const char *first,
+    size_t length,
+    uint64_t *bits) const noexcept
+{
+    if (size_ > sizeof(members_)) {
+        return classify_scalar(first, length, bits);
+    }
+
+    size_t offset = 0;
+    for (; offset + 64 <= length; offset += 64) {
+        bits[offset / 64] = uint64_t(match_sse2(first + offset))
+            | (uint64_t(match_sse2(first + offset + 16)) << 16)
+            | (uint64_t(match_sse2(first + offset + 32)) << 32)
+            | (uint64_t(match_sse2(first + offset + 48)) << 48);
+    }
+    classify_scalar(first + offset, length - offset, bits + offset / 64);
+}
+
+
+WTL_TARGET_SSSE3
+inline void byteset::classify_ssse3(const char *first,
+    size_t length,
+    uint64_t *bits) const noexcept
+{
+    size_t offset = 0;
+    for (; offset + 64 <= length; offset += 64) {
+        bits[offset / 64] = uint64_t(match_ssse3(first + offset))
+            | (uint64_t(match_ssse3(first + offset + 16)) << 16)
+            | (uint64_t(match_ssse3(first + offset + 32)) << 32)
+            | (uint64_t(match_ssse3(first + offset + 48)) << 48);
+    }
+    classify_scalar(first + offset, length - offset, bits + offset / 64);
+}
+
+
+WTL_TARGET_AVX2
+inline void byteset::classify_avx2(const char *first,
+    size_t length,
+    uint64_t *bits) const noexcept
+{
+    size_t offset = 0;
+    for (; offset + 64 <= length; offset += 64) {
+        bits[offset / 64] = uint64_t(match_avx2(first + offset))
+            | (uint64_t(match_avx2(first + offset + 32)) << 32);
+    }
+    classify_scalar(first + offset, length - offset, bits + offset / 64);
+}
+
+#endif
+
+/** \brief Forward scan for the first byte whose membership != `negate`.
+ */
+template <bool Padded>
+inline const char * byteset::find(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &byteset::find_scalar, &byteset::find_sse2<Padded>, &byteset::find_ssse3<Padded>, &byteset::find_avx2<Padded>, &byteset::find_avx2<Padded>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &byteset::find_scalar, &byteset::find_scalar, &byteset::find_scalar, &byteset::find_scalar, &byteset::find_scalar,
+    };
+#endif
+    return (this->*detail::dispatch(table))(first, length, negate);
+}
+
+
+/** \brief Backward scan for the last byte whose membership != `negate`.
+ */
+template <bool Padded>
+inline const char * byteset::rfind(const char *first,
+    size_t length,
+    bool negate) const noexcept
+{
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &byteset::rfind_scalar, &byteset::rfind_sse2<Padded>, &byteset::rfind_ssse3<Padded>, &byteset::rfind_avx2<Padded>, &byteset::rfind_avx2<Padded>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &byteset::rfind_scalar, &byteset::rfind_scalar, &byteset::rfind_scalar, &byteset::rfind_scalar, &byteset::rfind_scalar,
+    };
+#endif
+    return (this->*detail::dispatch(table))(first, length, negate);
+}
+
+
+inline const char * byteset::find_first_of(const char *first,
+    size_t length) const noexcept
+{
+    return find<false>(first, length, false);
+}
+
+
+inline const char * byteset::find_first_not_of(const char *first,
+    size_t length) const noexcept
+{
+    return find<false>(first, length, true);
+}
+
+
+inline const char * byteset::find_last_of(const char *first,
+    size_t length) const noexcept
+{
+    return rfind<false>(first, length, false);
+}
+
+
+inline const char * byteset::find_last_not_of(const char *first,
+    size_t length) const noexcept
+{
+    return rfind<false>(first, length, true);
+}
+
+
+/** \brief Search with `simd_padding` readable bytes past the end.
+ */
+inline const char * byteset::find_first_of(const char *first,
+    size_t length,
+    assume_padded_t) const noexcept
+{
+    return find<true>(first, length, false);
+}
+
+
+inline const char * byteset::find_first_not_of(const char *first,
+    size_t length,
+    assume_padded_t) const noexcept
+{
+    return find<true>(first, length, true);
+}
+
+
+inline const char * byteset::find_last_of(const char *first,
+    size_t length,
+    assume_padded_t) const noexcept
+{
+    return rfind<true>(first, length, false);
+}
+
+
+inline const char * byteset::find_last_not_of(const char *first,
+    size_t length,
+    assume_padded_t) const noexcept
+{
+    return rfind<true>(first, length, true);
+}
+
+
+/** \brief Write the membership of each byte to a bitmap.
+ *
+ *  Bit `i % 64` of `bits[i / 64]` is set when `first[i]` is a member.
+ *  `bits` must hold `(length + 63) / 64` words, and bits past `length`
+ *  in the last word are cleared.
+ */
+inline void byteset::classify(const char *first,
+    size_t length,
+    uint64_t *bits) const noexcept
+{
+#if defined(WTL_X86)
+    static const classifier table[isa_levels] = {
+        &byteset::classify_scalar, &byteset::classify_sse2, &byteset::classify_ssse3, &byteset::classify_avx2, &byteset::classify_avx2,
+    };
+#else
+    static const classifier table[isa_levels] = {
+        &byteset::classify_scalar, &byteset::classify_scalar, &byteset::classify_scalar, &byteset::classify_scalar, &byteset::classify_scalar,
+    };
+#endif
+    (this->*detail::dispatch(table))(first, length, bits);
+}
+
+
+/** \brief Number of bytes that are members, summed over `classify`.
+ */
+inline size_t byteset::count(const char *first,
+    size_t length) const noexcept
+{
+    uint64_t bits[64];
+    size_t count = 0;
+    for (size_t offset = 0; offset < length; offset += 4096) {
+        const size_t size = length - offset < 4096 ? length - offset : 4096;
+        classify(first + offset, size, bits);
+        for (size_t i = 0; i < (size + 63) / 64; ++i) {
+            count += detail::popcount64(bits[i]);
+        }
+    }
+    return count;
+}
+
+}   /* wtl */
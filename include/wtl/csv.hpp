@@ -0,0 +1,454 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/arena.hpp>
+#include <wtl/dispatch.hpp>
+#include <wtl/lines.hpp>
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+#include <wtl/detail/search.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Field delimiter and quote character of a CSV dialect.
+ *
+ *  Records end at `'\n'`, with an optional preceding `'\r'`. TSV is
+ *  `csv_dialect('\t')`.
+ */
+struct csv_dialect
+{
+    char delimiter;
+    char quote;
+
+    constexpr csv_dialect(char delimiter = ',',
+            char quote = '"'):
+        delimiter(delimiter),
+        quote(quote)
+    {}
+};
+
+
+/** \brief Zero-copy reader of delimited records.
+ *
+ *  The input is classified 64 bytes at a time into quote and separator
+ *  bitmasks with SIMD. A prefix XOR of the quote mask marks the bytes
+ *  inside quotes, which removes their separators, and the remaining
+ *  separator bits are the field boundaries.
+ *
+ *  Fields are views into the input. Quoted fields lose their quotes,
+ *  and only those that also contain doubled quotes are unescaped, into
+ *  the caller's scratch arena. Every record yields at least one field,
+ *  so an empty line is a single empty field.
+ *
+ *  \warning The input and arena must outlive the fields.
+ */
+class csv_reader
+{
+protected:
+    static const size_t chunk_words = 64;
+
+    string str_;
+    csv_dialect dialect_;
+    arena *scratch_;
+    std::vector<string> fields_;
+    uint64_t quotes_[chunk_words];
+    uint64_t separators_[chunk_words];
+    size_t chunk_ = 0;
+    size_t words_ = 0;
+    size_t word_ = 0;
+    size_t base_ = 0;
+    uint64_t bits_ = 0;
+    uint64_t inside_ = 0;
+    size_t start_ = 0;
+    bool done_ = false;
+
+    bool load_word() noexcept;
+    void push_field(size_t first,
+        size_t last,
+        bool end_of_record);
+    string unescape(const string &field);
+
+public:
+    // MEMBER VARIABLES
+    // ----------------
+    static const size_t min_shard = 1 << 20;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    explicit csv_reader(const string &str,
+        const csv_dialect &dialect = csv_dialect(),
+        arena *scratch = nullptr);
+
+    // PROPERTIES
+    const csv_dialect & dialect() const noexcept;
+    size_t offset() const noexcept;
+
+    // RECORDS
+    bool next(vector<string> &row);
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+namespace detail
+{
+// CLASSIFY
+// --------
+
+/** \brief Bitmasks of the quotes and separators in up to 64 bytes.
+ */
+inline void csv_word_scalar(const char *first,
+    size_t length,
+    const csv_dialect &dialect,
+    uint64_t &quotes,
+    uint64_t &separators) noexcept
+{
+    quotes = 0;
+    separators = 0;
+    for (size_t i = 0; i < length; ++i) {
+        const char c = first[i];
+        quotes |= uint64_t(c == dialect.quote) << i;
+        separators |= uint64_t(c == dialect.delimiter || c == '\n') << i;
+    }
+}
+
+
+/** \brief Classify `length` bytes into one pair of masks per 64 bytes.
+ */
+inline void csv_classify_scalar(const char *first,
+    size_t length,
+    const csv_dialect &dialect,
+    uint64_t *quotes,
+    uint64_t *separators) noexcept
+{
+    for (size_t i = 0; i < length; i += 64) {
+        csv_word_scalar(first + i, std::min<size_t>(64, length - i), dialect, quotes[i / 64], separators[i / 64]);
+    }
+}
+
+#if defined(WTL_X86)
+
+WTL_TARGET_SSE2
+inline void csv_classify_sse2(const char *first,
+    size_t length,
+    const csv_dialect &dialect,
+    uint64_t *quotes,
+    uint64_t *separators) noexcept
+{
+    const __m128i quote = _mm_set1_epi8(dialect.quote);
+    const __m128i delimiter = _mm_set1_epi8(dialect.delimiter);
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t offset = 0;
+    for (; offset + 64 <= length; offset += 64) {
+        uint64_t q = 0;
+        uint64_t s = 0;
+        for (size_t i = 0; i < 64; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + offset + i));
+            __m128i sep = _mm_or_si128(_mm_cmpeq_epi8(v, delimiter), _mm_cmpeq_epi8(v, newline));
+            q |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << i;
+            s |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(sep))) << i;
+        }
+        quotes[offset / 64] = q;
+        separators[offset / 64] = s;
+    }
+    if (offset < length) {
+        csv_word_scalar(first + offset, length - offset, dialect, quotes[offset / 64], separators[offset / 64]);
+    }
+}
+
+
+WTL_TARGET_AVX2
+inline void csv_classify_avx2(const char *first,
+    size_t length,
+    const csv_dialect &dialect,
+    uint64_t *quotes,
+    uint64_t *separators) noexcept
+{
+    const __m256i quote = _mm256_set1_epi8(dialect.quote);
+    const __m256i delimiter = _mm256_set1_epi8(dialect.delimiter);
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t offset = 0;
+    for (; offset + 64 <= length; offset += 64) {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + offset));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + offset + 32));
+        __m256i sep_lo = _mm256_or_si256(_mm256_cmpeq_epi8(lo, delimiter), _mm256_cmpeq_epi8(lo, newline));
+        __m256i sep_hi = _mm256_or_si256(_mm256_cmpeq_epi8(hi, delimiter), _mm256_cmpeq_epi8(hi, newline));
+        uint64_t q_lo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, quote)));
+        uint64_t q_hi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, quote)));
+        quotes[offset / 64] = q_lo | (q_hi << 32);
+        separators[offset / 64] = static_cast<uint32_t>(_mm256_movemask_epi8(sep_lo))
+            | (uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(sep_hi))) << 32);
+    }
+    if (offset < length) {
+        csv_word_scalar(first + offset, length - offset, dialect, quotes[offset / 64], separators[offset / 64]);
+    }
+}
+
+#endif
+
+inline void csv_classify(const char *first,
+    size_t length,
+    const csv_dialect &dialect,
+    uint64_t *quotes,
+    uint64_t *separators) noexcept
+{
+    typedef void (*kernel)(const char *, size_t, const csv_dialect &, uint64_t *, uint64_t *);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &csv_classify_scalar, &csv_classify_sse2, &csv_classify_sse2, &csv_classify_avx2, &csv_classify_avx2,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &csv_classify_scalar, &csv_classify_scalar, &csv_classify_scalar, &csv_classify_scalar, &csv_classify_scalar,
+    };
+#endif
+    dispatch(table)(first, length, dialect, quotes, separators);
+}
+
+
+/** \brief Set each bit to the XOR of it and every lower bit.
+ *
+ *  Applied to a quote mask, this sets the bits from each opening quote
+ *  up to, but excluding, its closing quote.
+ */
+inline uint64_t prefix_xor(uint64_t bits) noexcept
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+
+/** \brief Start of the first record at or after `pos`, given its quote state.
+ */
+inline size_t csv_record_start(const string &str,
+    size_t pos,
+    bool inside,
+    const csv_dialect &dialect) noexcept
+{
+    const char *data = str.data();
+    for (; pos < str.size(); ++pos) {
+        if (data[pos] == dialect.quote) {
+            inside = !inside;
+        } else if (data[pos] == '\n' && !inside) {
+            return pos + 1;
+        }
+    }
+    return str.size();
+}
+
+}   /* detail */
+
+
+inline csv_reader::csv_reader(const string &str,
+        const csv_dialect &dialect,
+        arena *scratch):
+    str_(str),
+    dialect_(dialect),
+    scratch_(scratch)
+{}
+
+
+inline const csv_dialect & csv_reader::dialect() const noexcept
+{
+    return dialect_;
+}
+
+
+/** \brief Offset of the next record in the input.
+ */
+inline size_t csv_reader::offset() const noexcept
+{
+    return start_;
+}
+
+
+/** \brief Load the field boundaries of the next 64 bytes into `bits_`.
+ *
+ *  Returns false at the end of the input. The quote state is carried
+ *  between words as an all-ones or all-zeros mask.
+ */
+inline bool csv_reader::load_word() noexcept
+{
+    if (word_ == words_) {
+        const size_t next = chunk_ + 64 * words_;
+        if (next >= str_.size()) {
+            return false;
+        }
+        const size_t length = std::min(str_.size() - next, 64 * chunk_words);
+        detail::csv_classify(str_.data() + next, length, dialect_, quotes_, separators_);
+        chunk_ = next;
+        words_ = (length + 63) / 64;
+        word_ = 0;
+    }
+
+    const uint64_t inside = detail::prefix_xor(quotes_[word_]) ^ inside_;
+    inside_ = 0 - (inside >> 63);
+    bits_ = separators_[word_] & ~inside;
+    base_ = chunk_ + 64 * word_;
+    ++word_;
+    return true;
+}
+
+
+/** \brief Remove doubled quotes, copying the field into the arena.
+ */
+inline string csv_reader::unescape(const string &field)
+{
+    if (!scratch_) {
+        throw std::logic_error("csv_reader::next().");
+    }
+
+    char *out = static_cast<char*>(scratch_->allocate(field.size(), 1));
+    const char *first = field.data();
+    const char *last = first + field.size();
+    size_t length = 0;
+    while (const char *quote = detail::find_char(first, last - first, dialect_.quote)) {
+        // keep the first quote of the pair, and skip the second
+        size_t count = quote - first + 1;
+        std::memcpy(out + length, first, count);
+        length += count;
+        first = std::min(quote + 2, last);
+    }
+    std::memcpy(out + length, first, last - first);
+    length += last - first;
+    return string(out, length);
+}
+
+
+inline void csv_reader::push_field(size_t first,
+    size_t last,
+    bool end_of_record)
+{
+    const char *data = str_.data();
+    if (end_of_record && last > first && data[last - 1] == '\r') {
+        --last;
+    }
+
+    string field(data + first, last - first);
+    if (field.size() >= 2 && field.front() == dialect_.quote && field.back() == dialect_.quote) {
+        field = string(data + first + 1, field.size() - 2);
+        if (detail::find_char(field.data(), field.size(), dialect_.quote)) {
+            field = unescape(field);
+        }
+    }
+    fields_.push_back(field);
+}
+
+
+/** \brief Read the next record into `row`, returning false at the end.
+ *
+ *  `row` views storage reused by the next call, and throws
+ *  `std::logic_error` if a field needs unescaping without an arena.
+ */
+inline bool csv_reader::next(vector<string> &row)
+{
+    fields_.clear();
+    if (done_) {
+        return false;
+    }
+
+    for (;;) {
+        while (!bits_) {
+            if (!load_word()) {
+                done_ = true;
+                if (start_ == str_.size() && fields_.empty()) {
+                    return false;
+                }
+                push_field(start_, str_.size(), true);
+                start_ = str_.size();
+                row = vector<string>(fields_.data(), fields_.size());
+                return true;
+            }
+        }
+
+        const size_t position = base_ + detail::ctz64(bits_);
+        bits_ &= bits_ - 1;
+        const bool end_of_record = str_[position] == '\n';
+        push_field(start_, position, end_of_record);
+        start_ = position + 1;
+        if (end_of_record) {
+            row = vector<string>(fields_.data(), fields_.size());
+            return true;
+        }
+    }
+}
+
+
+/** \brief Split `str` into up to `shards` runs of whole records.
+ *
+ *  Quotes are counted per even shard in parallel, so the quote state
+ *  at each shard boundary is known, and each boundary is moved to the
+ *  start of the next record outside quotes. Shards may be empty when a
+ *  record spans more than one.
+ */
+inline std::vector<string> csv_split(const string &str,
+    size_t shards,
+    const csv_dialect &dialect = csv_dialect())
+{
+    const size_t length = str.size();
+    shards = std::max<size_t>(1, shards);
+    std::vector<size_t> bounds(shards + 1);
+    for (size_t i = 0; i <= shards; ++i) {
+        bounds[i] = length / shards * i + std::min(i, length % shards);
+    }
+
+    std::vector<size_t> quotes(shards + 1, 0);
+    detail::for_each_shard(shards, [&](size_t i) {
+        quotes[i + 1] = detail::count_char(str.data() + bounds[i], bounds[i + 1] - bounds[i], dialect.quote);
+    });
+
+    std::vector<string> result;
+    size_t start = 0;
+    size_t count = 0;
+    for (size_t i = 1; i <= shards; ++i) {
+        count += quotes[i];
+        size_t end = length;
+        if (i < shards) {
+            end = std::max(start, detail::csv_record_start(str, bounds[i], count & 1, dialect));
+        }
+        result.push_back(string(str.data() + start, end - start));
+        start = end;
+    }
+    return result;
+}
+
+
+/** \brief Call `function(index, shard)` for record-aligned shards on threads.
+ *
+ *  Uses up to `threads` threads, with shards of at least `min_shard`
+ *  bytes, and the first on the calling thread. Each call should read its shard
+ *  with its own `csv_reader` and arena.
+ */
+template <typename Function>
+void csv_parallel(const string &str,
+    size_t threads,
+    Function function,
+    const csv_dialect &dialect = csv_dialect())
+{
+    const size_t count = std::max<size_t>(1, std::min(threads, str.size() / csv_reader::min_shard));
+    const std::vector<string> shards = csv_split(str, count, dialect);
+    detail::for_each_shard(shards.size(), [&](size_t i) {
+        function(i, shards[i]);
+    });
+}
+
+}   /* wtl */
@@ -0,0 +1,141 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <cstddef>
+
+// Relaxed constexpr, for functions with statements or assertions.
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#   define WTL_CONSTEXPR14 constexpr
+#else
+#   define WTL_CONSTEXPR14
+#endif
+
+#if defined(__has_builtin)
+#   if __has_builtin(__builtin_is_constant_evaluated)
+#       define WTL_HAS_CONSTANT_EVALUATED 1
+#   endif
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#   define WTL_HAS_CONSTANT_EVALUATED 1
+#endif
+
+// Functions that dispatch to SIMD kernels at runtime are constexpr
+// only when the compiler can tell constant evaluation apart, and use
+// the scalar loops below in constant expressions.
+#if defined(WTL_HAS_CONSTANT_EVALUATED) && (__cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L))
+#   define WTL_HAS_CONSTEXPR_DISPATCH 1
+#   define WTL_CONSTEXPR_DISPATCH constexpr
+#else
+#   define WTL_CONSTEXPR_DISPATCH
+#endif
+
+
+namespace wtl
+{
+namespace detail
+{
+// CONSTANT EVALUATION
+// -------------------
+
+
+constexpr bool constant_evaluated() noexcept
+{
+#if defined(WTL_HAS_CONSTANT_EVALUATED)
+    return __builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+
+template <typename Traits, typename Char>
+WTL_CONSTEXPR14 size_t constexpr_length(const Char *s) noexcept
+{
+    size_t length = 0;
+    while (!Traits::eq(s[length], Char())) {
+        ++length;
+    }
+    return length;
+}
+
+
+template <typename Traits, typename Char>
+WTL_CONSTEXPR14 int constexpr_compare(const Char *left,
+    const Char *right,
+    size_t length) noexcept
+{
+    for (size_t i = 0; i < length; ++i) {
+        if (Traits::lt(left[i], right[i])) {
+            return -1;
+        } else if (Traits::lt(right[i], left[i])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+template <typename Char>
+WTL_CONSTEXPR14 const Char * constexpr_find_char(const Char *first,
+    size_t length,
+    Char c) noexcept
+{
+    for (size_t i = 0; i < length; ++i) {
+        if (first[i] == c) {
+            return first + i;
+        }
+    }
+    return nullptr;
+}
+
+
+template <typename Char>
+WTL_CONSTEXPR14 const Char * constexpr_find(const Char *first,
+    size_t length,
+    const Char *substr,
+    size_t sublen) noexcept
+{
+    if (sublen > length) {
+        return nullptr;
+    }
+    for (size_t i = 0; i <= length - sublen; ++i) {
+        size_t j = 0;
+        while (j < sublen && first[i + j] == substr[j]) {
+            ++j;
+        }
+        if (j == sublen) {
+            return first + i;
+        }
+    }
+    return nullptr;
+}
+
+
+/** \brief `Traits::length`, which is only constexpr from C++17.
+ */
+template <typename Traits, typename Char>
+WTL_CONSTEXPR_DISPATCH size_t traits_length(const Char *s) noexcept
+{
+    if (constant_evaluated()) {
+        return constexpr_length<Traits>(s);
+    }
+    return Traits::length(s);
+}
+
+
+/** \brief `Traits::compare`, which is only constexpr from C++17.
+ */
+template <typename Traits, typename Char>
+WTL_CONSTEXPR_DISPATCH int traits_compare(const Char *left,
+    const Char *right,
+    size_t length) noexcept
+{
+    if (constant_evaluated()) {
+        return constexpr_compare<Traits>(left, right, length);
+    }
+    return Traits::compare(left, right, length);
+}
+
+}   /* detail */
+}   /* wtl */
@@ -0,0 +1,326 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/dispatch.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+
+namespace wtl
+{
+namespace detail
+{
+// LANES
+// -----
+
+
+/** \brief SIMD lane used to compare elements of `T`.
+ *
+ *  Integers compare bitwise as unsigned lanes of the same width, and
+ *  floats with the IEEE compare, so `-0.0 == 0.0` and NaN matches
+ *  nothing, as with `operator==`. Other types are not vectorized.
+ */
+template <typename T>
+struct simd_lane
+{
+    static const bool value = (std::is_integral<T>::value
+            && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8))
+        || std::is_same<T, float>::value
+        || std::is_same<T, double>::value;
+
+    typedef typename std::conditional<std::is_floating_point<T>::value, T,
+        typename std::conditional<sizeof(T) == 1, uint8_t,
+        typename std::conditional<sizeof(T) == 2, uint16_t,
+        typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type>::type>::type type;
+};
+
+
+template <typename T>
+typename simd_lane<T>::type to_lane(const T &value) noexcept
+{
+    typename simd_lane<T>::type lane;
+    std::memcpy(&lane, &value, sizeof(T));
+    return lane;
+}
+
+#if defined(WTL_X86)
+
+WTL_TARGET_SSE2 inline __m128i broadcast_sse2(uint8_t v) noexcept { return _mm_set1_epi8(static_cast<char>(v)); }
+WTL_TARGET_SSE2 inline __m128i broadcast_sse2(uint16_t v) noexcept { return _mm_set1_epi16(static_cast<short>(v)); }
+WTL_TARGET_SSE2 inline __m128i broadcast_sse2(uint32_t v) noexcept { return _mm_set1_epi32(static_cast<int>(v)); }
+WTL_TARGET_SSE2 inline __m128i broadcast_sse2(uint64_t v) noexcept { return _mm_set1_epi64x(static_cast<long long>(v)); }
+WTL_TARGET_SSE2 inline __m128i broadcast_sse2(float v) noexcept { return _mm_castps_si128(_mm_set1_ps(v)); }
+WTL_TARGET_SSE2 inline __m128i broadcast_sse2(double v) noexcept { return _mm_castpd_si128(_mm_set1_pd(v)); }
+
+WTL_TARGET_SSE2 inline __m128i equal_sse2(__m128i a, __m128i b, uint8_t) noexcept { return _mm_cmpeq_epi8(a, b); }
+WTL_TARGET_SSE2 inline __m128i equal_sse2(__m128i a, __m128i b, uint16_t) noexcept { return _mm_cmpeq_epi16(a, b); }
+WTL_TARGET_SSE2 inline __m128i equal_sse2(__m128i a, __m128i b, uint32_t) noexcept { return _mm_cmpeq_epi32(a, b); }
+
+/** \brief SSE2 has no 64-bit compare, so both 32-bit halves must match.
+ */
+WTL_TARGET_SSE2
+inline __m128i equal_sse2(__m128i a, __m128i b, uint64_t) noexcept
+{
+    __m128i eq = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+WTL_TARGET_SSE2
+inline __m128i equal_sse2(__m128i a, __m128i b, float) noexcept
+{
+    return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+WTL_TARGET_SSE2
+inline __m128i equal_sse2(__m128i a, __m128i b, double) noexcept
+{
+    return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+WTL_TARGET_AVX2 inline __m256i broadcast_avx2(uint8_t v) noexcept { return _mm256_set1_epi8(static_cast<char>(v)); }
+WTL_TARGET_AVX2 inline __m256i broadcast_avx2(uint16_t v) noexcept { return _mm256_set1_epi16(static_cast<short>(v)); }
+WTL_TARGET_AVX2 inline __m256i broadcast_avx2(uint32_t v) noexcept { return _mm256_set1_epi32(static_cast<int>(v)); }
+WTL_TARGET_AVX2 inline __m256i broadcast_avx2(uint64_t v) noexcept { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+WTL_TARGET_AVX2 inline __m256i broadcast_avx2(float v) noexcept { return _mm256_castps_si256(_mm256_set1_ps(v)); }
+WTL_TARGET_AVX2 inline __m256i broadcast_avx2(double v) noexcept { return _mm256_castpd_si256(_mm256_set1_pd(v)); }
+
+WTL_TARGET_AVX2 inline __m256i equal_avx2(__m256i a, __m256i b, uint8_t) noexcept { return _mm256_cmpeq_epi8(a, b); }
+WTL_TARGET_AVX2 inline __m256i equal_avx2(__m256i a, __m256i b, uint16_t) noexcept { return _mm256_cmpeq_epi16(a, b); }
+WTL_TARGET_AVX2 inline __m256i equal_avx2(__m256i a, __m256i b, uint32_t) noexcept { return _mm256_cmpeq_epi32(a, b); }
+WTL_TARGET_AVX2 inline __m256i equal_avx2(__m256i a, __m256i b, uint64_t) noexcept { return _mm256_cmpeq_epi64(a, b); }
+
+WTL_TARGET_AVX2
+inline __m256i equal_avx2(__m256i a, __m256i b, float) noexcept
+{
+    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+}
+
+WTL_TARGET_AVX2
+inline __m256i equal_avx2(__m256i a, __m256i b, double) noexcept
+{
+    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+}
+
+#endif
+
+// COUNT
+// -----
+
+
+template <typename T>
+size_t count_value_scalar(const T *first,
+    size_t length,
+    T value) noexcept
+{
+    return static_cast<size_t>(std::count(first, first + length, value));
+}
+
+#if defined(WTL_X86)
+
+/** \brief Count matches of 16-byte blocks in byte lanes.
+ *
+ *  A matching element sets all of its bytes, so each compare subtracts
+ *  -1 from `sizeof(T)` byte lanes. The lanes are summed with `psadbw`
+ *  every 255 blocks, before they overflow, and divided by `sizeof(T)`.
+ */
+template <typename T>
+WTL_TARGET_SSE2
+size_t count_value_sse2(const T *first,
+    size_t length,
+    T value) noexcept
+{
+    typedef typename simd_lane<T>::type lane;
+    const size_t width = 16 / sizeof(T);
+    const __m128i needle = broadcast_sse2(to_lane(value));
+    size_t bytes = 0;
+    size_t offset = 0;
+    while (offset + width <= length) {
+        const size_t blocks = std::min<size_t>((length - offset) / width, 255);
+        __m128i lanes = _mm_setzero_si128();
+        for (size_t i = 0; i < blocks; ++i, offset += width) {
+            __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + offset));
+            lanes = _mm_sub_epi8(lanes, equal_sse2(data, needle, lane()));
+        }
+        uint64_t sums[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), _mm_sad_epu8(lanes, _mm_setzero_si128()));
+        bytes += static_cast<size_t>(sums[0] + sums[1]);
+    }
+    return bytes / sizeof(T) + count_value_scalar(first + offset, length - offset, value);
+}
+
+
+template <typename T>
+WTL_TARGET_AVX2
+size_t count_value_avx2(const T *first,
+    size_t length,
+    T value) noexcept
+{
+    typedef typename simd_lane<T>::type lane;
+    const size_t width = 32 / sizeof(T);
+    const __m256i needle = broadcast_avx2(to_lane(value));
+    size_t bytes = 0;
+    size_t offset = 0;
+    while (offset + width <= length) {
+        const size_t blocks = std::min<size_t>((length - offset) / width, 255);
+        __m256i lanes = _mm256_setzero_si256();
+        for (size_t i = 0; i < blocks; ++i, offset += width) {
+            __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + offset));
+            lanes = _mm256_sub_epi8(lanes, equal_avx2(data, needle, lane()));
+        }
+        uint64_t sums[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), _mm256_sad_epu8(lanes, _mm256_setzero_si256()));
+        bytes += static_cast<size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+    }
+    return bytes / sizeof(T) + count_value_sse2(first + offset, length - offset, value);
+}
+
+#endif
+
+template <typename T>
+size_t count_value(const T *first,
+    size_t length,
+    const T &value,
+    std::false_type) noexcept
+{
+    return static_cast<size_t>(std::count(first, first + length, value));
+}
+
+
+template <typename T>
+size_t count_value(const T *first,
+    size_t length,
+    const T &value,
+    std::true_type) noexcept
+{
+    typedef size_t (*kernel)(const T *, size_t, T);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &count_value_scalar<T>, &count_value_sse2<T>, &count_value_sse2<T>, &count_value_avx2<T>, &count_value_avx2<T>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &count_value_scalar<T>, &count_value_scalar<T>, &count_value_scalar<T>, &count_value_scalar<T>, &count_value_scalar<T>,
+    };
+#endif
+    return dispatch(table)(first, length, value);
+}
+
+
+/** \brief Number of elements equal to `value`.
+ */
+template <typename T>
+size_t count_value(const T *first,
+    size_t length,
+    const T &value) noexcept
+{
+    return count_value(first, length, value, std::integral_constant<bool, simd_lane<T>::value>());
+}
+
+// FIND
+// ----
+
+
+template <typename T>
+const T * find_value_scalar(const T *first,
+    size_t length,
+    T value) noexcept
+{
+    const T *last = first + length;
+    const T *found = std::find(first, last, value);
+    return found == last ? nullptr : found;
+}
+
+#if defined(WTL_X86)
+
+template <typename T>
+WTL_TARGET_SSE2
+const T * find_value_sse2(const T *first,
+    size_t length,
+    T value) noexcept
+{
+    typedef typename simd_lane<T>::type lane;
+    const size_t width = 16 / sizeof(T);
+    const __m128i needle = broadcast_sse2(to_lane(value));
+    size_t offset = 0;
+    for (; offset + width <= length; offset += width) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + offset));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal_sse2(data, needle, lane())));
+        if (mask) {
+            return first + offset + ctz32(mask) / sizeof(T);
+        }
+    }
+    return find_value_scalar(first + offset, length - offset, value);
+}
+
+
+template <typename T>
+WTL_TARGET_AVX2
+const T * find_value_avx2(const T *first,
+    size_t length,
+    T value) noexcept
+{
+    typedef typename simd_lane<T>::type lane;
+    const size_t width = 32 / sizeof(T);
+    const __m256i needle = broadcast_avx2(to_lane(value));
+    size_t offset = 0;
+    for (; offset + width <= length; offset += width) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + offset));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal_avx2(data, needle, lane())));
+        if (mask) {
+            return first + offset + ctz32(mask) / sizeof(T);
+        }
+    }
+    return find_value_sse2(first + offset, length - offset, value);
+}
+
+#endif
+
+template <typename T>
+const T * find_value(const T *first,
+    size_t length,
+    const T &value,
+    std::false_type) noexcept
+{
+    const T *last = first + length;
+    const T *found = std::find(first, last, value);
+    return found == last ? nullptr : found;
+}
+
+
+template <typename T>
+const T * find_value(const T *first,
+    size_t length,
+    const T &value,
+    std::true_type) noexcept
+{
+    typedef const T * (*kernel)(const T *, size_t, T);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &find_value_scalar<T>, &find_value_sse2<T>, &find_value_sse2<T>, &find_value_avx2<T>, &find_value_avx2<T>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &find_value_scalar<T>, &find_value_scalar<T>, &find_value_scalar<T>, &find_value_scalar<T>, &find_value_scalar<T>,
+    };
+#endif
+    return dispatch(table)(first, length, value);
+}
+
+
+/** \brief First element equal to `value`, or null.
+ */
+template <typename T>
+const T * find_value(const T *first,
+    size_t length,
+    const T &value) noexcept
+{
+    return find_value(first, length, value, std::integral_constant<bool, simd_lane<T>::value>());
+}
+
+}   /* detail */
+}   /* wtl */
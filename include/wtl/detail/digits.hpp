@@ -0,0 +1,168 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/detail/simd.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace wtl
+{
+namespace detail
+{
+// SWAR
+// ----
+
+
+/** \brief Load 8 bytes, with the first byte in the low bits.
+ */
+inline uint64_t load_le64(const char *first) noexcept
+{
+    uint64_t word;
+    std::memcpy(&word, first, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+
+/** \brief Check all 8 bytes of a little-endian word are ASCII digits.
+ *
+ *  Adding 6 carries digits past `'9'` into the next high nibble, so
+ *  only `'0'` to `'9'` keep a high nibble of 3 both before and after.
+ */
+inline bool is_eight_digits(uint64_t word) noexcept
+{
+    const uint64_t high = 0xF0F0F0F0F0F0F0F0;
+    return ((word & high) | (((word + 0x0606060606060606) & high) >> 4)) == 0x3333333333333333;
+}
+
+
+/** \brief Value of 8 ASCII digits in a little-endian word.
+ *
+ *  Combines adjacent digits into pairs, then pairs into the full value,
+ *  with three multiplications rather than eight.
+ */
+inline uint32_t eight_digits(uint64_t word) noexcept
+{
+    const uint64_t mask = 0x000000FF000000FF;
+    const uint64_t mul1 = 100 + (1000000ULL << 32);
+    const uint64_t mul2 = 1 + (10000ULL << 32);
+    word -= 0x3030303030303030;
+    word = word * 10 + (word >> 8);
+    word = (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(word);
+}
+
+
+/** \brief Convert 16 ASCII digits with SWAR, or return false.
+ */
+struct digits16_swar
+{
+    static bool convert(const char *first,
+        uint64_t &value) noexcept
+    {
+        const uint64_t high = load_le64(first);
+        const uint64_t low = load_le64(first + 8);
+        if (!is_eight_digits(high) || !is_eight_digits(low)) {
+            return false;
+        }
+        value = uint64_t(eight_digits(high)) * 100000000 + eight_digits(low);
+        return true;
+    }
+};
+
+#if defined(WTL_X86)
+
+/** \brief Convert 16 ASCII digits with SSSE3, or return false.
+ *
+ *  Multiply-adds combine digits into pairs, then quads, then two
+ *  8-digit halves.
+ */
+struct digits16_ssse3
+{
+    WTL_TARGET_SSSE3
+    static bool convert(const char *first,
+        uint64_t &value) noexcept
+    {
+        const __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first)), _mm_set1_epi8('0'));
+        const __m128i invalid = _mm_or_si128(_mm_cmplt_epi8(digits, _mm_setzero_si128()), _mm_cmpgt_epi8(digits, _mm_set1_epi8(9)));
+        if (_mm_movemask_epi8(invalid)) {
+            return false;
+        }
+
+        const __m128i pairs = _mm_maddubs_epi16(digits, _mm_set1_epi16(0x010A));
+        const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010064));
+        const __m128i halves = _mm_madd_epi16(_mm_packs_epi32(quads, quads), _mm_set1_epi32(0x00012710));
+        const uint32_t high = static_cast<uint32_t>(_mm_cvtsi128_si32(halves));
+        const uint32_t low = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(halves, 4)));
+        value = uint64_t(high) * 100000000 + low;
+        return true;
+    }
+};
+
+#endif
+
+// FORMATTING
+// ----------
+
+
+/** \brief Pairs of ASCII digits from `"00"` to `"99"`.
+ */
+inline const char * digit_pairs() noexcept
+{
+    static const char table[] =
+        "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+        "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+    return table;
+}
+
+
+/** \brief Number of decimal digits in `value`, at least 1.
+ */
+inline uint32_t count_digits(uint64_t value) noexcept
+{
+    uint32_t count = 1;
+    for (;;) {
+        if (value < 10) {
+            return count;
+        } else if (value < 100) {
+            return count + 1;
+        } else if (value < 1000) {
+            return count + 2;
+        } else if (value < 10000) {
+            return count + 3;
+        }
+        value /= 10000;
+        count += 4;
+    }
+}
+
+
+/** \brief Write the decimal digits of `value` backwards, ending at `last`.
+ *
+ *  Emits two digits per division, from the pair table.
+ */
+inline void write_digits(char *last,
+    uint64_t value) noexcept
+{
+    const char *pairs = digit_pairs();
+    while (value >= 100) {
+        const uint64_t pair = value % 100;
+        value /= 100;
+        last -= 2;
+        std::memcpy(last, pairs + 2 * pair, 2);
+    }
+    if (value >= 10) {
+        std::memcpy(last - 2, pairs + 2 * value, 2);
+    } else {
+        last[-1] = static_cast<char>('0' + value);
+    }
+}
+
+}   /* detail */
+}   /* wtl */
@@ -0,0 +1,448 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/detail/powers.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+namespace wtl
+{
+namespace detail
+{
+// FORMATS
+// -------
+
+
+/** \brief IEEE-754 layout and decimal limits of a binary format.
+ */
+template <typename T>
+struct binary_format;
+
+template <>
+struct binary_format<double>
+{
+    typedef uint64_t bits_type;
+    static const int mantissa_bits = 52;
+    static const int minimum_exponent = -1023;
+    static const int infinite_power = 0x7FF;
+    static const int smallest_power_of_ten = -342;
+    static const int largest_power_of_ten = 308;
+    static const int min_exponent_round_to_even = -4;
+    static const int max_exponent_round_to_even = 23;
+    static const int max_exponent_fast_path = 22;
+};
+
+template <>
+struct binary_format<float>
+{
+    typedef uint32_t bits_type;
+    static const int mantissa_bits = 23;
+    static const int minimum_exponent = -127;
+    static const int infinite_power = 0xFF;
+    static const int smallest_power_of_ten = -65;
+    static const int largest_power_of_ten = 38;
+    static const int min_exponent_round_to_even = -17;
+    static const int max_exponent_round_to_even = 10;
+    static const int max_exponent_fast_path = 10;
+};
+
+
+/** \brief Exact powers of ten for the fast path.
+ */
+template <typename T>
+inline T exact_pow10(int q) noexcept
+{
+    static const T table[] = {
+        T(1e0), T(1e1), T(1e2), T(1e3), T(1e4), T(1e5), T(1e6), T(1e7),
+        T(1e8), T(1e9), T(1e10), T(1e11), T(1e12), T(1e13), T(1e14), T(1e15),
+        T(1e16), T(1e17), T(1e18), T(1e19), T(1e20), T(1e21), T(1e22),
+    };
+    return table[q];
+}
+
+
+/** \brief Biased binary exponent and explicit mantissa bits.
+ */
+struct adjusted_mantissa
+{
+    uint64_t mantissa;
+    int power2;
+};
+
+
+template <typename T>
+T to_float(adjusted_mantissa am,
+    bool negative) noexcept
+{
+    typedef binary_format<T> format;
+    typedef typename format::bits_type bits_type;
+    bits_type bits = static_cast<bits_type>(am.mantissa);
+    bits |= static_cast<bits_type>(am.power2) << format::mantissa_bits;
+    bits |= static_cast<bits_type>(negative) << (sizeof(T) * 8 - 1);
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+// EISEL-LEMIRE
+// ------------
+
+
+/** \brief Full 64x64-bit product, returning the low word.
+ */
+inline uint64_t multiply_128(uint64_t a,
+    uint64_t b,
+    uint64_t &high) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    high = static_cast<uint64_t>(product >> 64);
+    return static_cast<uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, &high);
+#else
+    const uint64_t a_low = a & 0xFFFFFFFF, a_high = a >> 32;
+    const uint64_t b_low = b & 0xFFFFFFFF, b_high = b >> 32;
+    const uint64_t low_low = a_low * b_low;
+    const uint64_t high_low = a_high * b_low;
+    const uint64_t low_high = a_low * b_high;
+    const uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+    high = a_high * b_high + (high_low >> 32) + (middle >> 32);
+    return (middle << 32) | (low_low & 0xFFFFFFFF);
+#endif
+}
+
+
+/** \brief Round `w * 10^q` to the nearest binary format value.
+ *
+ *  Multiplies the normalized mantissa by a 128-bit approximation of
+ *  `5^q`. The upper bits of the product are exact except when the
+ *  discarded bits are all ones, where the second word corrects them,
+ *  which is proven sufficient for every 64-bit `w`.
+ */
+template <typename T>
+adjusted_mantissa eisel_lemire(int64_t q,
+    uint64_t w) noexcept
+{
+    typedef binary_format<T> format;
+    adjusted_mantissa answer = {0, 0};
+    if (w == 0 || q < format::smallest_power_of_ten) {
+        return answer;
+    } else if (q > format::largest_power_of_ten) {
+        answer.power2 = format::infinite_power;
+        return answer;
+    }
+
+    const int lz = static_cast<int>(clz64(w));
+    w <<= lz;
+    const uint64_t *power = pow5_128(static_cast<int>(q));
+    const uint64_t precision_mask = UINT64_MAX >> (format::mantissa_bits + 3);
+    uint64_t high;
+    uint64_t low = multiply_128(w, power[0], high);
+    if ((high & precision_mask) == precision_mask) {
+        uint64_t second_high;
+        multiply_128(w, power[1], second_high);
+        low += second_high;
+        high += second_high > low;
+    }
+
+    const int upper_bit = static_cast<int>(high >> 63);
+    const int shift = upper_bit + 64 - format::mantissa_bits - 3;
+    answer.mantissa = high >> shift;
+    // floor(log2(10^q)) + 63, exact for |q| <= 1650
+    answer.power2 = static_cast<int>((((152170 + 65536) * q) >> 16) + 63) + upper_bit - lz - format::minimum_exponent;
+    if (answer.power2 <= 0) {
+        // subnormal, rounded to nearest and then to even
+        if (-answer.power2 + 1 >= 64) {
+            answer.mantissa = 0;
+            answer.power2 = 0;
+            return answer;
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+        answer.power2 = answer.mantissa < (uint64_t(1) << format::mantissa_bits) ? 0 : 1;
+        return answer;
+    }
+
+    // exact halfway products only occur for small q, and round to even
+    if (low <= 1 && q >= format::min_exponent_round_to_even && q <= format::max_exponent_round_to_even
+        && (answer.mantissa & 3) == 1 && (answer.mantissa << shift) == high) {
+        answer.mantissa &= ~uint64_t(1);
+    }
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (uint64_t(2) << format::mantissa_bits)) {
+        answer.mantissa = uint64_t(1) << format::mantissa_bits;
+        ++answer.power2;
+    }
+    answer.mantissa &= ~(uint64_t(1) << format::mantissa_bits);
+    if (answer.power2 >= format::infinite_power) {
+        answer.power2 = format::infinite_power;
+        answer.mantissa = 0;
+    }
+    return answer;
+}
+
+// DECIMAL
+// -------
+
+
+/** \brief Arbitrary-precision decimal, for inputs Eisel-Lemire cannot decide.
+ *
+ *  Holds the value `0.digits * 10^decimal_point`. 800 digits is more
+ *  than the 767 that can affect rounding, and any digits past them
+ *  only set `truncated`.
+ */
+struct decimal
+{
+    static const uint32_t max_digits = 800;
+    static const int32_t decimal_point_range = 2047;
+
+    uint32_t num_digits;
+    int32_t decimal_point;
+    bool truncated;
+    uint8_t digits[max_digits];
+};
+
+
+inline void decimal_trim(decimal &d) noexcept
+{
+    while (d.num_digits > 0 && d.digits[d.num_digits - 1] == 0) {
+        --d.num_digits;
+    }
+}
+
+
+inline void decimal_append(decimal &d,
+    const char *first,
+    const char *last) noexcept
+{
+    for (; first < last; ++first) {
+        if (d.num_digits < decimal::max_digits) {
+            d.digits[d.num_digits++] = static_cast<uint8_t>(*first - '0');
+        } else if (*first != '0') {
+            d.truncated = true;
+        }
+    }
+}
+
+
+/** \brief Multiply by `2^shift`, for `shift <= 60`.
+ */
+inline void decimal_left_shift(decimal &d,
+    uint32_t shift) noexcept
+{
+    if (d.num_digits == 0) {
+        return;
+    }
+
+    // the product gains as many digits as 2^shift, or one fewer
+    const uint32_t new_digits = ((shift * 1233) >> 12) + 1;
+    int32_t read = static_cast<int32_t>(d.num_digits) - 1;
+    uint32_t write = d.num_digits - 1 + new_digits;
+    uint64_t n = 0;
+    for (; read >= 0; --read, --write) {
+        n += uint64_t(d.digits[read]) << shift;
+        const uint64_t quotient = n / 10;
+        const uint64_t remainder = n - 10 * quotient;
+        if (write < decimal::max_digits) {
+            d.digits[write] = static_cast<uint8_t>(remainder);
+        } else if (remainder > 0) {
+            d.truncated = true;
+        }
+        n = quotient;
+    }
+    for (; n > 0; --write) {
+        const uint64_t quotient = n / 10;
+        const uint64_t remainder = n - 10 * quotient;
+        if (write < decimal::max_digits) {
+            d.digits[write] = static_cast<uint8_t>(remainder);
+        } else if (remainder > 0) {
+            d.truncated = true;
+        }
+        n = quotient;
+    }
+    if (write == 0) {
+        d.digits[0] = 0;
+    }
+
+    d.num_digits += new_digits;
+    if (d.num_digits > decimal::max_digits) {
+        d.num_digits = decimal::max_digits;
+    }
+    d.decimal_point += static_cast<int32_t>(new_digits);
+    if (d.digits[0] == 0) {
+        std::memmove(d.digits, d.digits + 1, d.num_digits - 1);
+        --d.num_digits;
+        --d.decimal_point;
+    }
+    decimal_trim(d);
+}
+
+
+/** \brief Divide by `2^shift`, for `shift <= 60`.
+ */
+inline void decimal_right_shift(decimal &d,
+    uint32_t shift) noexcept
+{
+    uint32_t read = 0;
+    uint32_t write = 0;
+    uint64_t n = 0;
+    while ((n >> shift) == 0) {
+        if (read < d.num_digits) {
+            n = 10 * n + d.digits[read++];
+        } else if (n == 0) {
+            return;
+        } else {
+            while ((n >> shift) == 0) {
+                n = 10 * n;
+                ++read;
+            }
+            break;
+        }
+    }
+
+    d.decimal_point -= static_cast<int32_t>(read - 1);
+    if (d.decimal_point < -decimal::decimal_point_range) {
+        d.num_digits = 0;
+        d.decimal_point = 0;
+        d.truncated = false;
+        return;
+    }
+    const uint64_t mask = (uint64_t(1) << shift) - 1;
+    while (read < d.num_digits) {
+        const uint8_t digit = static_cast<uint8_t>(n >> shift);
+        n = 10 * (n & mask) + d.digits[read++];
+        d.digits[write++] = digit;
+    }
+    while (n > 0) {
+        const uint8_t digit = static_cast<uint8_t>(n >> shift);
+        n = 10 * (n & mask);
+        if (write < decimal::max_digits) {
+            d.digits[write++] = digit;
+        } else if (digit > 0) {
+            d.truncated = true;
+        }
+    }
+    d.num_digits = write;
+    decimal_trim(d);
+}
+
+
+/** \brief Integer part of the decimal, rounded half to even.
+ */
+inline uint64_t decimal_round(const decimal &d) noexcept
+{
+    if (d.num_digits == 0 || d.decimal_point < 0) {
+        return 0;
+    } else if (d.decimal_point > 18) {
+        return UINT64_MAX;
+    }
+
+    const uint32_t point = static_cast<uint32_t>(d.decimal_point);
+    uint64_t n = 0;
+    for (uint32_t i = 0; i < point; ++i) {
+        n = 10 * n + (i < d.num_digits ? d.digits[i] : 0);
+    }
+    bool round_up = false;
+    if (point < d.num_digits) {
+        round_up = d.digits[point] >= 5;
+        if (d.digits[point] == 5 && point + 1 == d.num_digits) {
+            round_up = d.truncated || (point > 0 && (d.digits[point - 1] & 1));
+        }
+    }
+    return n + round_up;
+}
+
+
+/** \brief Convert a decimal to the binary format, by shifting it to [1/2, 1).
+ *
+ *  Simple decimal conversion, as in Wuffs: slow, but exact for any
+ *  number of digits.
+ */
+template <typename T>
+adjusted_mantissa decimal_to_binary(decimal &d) noexcept
+{
+    typedef binary_format<T> format;
+    static const uint32_t max_shift = 60;
+    static const uint32_t num_powers = 19;
+    static const uint8_t powers[num_powers] = {0, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53, 56, 59};
+    const adjusted_mantissa zero = {0, 0};
+    const adjusted_mantissa infinity = {0, format::infinite_power};
+
+    if (d.num_digits == 0 || d.decimal_point < -324) {
+        return zero;
+    } else if (d.decimal_point >= 310) {
+        return infinity;
+    }
+
+    int32_t exp2 = 0;
+    while (d.decimal_point > 0) {
+        const uint32_t n = static_cast<uint32_t>(d.decimal_point);
+        const uint32_t shift = n < num_powers ? powers[n] : max_shift;
+        decimal_right_shift(d, shift);
+        if (d.decimal_point < -decimal::decimal_point_range) {
+            return zero;
+        }
+        exp2 += static_cast<int32_t>(shift);
+    }
+    while (d.decimal_point <= 0) {
+        uint32_t shift;
+        if (d.decimal_point == 0) {
+            if (d.digits[0] >= 5) {
+                break;
+            }
+            shift = d.digits[0] < 2 ? 2 : 1;
+        } else {
+            const uint32_t n = static_cast<uint32_t>(-d.decimal_point);
+            shift = n < num_powers ? powers[n] : max_shift;
+        }
+        decimal_left_shift(d, shift);
+        if (d.decimal_point > decimal::decimal_point_range) {
+            return infinity;
+        }
+        exp2 -= static_cast<int32_t>(shift);
+    }
+
+    // [1/2, 1) to the [1, 2) of the binary format
+    --exp2;
+    while (format::minimum_exponent + 1 > exp2) {
+        uint32_t n = static_cast<uint32_t>(format::minimum_exponent + 1 - exp2);
+        n = std::min(n, max_shift);
+        decimal_right_shift(d, n);
+        exp2 += static_cast<int32_t>(n);
+    }
+    if (exp2 - format::minimum_exponent >= format::infinite_power) {
+        return infinity;
+    }
+
+    const int mantissa_size = format::mantissa_bits + 1;
+    decimal_left_shift(d, mantissa_size);
+    uint64_t mantissa = decimal_round(d);
+    if (mantissa >= (uint64_t(1) << mantissa_size)) {
+        decimal_right_shift(d, 1);
+        ++exp2;
+        mantissa = decimal_round(d);
+        if (exp2 - format::minimum_exponent >= format::infinite_power) {
+            return infinity;
+        }
+    }
+
+    adjusted_mantissa answer;
+    answer.power2 = exp2 - format::minimum_exponent;
+    if (mantissa < (uint64_t(1) << format::mantissa_bits)) {
+        --answer.power2;
+    }
+    answer.mantissa = mantissa & ((uint64_t(1) << format::mantissa_bits) - 1);
+    return answer;
+}
+
+}   /* detail */
+}   /* wtl */
@@ -0,0 +1,227 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/dispatch.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <cstring>
+
+
+namespace wtl
+{
+namespace detail
+{
+// BYTE SWAP
+// ---------
+
+
+inline uint16_t byteswap_value(uint16_t v) noexcept
+{
+    return static_cast<uint16_t>((v >> 8) | (v << 8));
+}
+
+
+inline uint32_t byteswap_value(uint32_t v) noexcept
+{
+    v = ((v & 0x00FF00FFu) << 8) | ((v >> 8) & 0x00FF00FFu);
+    return (v << 16) | (v >> 16);
+}
+
+
+inline uint64_t byteswap_value(uint64_t v) noexcept
+{
+    return (uint64_t(byteswap_value(static_cast<uint32_t>(v))) << 32) | byteswap_value(static_cast<uint32_t>(v >> 32));
+}
+
+
+/** \brief Unsigned integer of `Width` bytes.
+ */
+template <size_t Width>
+struct byteswap_word;
+
+template <> struct byteswap_word<2> { typedef uint16_t type; };
+template <> struct byteswap_word<4> { typedef uint32_t type; };
+template <> struct byteswap_word<8> { typedef uint64_t type; };
+
+
+/** \brief Reverse the bytes of each of `length` words of `Width` bytes.
+ *
+ *  Words are loaded with `memcpy`, so `first` needs no alignment.
+ */
+template <size_t Width>
+void byteswap_scalar(char *first,
+    size_t length) noexcept
+{
+    typedef typename byteswap_word<Width>::type word;
+    for (size_t i = 0; i < length; ++i) {
+        word value;
+        std::memcpy(&value, first + i * Width, Width);
+        value = byteswap_value(value);
+        std::memcpy(first + i * Width, &value, Width);
+    }
+}
+
+#if defined(WTL_X86)
+
+/** \brief Shuffle reversing each word of `Width` bytes within 16 bytes.
+ */
+template <size_t Width>
+WTL_TARGET_SSSE3
+__m128i byteswap_mask() noexcept
+{
+    alignas(16) char mask[16];
+    for (size_t i = 0; i < 16; ++i) {
+        mask[i] = static_cast<char>(i / Width * Width + (Width - 1 - i % Width));
+    }
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+
+template <size_t Width>
+WTL_TARGET_SSSE3
+void byteswap_ssse3(char *first,
+    size_t length) noexcept
+{
+    const __m128i mask = byteswap_mask<Width>();
+    const size_t bytes = length * Width;
+    size_t offset = 0;
+    for (; offset + 16 <= bytes; offset += 16) {
+        __m128i *p = reinterpret_cast<__m128i*>(first + offset);
+        _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+    }
+    byteswap_scalar<Width>(first + offset, (bytes - offset) / Width);
+}
+
+
+template <size_t Width>
+WTL_TARGET_AVX2
+void byteswap_avx2(char *first,
+    size_t length) noexcept
+{
+    const __m128i half = byteswap_mask<Width>();
+    const __m256i mask = _mm256_inserti128_si256(_mm256_castsi128_si256(half), half, 1);
+    const size_t bytes = length * Width;
+    size_t offset = 0;
+    for (; offset + 32 <= bytes; offset += 32) {
+        __m256i *p = reinterpret_cast<__m256i*>(first + offset);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+    }
+    byteswap_ssse3<Width>(first + offset, (bytes - offset) / Width);
+}
+
+#endif
+
+template <size_t Width>
+void byteswap(char *first,
+    size_t length) noexcept
+{
+    typedef void (*kernel)(char *, size_t);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &byteswap_scalar<Width>, &byteswap_scalar<Width>, &byteswap_ssse3<Width>, &byteswap_avx2<Width>, &byteswap_avx2<Width>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &byteswap_scalar<Width>, &byteswap_scalar<Width>, &byteswap_scalar<Width>, &byteswap_scalar<Width>, &byteswap_scalar<Width>,
+    };
+#endif
+    dispatch(table)(first, length);
+}
+
+// CASE FOLDING
+// ------------
+
+
+/** \brief Map ASCII letters to one case, leaving other elements as-is.
+ *
+ *  Letters of the other case are exactly those in `[from, from + 26)`,
+ *  and differ from their folded form by bit `0x20`.
+ */
+template <typename Char>
+void ascii_case_scalar(Char *first,
+    size_t length,
+    char from) noexcept
+{
+    for (size_t i = 0; i < length; ++i) {
+        if (first[i] >= Char(from) && first[i] < Char(from + 26)) {
+            first[i] = static_cast<Char>(first[i] ^ 0x20);
+        }
+    }
+}
+
+#if defined(WTL_X86)
+
+/** \brief Fold 16 bytes at a time with signed compares.
+ *
+ *  Non-ASCII bytes are negative as signed chars, so they always fall
+ *  outside the letter range.
+ */
+WTL_TARGET_SSE2
+inline void ascii_case_sse2(char *first,
+    size_t length,
+    char from) noexcept
+{
+    const __m128i low = _mm_set1_epi8(static_cast<char>(from - 1));
+    const __m128i high = _mm_set1_epi8(static_cast<char>(from + 26));
+    const __m128i bit = _mm_set1_epi8(0x20);
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16) {
+        __m128i *p = reinterpret_cast<__m128i*>(first + offset);
+        __m128i v = _mm_loadu_si128(p);
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmplt_epi8(v, high));
+        _mm_storeu_si128(p, _mm_xor_si128(v, _mm_and_si128(letter, bit)));
+    }
+    ascii_case_scalar(first + offset, length - offset, from);
+}
+
+
+WTL_TARGET_AVX2
+inline void ascii_case_avx2(char *first,
+    size_t length,
+    char from) noexcept
+{
+    const __m256i low = _mm256_set1_epi8(static_cast<char>(from - 1));
+    const __m256i high = _mm256_set1_epi8(static_cast<char>(from + 26));
+    const __m256i bit = _mm256_set1_epi8(0x20);
+    size_t offset = 0;
+    for (; offset + 32 <= length; offset += 32) {
+        __m256i *p = reinterpret_cast<__m256i*>(first + offset);
+        __m256i v = _mm256_loadu_si256(p);
+        __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(v, low), _mm256_cmpgt_epi8(high, v));
+        _mm256_storeu_si256(p, _mm256_xor_si256(v, _mm256_and_si256(letter, bit)));
+    }
+    ascii_case_sse2(first + offset, length - offset, from);
+}
+
+#endif
+
+template <typename Char>
+void ascii_case(Char *first,
+    size_t length,
+    char from) noexcept
+{
+    ascii_case_scalar(first, length, from);
+}
+
+
+inline void ascii_case(char *first,
+    size_t length,
+    char from) noexcept
+{
+    typedef void (*kernel)(char *, size_t, char);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &ascii_case_scalar<char>, &ascii_case_sse2, &ascii_case_sse2, &ascii_case_avx2, &ascii_case_avx2,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &ascii_case_scalar<char>, &ascii_case_scalar<char>, &ascii_case_scalar<char>, &ascii_case_scalar<char>, &ascii_case_scalar<char>,
+    };
+#endif
+    dispatch(table)(first, length, from);
+}
+
+}   /* detail */
+}   /* wtl */
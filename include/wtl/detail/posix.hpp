@@ -0,0 +1,15 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+// POSIX system interfaces, for memory maps and vectored I/O. Features
+// built on them are only declared when `WTL_POSIX` is defined.
+#if defined(__unix__) || defined(__APPLE__)
+#   define WTL_POSIX 1
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <sys/uio.h>
+#   include <unistd.h>
+#endif
@@ -0,0 +1,1050 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/byteset.hpp>
+#include <wtl/dispatch.hpp>
+#include <wtl/detail/count.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+
+namespace wtl
+{
+namespace detail
+{
+// SINGLE CHARACTER
+// ----------------
+
+
+template <typename Char>
+const Char * find_char(const Char *first,
+    size_t length,
+    Char c) noexcept
+{
+    const Char *last = first + length;
+    const Char *found = std::find(first, last, c);
+    return found == last ? nullptr : found;
+}
+
+
+inline const char * find_char(const char *first,
+    size_t length,
+    char c) noexcept
+{
+    if (length == 0) {
+        return nullptr;
+    }
+    return static_cast<const char*>(std::memchr(first, c, length));
+}
+
+
+template <typename Char>
+const Char * rfind_char(const Char *first,
+    size_t length,
+    Char c) noexcept
+{
+    const Char *last = first + length;
+    while (last != first) {
+        if (*--last == c) {
+            return last;
+        }
+    }
+    return nullptr;
+}
+
+/** \brief Padded overload, which only vectorizes narrow characters.
+ */
+template <typename Char>
+const Char * find_char(const Char *first,
+    size_t length,
+    Char c,
+    assume_padded_t) noexcept
+{
+    return find_char(first, length, c);
+}
+
+
+/** \brief Padded overload, which only vectorizes narrow characters.
+ */
+template <typename Char>
+const Char * rfind_char(const Char *first,
+    size_t length,
+    Char c,
+    assume_padded_t) noexcept
+{
+    return rfind_char(first, length, c);
+}
+
+#if defined(WTL_X86)
+
+/** \brief Forward scan of 16-byte blocks, masking the block past the end.
+ *
+ *  Requires `simd_padding` readable bytes past `first + length`.
+ */
+WTL_TARGET_SSE2
+inline const char * find_char_padded_sse2(const char *first,
+    size_t length,
+    char c) noexcept
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    for (size_t offset = 0; offset < length; offset += 16) {
+        __m128i eq = _mm_cmpeq_epi8(needle, _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + offset)));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq)) & low_mask32(length - offset);
+        if (mask) {
+            return first + offset + ctz32(mask);
+        }
+    }
+    return nullptr;
+}
+
+
+/** \brief Forward scan of 32-byte blocks, masking the block past the end.
+ *
+ *  Requires `simd_padding` readable bytes past `first + length`.
+ */
+WTL_TARGET_AVX2
+inline const char * find_char_padded_avx2(const char *first,
+    size_t length,
+    char c) noexcept
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    for (size_t offset = 0; offset < length; offset += 32) {
+        __m256i eq = _mm256_cmpeq_epi8(needle, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + offset)));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq)) & low_mask32(length - offset);
+        if (mask) {
+            return first + offset + ctz32(mask);
+        }
+    }
+    return nullptr;
+}
+
+
+/** \brief Backward scan of 16-byte blocks, shrinking `length` as it goes.
+ *
+ *  When `Padded`, blocks are placed from `first` and the topmost one
+ *  reads past the end and is masked, so no scalar head remains.
+ */
+template <bool Padded>
+WTL_TARGET_SSE2
+inline const char * rfind_char_loop_sse2(const char *first,
+    size_t &length,
+    char c) noexcept
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    while (Padded ? length > 0 : length >= 16) {
+        const size_t start = Padded ? (length - 1) & ~size_t(15) : length - 16;
+        const char *block = first + start;
+        __m128i eq = _mm_cmpeq_epi8(needle, _mm_loadu_si128(reinterpret_cast<const __m128i*>(block)));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        if (Padded) {
+            mask &= low_mask32(length - start);
+        }
+        if (mask) {
+            return block + 31 - clz32(mask);
+        }
+        length = start;
+    }
+    return nullptr;
+}
+
+
+/** \brief Backward scan of 32-byte blocks, shrinking `length` as it goes.
+ */
+template <bool Padded>
+WTL_TARGET_AVX2
+inline const char * rfind_char_loop_avx2(const char *first,
+    size_t &length,
+    char c) noexcept
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    while (Padded ? length > 0 : length >= 32) {
+        const size_t start = Padded ? (length - 1) & ~size_t(31) : length - 32;
+        const char *block = first + start;
+        __m256i eq = _mm256_cmpeq_epi8(needle, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        if (Padded) {
+            mask &= low_mask32(length - start);
+        }
+        if (mask) {
+            return block + 31 - clz32(mask);
+        }
+        length = start;
+    }
+    return nullptr;
+}
+
+
+template <bool Padded>
+WTL_TARGET_SSE2
+inline const char * rfind_char_sse2(const char *first,
+    size_t length,
+    char c) noexcept
+{
+    const char *found = rfind_char_loop_sse2<Padded>(first, length, c);
+    return found ? found : rfind_char<char>(first, length, c);
+}
+
+
+template <bool Padded>
+WTL_TARGET_AVX2
+inline const char * rfind_char_avx2(const char *first,
+    size_t length,
+    char c) noexcept
+{
+    const char *found = rfind_char_loop_avx2<Padded>(first, length, c);
+    if (!found) {
+        found = rfind_char_loop_sse2<Padded>(first, length, c);
+    }
+    return found ? found : rfind_char<char>(first, length, c);
+}
+
+#endif
+
+/** \brief `memrchr` equivalent, which is not portable beyond glibc.
+ */
+inline const char * rfind_char(const char *first,
+    size_t length,
+    char c) noexcept
+{
+    typedef const char * (*kernel)(const char *, size_t, char);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &rfind_char<char>, &rfind_char_sse2<false>, &rfind_char_sse2<false>, &rfind_char_avx2<false>, &rfind_char_avx2<false>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &rfind_char<char>, &rfind_char<char>, &rfind_char<char>, &rfind_char<char>, &rfind_char<char>,
+    };
+#endif
+    return dispatch(table)(first, length, c);
+}
+
+
+inline const char * find_char(const char *first,
+    size_t length,
+    char c,
+    assume_padded_t) noexcept
+{
+    typedef const char * (*kernel)(const char *, size_t, char);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &find_char, &find_char_padded_sse2, &find_char_padded_sse2, &find_char_padded_avx2, &find_char_padded_avx2,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &find_char, &find_char, &find_char, &find_char, &find_char,
+    };
+#endif
+    return dispatch(table)(first, length, c);
+}
+
+
+inline const char * rfind_char(const char *first,
+    size_t length,
+    char c,
+    assume_padded_t) noexcept
+{
+    typedef const char * (*kernel)(const char *, size_t, char);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &rfind_char<char>, &rfind_char_sse2<true>, &rfind_char_sse2<true>, &rfind_char_avx2<true>, &rfind_char_avx2<true>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &rfind_char<char>, &rfind_char<char>, &rfind_char<char>, &rfind_char<char>, &rfind_char<char>,
+    };
+#endif
+    return dispatch(table)(first, length, c);
+}
+
+// COUNTING
+// --------
+
+
+/** \brief Count occurrences of `c`, with the SIMD kernels for `Char`.
+ */
+template <typename Char>
+size_t count_char(const Char *first,
+    size_t length,
+    Char c) noexcept
+{
+    return count_value(first, length, c);
+}
+
+// NAIVE
+// -----
+
+
+/** \brief Quadratic search, used for short tails of the SIMD kernels.
+ *
+ *  \param sublen       Length of the needle, at least 1.
+ */
+template <typename Char>
+const Char * find_naive(const Char *first,
+    size_t length,
+    const Char *substr,
+    size_t sublen) noexcept
+{
+    if (sublen > length) {
+        return nullptr;
+    }
+    const Char *last = first + (length - sublen) + 1;
+    for (; first != last; ++first) {
+        if (*first == *substr && std::equal(substr + 1, substr + sublen, first + 1)) {
+            return first;
+        }
+    }
+    return nullptr;
+}
+
+/** \brief Quadratic search for the last match.
+ *
+ *  \param sublen       Length of the needle, at least 1.
+ */
+template <typename Char>
+const Char * rfind_naive(const Char *first,
+    size_t length,
+    const Char *substr,
+    size_t sublen) noexcept
+{
+    if (sublen > length) {
+        return nullptr;
+    }
+    const Char *last = first + (length - sublen) + 1;
+    while (last != first) {
+        --last;
+        if (*last == *substr && std::equal(substr + 1, substr + sublen, last + 1)) {
+            return last;
+        }
+    }
+    return nullptr;
+}
+
+// TWO-WAY
+// -------
+
+
+/** \brief Critical factorization of a needle for the Two-Way algorithm.
+ */
+struct two_way_factorization
+{
+    std::ptrdiff_t ell = -1;
+    size_t period = 1;
+    bool periodic = false;
+};
+
+
+/** \brief Compute the maximal suffix of `x` and its period.
+ *
+ *  \param reversed     Use the reversed alphabet ordering.
+ */
+template <typename Iterator>
+std::ptrdiff_t maximal_suffix(Iterator x,
+    size_t m,
+    bool reversed,
+    size_t &period) noexcept
+{
+    std::ptrdiff_t ms = -1;
+    size_t j = 0;
+    size_t k = 1;
+    size_t p = 1;
+    while (j + k < m) {
+        auto a = x[j + k];
+        auto b = x[ms + static_cast<std::ptrdiff_t>(k)];
+        if (reversed ? (b < a) : (a < b)) {
+            j += k;
+            k = 1;
+            p = j - ms;
+        } else if (a == b) {
+            if (k != p) {
+                ++k;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            ms = static_cast<std::ptrdiff_t>(j);
+            j = ms + 1;
+            k = p = 1;
+        }
+    }
+    period = p;
+    return ms;
+}
+
+
+/** \brief Factorize a needle accessed through a random-access iterator.
+ *
+ *  Reverse iterators factorize the mirrored needle for backward search.
+ */
+template <typename Iterator>
+two_way_factorization two_way_factorize(Iterator substr,
+    size_t sublen) noexcept
+{
+    size_t p1, p2;
+    std::ptrdiff_t ms1 = maximal_suffix(substr, sublen, false, p1);
+    std::ptrdiff_t ms2 = maximal_suffix(substr, sublen, true, p2);
+
+    two_way_factorization result;
+    result.ell = ms1 > ms2 ? ms1 : ms2;
+    result.period = ms1 > ms2 ? p1 : p2;
+
+    size_t prefix = static_cast<size_t>(result.ell + 1);
+    result.periodic = result.period + prefix <= sublen
+        && std::equal(substr, substr + prefix, substr + result.period);
+    if (!result.periodic) {
+        result.period = std::max(prefix, sublen - prefix) + 1;
+    }
+    return result;
+}
+
+
+/** \brief Crochemore-Perrin Two-Way search with a precomputed factorization.
+ *
+ *  \return         Offset of the first match, or `SIZE_MAX`.
+ */
+template <typename Iterator>
+size_t two_way_search(Iterator first,
+    size_t length,
+    Iterator substr,
+    size_t sublen,
+    const two_way_factorization &factors) noexcept
+{
+    if (sublen > length) {
+        return SIZE_MAX;
+    }
+
+    const std::ptrdiff_t m = static_cast<std::ptrdiff_t>(sublen);
+    const std::ptrdiff_t ell = factors.ell;
+    const std::ptrdiff_t period = static_cast<std::ptrdiff_t>(factors.period);
+    const size_t last = length - sublen;
+    size_t j = 0;
+
+    if (factors.periodic) {
+        std::ptrdiff_t memory = -1;
+        while (j <= last) {
+            Iterator y = first + j;
+            std::ptrdiff_t i = std::max(ell, memory) + 1;
+            while (i < m && substr[i] == y[i]) {
+                ++i;
+            }
+            if (i >= m) {
+                i = ell;
+                while (i > memory && substr[i] == y[i]) {
+                    --i;
+                }
+                if (i <= memory) {
+                    return j;
+                }
+                j += period;
+                memory = m - period - 1;
+            } else {
+                j += i - ell;
+                memory = -1;
+            }
+        }
+    } else {
+        while (j <= last) {
+            Iterator y = first + j;
+            std::ptrdiff_t i = ell + 1;
+            while (i < m && substr[i] == y[i]) {
+                ++i;
+            }
+            if (i >= m) {
+                i = ell;
+                while (i >= 0 && substr[i] == y[i]) {
+                    --i;
+                }
+                if (i < 0) {
+                    return j;
+                }
+                j += period;
+            } else {
+                j += i - ell;
+            }
+        }
+    }
+    return SIZE_MAX;
+}
+
+
+template <typename Char>
+const Char * two_way_find(const Char *first,
+    size_t length,
+    const Char *substr,
+    size_t sublen) noexcept
+{
+    size_t offset = two_way_search(first, length, substr, sublen, two_way_factorize(substr, sublen));
+    return offset == SIZE_MAX ? nullptr : first + offset;
+}
+
+
+/** \brief Two-Way search for the last match, run over mirrored sequences.
+ */
+template <typename Char>
+const Char * two_way_rfind(const Char *first,
+    size_t length,
+    const Char *substr,
+    size_t sublen) noexcept
+{
+    typedef std::reverse_iterator<const Char*> reverse;
+    reverse haystack(first + length);
+    reverse needle(substr + sublen);
+    size_t offset = two_way_search(haystack, length, needle, sublen, two_way_factorize(needle, sublen));
+    return offset == SIZE_MAX ? nullptr : first + (length - offset - sublen);
+}
+
+// SIMD FILTER
+// -----------
+
+// Candidate filter after W. Muła, "SIMD-friendly algorithms for
+// substring searching": compare the first and last needle bytes
+// against a full register of haystack positions, and only verify
+// positions where both match. Each false candidate is charged in
+// proportion to the needle length, and once the charge outgrows the
+// scanned prefix the search falls through to Two-Way, bounding the
+// work on pathological inputs.
+
+/** \brief Cost of verifying one false candidate.
+ */
+inline size_t filter_cost(size_t sublen) noexcept
+{
+    return 1 + (sublen >> 4);
+}
+
+
+/** \brief Whether the filter should give up and switch to Two-Way.
+ */
+inline bool filter_exhausted(size_t misses,
+    size_t offset) noexcept
+{
+    return misses > (offset >> 3) + 64;
+}
+
+/** \brief Finish a forward search from `offset`, after the SIMD loops.
+ */
+inline const char * find_filter_tail(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen,
+    size_t offset,
+    size_t misses) noexcept
+{
+    offset = std::min(offset, length);
+    if (filter_exhausted(misses, offset)) {
+        return two_way_find(first + offset, length - offset, substr, sublen);
+    }
+    return find_naive(first + offset, length - offset, substr, sublen);
+}
+
+
+/** \brief Finish a backward search over candidates `[0, count)`.
+ */
+inline const char * rfind_filter_tail(const char *first,
+    size_t total,
+    size_t count,
+    const char *substr,
+    size_t sublen,
+    size_t misses) noexcept
+{
+    if (count == 0) {
+        return nullptr;
+    } else if (filter_exhausted(misses, total - count)) {
+        return two_way_rfind(first, count + sublen - 1, substr, sublen);
+    }
+    return rfind_naive(first, count + sublen - 1, substr, sublen);
+}
+
+#if defined(WTL_X86)
+
+/** \brief Forward filter over candidate positions from `offset`.
+ *
+ *  When `Padded`, the block holding the last candidates reads past
+ *  the end of the haystack and is masked, so no scalar tail remains.
+ */
+template <bool Padded>
+WTL_TARGET_SSE2
+inline const char * find_loop_sse2(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen,
+    size_t &offset,
+    size_t &misses) noexcept
+{
+    const size_t count = length - sublen + 1;
+    const __m128i head = _mm_set1_epi8(substr[0]);
+    const __m128i tail = _mm_set1_epi8(substr[sublen - 1]);
+    for (; Padded ? offset < count : offset + 16 <= count; offset += 16) {
+        const char *block = first + offset;
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + sublen - 1));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(head, lo), _mm_cmpeq_epi8(tail, hi));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        if (Padded) {
+            mask &= low_mask32(count - offset);
+        }
+        while (mask) {
+            unsigned bit = ctz32(mask);
+            if (std::memcmp(block + bit + 1, substr + 1, sublen - 2) == 0) {
+                return block + bit;
+            } else if (filter_exhausted(misses += filter_cost(sublen), offset)) {
+                offset += bit;
+                return nullptr;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return nullptr;
+}
+
+
+template <bool Padded>
+WTL_TARGET_AVX2
+inline const char * find_loop_avx2(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen,
+    size_t &offset,
+    size_t &misses) noexcept
+{
+    const size_t count = length - sublen + 1;
+    const __m256i head = _mm256_set1_epi8(substr[0]);
+    const __m256i tail = _mm256_set1_epi8(substr[sublen - 1]);
+    for (; Padded ? offset < count : offset + 32 <= count; offset += 32) {
+        const char *block = first + offset;
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + sublen - 1));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(head, lo), _mm256_cmpeq_epi8(tail, hi));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        if (Padded) {
+            mask &= low_mask32(count - offset);
+        }
+        while (mask) {
+            unsigned bit = ctz32(mask);
+            if (std::memcmp(block + bit + 1, substr + 1, sublen - 2) == 0) {
+                return block + bit;
+            } else if (filter_exhausted(misses += filter_cost(sublen), offset)) {
+                offset += bit;
+                return nullptr;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return nullptr;
+}
+
+
+/** \brief Backward filter over candidate positions `[0, count)`.
+ *
+ *  When `Padded`, blocks are placed from `first` and the topmost one
+ *  is masked, so no scalar head remains.
+ */
+template <bool Padded>
+WTL_TARGET_SSE2
+inline const char * rfind_loop_sse2(const char *first,
+    size_t total,
+    size_t &count,
+    const char *substr,
+    size_t sublen,
+    size_t &misses) noexcept
+{
+    const __m128i head = _mm_set1_epi8(substr[0]);
+    const __m128i tail = _mm_set1_epi8(substr[sublen - 1]);
+    while (Padded ? count > 0 : count >= 16) {
+        const size_t start = Padded ? (count - 1) & ~size_t(15) : count - 16;
+        const char *block = first + start;
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + sublen - 1));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(head, lo), _mm_cmpeq_epi8(tail, hi));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        if (Padded) {
+            mask &= low_mask32(count - start);
+        }
+        while (mask) {
+            unsigned bit = 31 - clz32(mask);
+            if (std::memcmp(block + bit + 1, substr + 1, sublen - 2) == 0) {
+                return block + bit;
+            } else if (filter_exhausted(misses += filter_cost(sublen), total - count)) {
+                count = start + bit + 1;
+                return nullptr;
+            }
+            mask ^= 1u << bit;
+        }
+        count = start;
+    }
+    return nullptr;
+}
+
+
+template <bool Padded>
+WTL_TARGET_AVX2
+inline const char * rfind_loop_avx2(const char *first,
+    size_t total,
+    size_t &count,
+    const char *substr,
+    size_t sublen,
+    size_t &misses) noexcept
+{
+    const __m256i head = _mm256_set1_epi8(substr[0]);
+    const __m256i tail = _mm256_set1_epi8(substr[sublen - 1]);
+    while (Padded ? count > 0 : count >= 32) {
+        const size_t start = Padded ? (count - 1) & ~size_t(31) : count - 32;
+        const char *block = first + start;
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + sublen - 1));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(head, lo), _mm256_cmpeq_epi8(tail, hi));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        if (Padded) {
+            mask &= low_mask32(count - start);
+        }
+        while (mask) {
+            unsigned bit = 31 - clz32(mask);
+            if (std::memcmp(block + bit + 1, substr + 1, sublen - 2) == 0) {
+                return block + bit;
+            } else if (filter_exhausted(misses += filter_cost(sublen), total - count)) {
+                count = start + bit + 1;
+                return nullptr;
+            }
+            mask ^= 1u << bit;
+        }
+        count = start;
+    }
+    return nullptr;
+}
+
+
+/** \brief Search for a needle of at least 2 bytes.
+ */
+template <bool Padded>
+WTL_TARGET_SSE2
+inline const char * find_filter_sse2(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen) noexcept
+{
+    size_t offset = 0;
+    size_t misses = 0;
+    const char *found = find_loop_sse2<Padded>(first, length, substr, sublen, offset, misses);
+    return found ? found : find_filter_tail(first, length, substr, sublen, offset, misses);
+}
+
+
+template <bool Padded>
+WTL_TARGET_AVX2
+inline const char * find_filter_avx2(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen) noexcept
+{
+    size_t offset = 0;
+    size_t misses = 0;
+    const char *found = find_loop_avx2<Padded>(first, length, substr, sublen, offset, misses);
+    if (!found && !filter_exhausted(misses, offset)) {
+        found = find_loop_sse2<Padded>(first, length, substr, sublen, offset, misses);
+    }
+    return found ? found : find_filter_tail(first, length, substr, sublen, offset, misses);
+}
+
+
+/** \brief Search backwards for a needle of at least 2 bytes.
+ */
+template <bool Padded>
+WTL_TARGET_SSE2
+inline const char * rfind_filter_sse2(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen) noexcept
+{
+    const size_t total = length - sublen + 1;
+    size_t count = total;
+    size_t misses = 0;
+    const char *found = rfind_loop_sse2<Padded>(first, total, count, substr, sublen, misses);
+    return found ? found : rfind_filter_tail(first, total, count, substr, sublen, misses);
+}
+
+
+template <bool Padded>
+WTL_TARGET_AVX2
+inline const char * rfind_filter_avx2(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen) noexcept
+{
+    const size_t total = length - sublen + 1;
+    size_t count = total;
+    size_t misses = 0;
+    const char *found = rfind_loop_avx2<Padded>(first, total, count, substr, sublen, misses);
+    if (!found && !filter_exhausted(misses, total - count)) {
+        found = rfind_loop_sse2<Padded>(first, total, count, substr, sublen, misses);
+    }
+    return found ? found : rfind_filter_tail(first, total, count, substr, sublen, misses);
+}
+
+#endif
+
+// DISPATCH
+// --------
+
+
+template <typename Char>
+const Char * find_substr(const Char *first,
+    size_t length,
+    const Char *substr,
+    size_t sublen) noexcept
+{
+    return two_way_find(first, length, substr, sublen);
+}
+
+
+template <typename Char>
+const Char * find_substr(const Char *first,
+    size_t length,
+    const Char *substr,
+    size_t sublen,
+    assume_padded_t) noexcept
+{
+    return find_substr(first, length, substr, sublen);
+}
+
+
+inline const char * find_substr(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen) noexcept
+{
+    typedef const char * (*kernel)(const char *, size_t, const char *, size_t);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &two_way_find<char>, &find_filter_sse2<false>, &find_filter_sse2<false>, &find_filter_avx2<false>, &find_filter_avx2<false>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &two_way_find<char>, &two_way_find<char>, &two_way_find<char>, &two_way_find<char>, &two_way_find<char>,
+    };
+#endif
+    return dispatch(table)(first, length, substr, sublen);
+}
+
+
+inline const char * find_substr(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen,
+    assume_padded_t) noexcept
+{
+    typedef const char * (*kernel)(const char *, size_t, const char *, size_t);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &two_way_find<char>, &find_filter_sse2<true>, &find_filter_sse2<true>, &find_filter_avx2<true>, &find_filter_avx2<true>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &two_way_find<char>, &two_way_find<char>, &two_way_find<char>, &two_way_find<char>, &two_way_find<char>,
+    };
+#endif
+    return dispatch(table)(first, length, substr, sublen);
+}
+
+
+/** \brief Find the first occurrence of `substr` in `[first, first+length)`.
+ *
+ *  Single characters use `memchr`. Narrow needles use a SIMD
+ *  first/last byte filter, selected for the active `isa` and backed
+ *  by the Two-Way algorithm when the filter degenerates. Wide-character
+ *  needles and the scalar level use Two-Way.
+ *
+ *  Passing `assume_padded` selects kernels that read whole blocks
+ *  across the end of the haystack instead of finishing with scalar code.
+ *
+ *  \return         Pointer to the match, or `nullptr`.
+ */
+template <typename Char, typename... Padding>
+const Char * find(const Char *first,
+    size_t length,
+    const Char *substr,
+    const size_t sublen,
+    Padding... padding) noexcept
+{
+    if (sublen == 0) {
+        return first;
+    } else if (sublen > length) {
+        return nullptr;
+    } else if (sublen == 1) {
+        return find_char(first, length, *substr, padding...);
+    }
+    return find_substr(first, length, substr, sublen, padding...);
+}
+
+
+template <typename Char>
+const Char * rfind_substr(const Char *first,
+    size_t length,
+    const Char *substr,
+    size_t sublen) noexcept
+{
+    return two_way_rfind(first, length, substr, sublen);
+}
+
+
+template <typename Char>
+const Char * rfind_substr(const Char *first,
+    size_t length,
+    const Char *substr,
+    size_t sublen,
+    assume_padded_t) noexcept
+{
+    return rfind_substr(first, length, substr, sublen);
+}
+
+
+inline const char * rfind_substr(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen) noexcept
+{
+    typedef const char * (*kernel)(const char *, size_t, const char *, size_t);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &two_way_rfind<char>, &rfind_filter_sse2<false>, &rfind_filter_sse2<false>, &rfind_filter_avx2<false>, &rfind_filter_avx2<false>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &two_way_rfind<char>, &two_way_rfind<char>, &two_way_rfind<char>, &two_way_rfind<char>, &two_way_rfind<char>,
+    };
+#endif
+    return dispatch(table)(first, length, substr, sublen);
+}
+
+
+inline const char * rfind_substr(const char *first,
+    size_t length,
+    const char *substr,
+    size_t sublen,
+    assume_padded_t) noexcept
+{
+    typedef const char * (*kernel)(const char *, size_t, const char *, size_t);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &two_way_rfind<char>, &rfind_filter_sse2<true>, &rfind_filter_sse2<true>, &rfind_filter_avx2<true>, &rfind_filter_avx2<true>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &two_way_rfind<char>, &two_way_rfind<char>, &two_way_rfind<char>, &two_way_rfind<char>, &two_way_rfind<char>,
+    };
+#endif
+    return dispatch(table)(first, length, substr, sublen);
+}
+
+
+/** \brief Find the last occurrence of `substr` in `[first, first+length)`.
+ *
+ *  Mirrors `find`, scanning blocks from the end of the haystack.
+ *
+ *  \return         Pointer to the match, or `nullptr`.
+ */
+template <typename Char, typename... Padding>
+const Char * rfind(const Char *first,
+    size_t length,
+    const Char *substr,
+    const size_t sublen,
+    Padding... padding) noexcept
+{
+    if (sublen == 0) {
+        return first + length;
+    } else if (sublen > length) {
+        return nullptr;
+    } else if (sublen == 1) {
+        return rfind_char(first, length, *substr, padding...);
+    }
+    return rfind_substr(first, length, substr, sublen, padding...);
+}
+
+// CHARACTER SETS
+// --------------
+
+
+template <typename Char>
+const Char * find_of(const Char *first,
+    size_t length,
+    const Char *set,
+    size_t setlen,
+    bool negate = false) noexcept
+{
+    const Char *last = first + length;
+    for (; first != last; ++first) {
+        if ((std::find(set, set + setlen, *first) != set + setlen) != negate) {
+            return first;
+        }
+    }
+    return nullptr;
+}
+
+
+template <typename Char>
+const Char * rfind_of(const Char *first,
+    size_t length,
+    const Char *set,
+    size_t setlen,
+    bool negate = false) noexcept
+{
+    const Char *last = first + length;
+    while (last != first) {
+        --last;
+        if ((std::find(set, set + setlen, *last) != set + setlen) != negate) {
+            return last;
+        }
+    }
+    return nullptr;
+}
+
+
+/** \brief Narrow character sets are classified through a `byteset`.
+ */
+inline const char * find_of(const char *first,
+    size_t length,
+    const char *set,
+    size_t setlen,
+    bool negate = false) noexcept
+{
+    byteset bytes(set, setlen);
+    return negate ? bytes.find_first_not_of(first, length) : bytes.find_first_of(first, length);
+}
+
+
+inline const char * rfind_of(const char *first,
+    size_t length,
+    const char *set,
+    size_t setlen,
+    bool negate = false) noexcept
+{
+    byteset bytes(set, setlen);
+    return negate ? bytes.find_last_not_of(first, length) : bytes.find_last_of(first, length);
+}
+
+
+template <typename Char>
+const Char * find_not_of(const Char *first,
+    size_t length,
+    const Char *set,
+    size_t setlen) noexcept
+{
+    return find_of(first, length, set, setlen, true);
+}
+
+
+template <typename Char>
+const Char * rfind_not_of(const Char *first,
+    size_t length,
+    const Char *set,
+    size_t setlen) noexcept
+{
+    return rfind_of(first, length, set, setlen, true);
+}
+
+}   /* detail */
+}   /* wtl */
@@ -0,0 +1,145 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+// x86 kernels for every instruction set are compiled regardless of the
+// consumer's -m flags, using per-function target attributes, and are
+// selected at runtime (see wtl/dispatch.hpp).
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#   define WTL_X86 1
+#   include <immintrin.h>
+#endif
+
+#if defined(WTL_X86) && (defined(__GNUC__) || defined(__clang__))
+#   define WTL_TARGET(isa) __attribute__((target(isa)))
+#else
+#   define WTL_TARGET(isa)
+#endif
+
+// SSE2 in the compilation baseline, for code too fine-grained to
+// dispatch at runtime, such as hash table probes.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define WTL_SSE2 1
+#endif
+
+#define WTL_TARGET_SSE2 WTL_TARGET("sse2")
+#define WTL_TARGET_SSSE3 WTL_TARGET("ssse3")
+#define WTL_TARGET_AVX2 WTL_TARGET("avx2")
+
+
+namespace wtl
+{
+// PADDING
+// -------
+
+/** \brief Readable bytes guaranteed past the end of padded views.
+ *
+ *  Covers the widest load issued by any kernel, so padded kernels may
+ *  read whole blocks across the end of the data and mask the result.
+ */
+static const size_t simd_padding = 64;
+
+/** \brief Tag asserting `simd_padding` readable bytes past a range.
+ */
+struct assume_padded_t
+{};
+
+static const assume_padded_t assume_padded = assume_padded_t();
+
+
+namespace detail
+{
+// BIT MANIPULATION
+// ----------------
+
+
+/** \brief Count trailing zeros of a non-zero 32-bit mask.
+ */
+inline unsigned ctz32(uint32_t x) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(x));
+#endif
+}
+
+
+/** \brief Count trailing zeros of a non-zero 64-bit mask.
+ */
+inline unsigned ctz64(uint64_t x) noexcept
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+    uint32_t low = static_cast<uint32_t>(x);
+    return low ? ctz32(low) : 32 + ctz32(static_cast<uint32_t>(x >> 32));
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+
+/** \brief Number of set bits in a 64-bit mask.
+ */
+inline unsigned popcount64(uint64_t x) noexcept
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<unsigned>((x * 0x0101010101010101ULL) >> 56);
+}
+
+
+/** \brief Count leading zeros of a non-zero 32-bit mask.
+ */
+inline unsigned clz32(uint32_t x) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, x);
+    return 31 - static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_clz(x));
+#endif
+}
+
+
+/** \brief Count leading zeros of a non-zero 64-bit mask.
+ */
+inline unsigned clz64(uint64_t x) noexcept
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+    uint32_t high = static_cast<uint32_t>(x >> 32);
+    return high ? clz32(high) : 32 + clz32(static_cast<uint32_t>(x));
+#else
+    return static_cast<unsigned>(__builtin_clzll(x));
+#endif
+}
+
+
+/** \brief Mask of the low `n` bits, for `n <= 32`.
+ */
+inline uint32_t low_mask32(size_t n) noexcept
+{
+    return n >= 32 ? 0xFFFFFFFF : (uint32_t(1) << n) - 1;
+}
+
+}   /* detail */
+}   /* wtl */
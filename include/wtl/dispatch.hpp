@@ -0,0 +1,256 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/detail/simd.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(WTL_X86) && !defined(_MSC_VER)
+#   include <cpuid.h>
+#endif
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Instruction set levels with dedicated kernels.
+ *
+ *  Levels are ordered, and each implies the ones below it. Kernels
+ *  without a dedicated implementation at a level use the best one
+ *  from a lower level.
+ */
+enum class isa
+{
+    scalar = 0,
+    sse2,
+    ssse3,
+    avx2,
+    avx512,
+};
+
+/** \brief Number of `isa` levels, the size of each kernel table.
+ */
+static const size_t isa_levels = 5;
+
+const char * isa_name(isa level) noexcept;
+bool parse_isa(const char *name,
+    isa &level) noexcept;
+isa detected_isa() noexcept;
+isa active_isa() noexcept;
+isa set_isa(isa level) noexcept;
+void reset_isa() noexcept;
+
+
+namespace detail
+{
+// DETECTION
+// ---------
+
+#if defined(WTL_X86)
+
+inline void cpuid(unsigned leaf,
+    unsigned subleaf,
+    unsigned (&registers)[4]) noexcept
+{
+#if defined(_MSC_VER)
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        registers[i] = static_cast<unsigned>(values[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+
+/** \brief Register state enabled by the OS through XSETBV.
+ */
+inline uint64_t xgetbv() noexcept
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+#endif
+
+inline isa detect_isa() noexcept
+{
+#if defined(WTL_X86)
+    unsigned leaf0[4], leaf1[4], leaf7[4] = {0, 0, 0, 0};
+    cpuid(0, 0, leaf0);
+    if (leaf0[0] < 1) {
+        return isa::scalar;
+    }
+    cpuid(1, 0, leaf1);
+    if (leaf0[0] >= 7) {
+        cpuid(7, 0, leaf7);
+    }
+
+    const bool sse2 = (leaf1[3] >> 26) & 1;
+    const bool ssse3 = (leaf1[2] >> 9) & 1;
+    const bool osxsave = (leaf1[2] >> 27) & 1;
+    const bool avx = (leaf1[2] >> 28) & 1;
+    const uint64_t xcr0 = osxsave ? xgetbv() : 0;
+    const bool ymm = (xcr0 & 0x6) == 0x6;
+    const bool zmm = (xcr0 & 0xE6) == 0xE6;
+    const bool avx2 = (leaf7[1] >> 5) & 1;
+    const bool avx512f = (leaf7[1] >> 16) & 1;
+    const bool avx512bw = (leaf7[1] >> 30) & 1;
+
+    if (avx && ymm && avx2 && zmm && avx512f && avx512bw) {
+        return isa::avx512;
+    } else if (avx && ymm && avx2) {
+        return isa::avx2;
+    } else if (ssse3 && sse2) {
+        return isa::ssse3;
+    } else if (sse2) {
+        return isa::sse2;
+    }
+#endif
+    return isa::scalar;
+}
+
+
+/** \brief Active level, or -1 before first use.
+ */
+inline std::atomic<int> & isa_state() noexcept
+{
+    static std::atomic<int> state(-1);
+    return state;
+}
+
+
+/** \brief Detected level, lowered by the `WTL_ISA` environment variable.
+ */
+inline isa initial_isa() noexcept
+{
+    isa level = detected_isa();
+    isa requested;
+    const char *name = std::getenv("WTL_ISA");
+    if (name && parse_isa(name, requested) && requested < level) {
+        level = requested;
+    }
+    return level;
+}
+
+}   /* detail */
+
+
+// IMPLEMENTATION
+// --------------
+
+
+inline const char * isa_name(isa level) noexcept
+{
+    switch (level) {
+        case isa::scalar:
+            return "scalar";
+        case isa::sse2:
+            return "sse2";
+        case isa::ssse3:
+            return "ssse3";
+        case isa::avx2:
+            return "avx2";
+        case isa::avx512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+
+/** \brief Parse a level from its `isa_name`.
+ *
+ *  \return         Whether `name` names a level.
+ */
+inline bool parse_isa(const char *name,
+    isa &level) noexcept
+{
+    for (size_t i = 0; i < isa_levels; ++i) {
+        if (std::strcmp(name, isa_name(static_cast<isa>(i))) == 0) {
+            level = static_cast<isa>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/** \brief Best level supported by the CPU and OS, detected once.
+ */
+inline isa detected_isa() noexcept
+{
+    static const isa level = detail::detect_isa();
+    return level;
+}
+
+
+/** \brief Level used by the kernels behind `basic_string`.
+ *
+ *  Defaults to `detected_isa()`, or to the `WTL_ISA` environment
+ *  variable (`scalar`, `sse2`, `ssse3`, `avx2` or `avx512`) when that
+ *  names a lower level.
+ */
+inline isa active_isa() noexcept
+{
+    int level = detail::isa_state().load(std::memory_order_relaxed);
+    if (level < 0) {
+        level = static_cast<int>(detail::initial_isa());
+        detail::isa_state().store(level, std::memory_order_relaxed);
+    }
+    return static_cast<isa>(level);
+}
+
+
+/** \brief Force the kernels to `level`, clamped to `detected_isa()`.
+ *
+ *  Intended for testing and benchmarking each kernel variant.
+ *
+ *  \return         The level now active.
+ */
+inline isa set_isa(isa level) noexcept
+{
+    if (level > detected_isa()) {
+        level = detected_isa();
+    }
+    detail::isa_state().store(static_cast<int>(level), std::memory_order_relaxed);
+    return level;
+}
+
+
+/** \brief Restore the level chosen at startup.
+ */
+inline void reset_isa() noexcept
+{
+    detail::isa_state().store(static_cast<int>(detail::initial_isa()), std::memory_order_relaxed);
+}
+
+
+namespace detail
+{
+// DISPATCH
+// --------
+
+
+/** \brief Select the active entry from a per-level kernel table.
+ */
+template <typename Function>
+inline Function dispatch(const Function (&table)[isa_levels]) noexcept
+{
+    return table[static_cast<int>(active_isa())];
+}
+
+}   /* detail */
+}   /* wtl */
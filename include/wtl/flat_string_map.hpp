@@ -0,0 +1,732 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/hash.hpp>
+#include <wtl/string.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace wtl
+{
+namespace detail
+{
+// CONTROL BYTES
+// -------------
+
+// Each slot has a control byte: empty, deleted, or the low 7 bits of
+// the key's hash when full. Full bytes are non-negative, so the sign
+// bit alone tells whether a slot is available.
+
+static const int8_t ctrl_empty = -128;
+static const int8_t ctrl_deleted = -2;
+
+
+/** \brief Window of 16 control bytes, matched in parallel.
+ */
+class probe_group
+{
+protected:
+#if defined(WTL_SSE2)
+    __m128i ctrl_;
+#else
+    const int8_t *ctrl_;
+#endif
+
+public:
+    static const size_t width = 16;
+
+    explicit probe_group(const int8_t *ctrl) noexcept;
+
+    uint32_t match(int8_t tag) const noexcept;
+    uint32_t match_empty() const noexcept;
+    uint32_t match_available() const noexcept;
+};
+
+
+#if defined(WTL_SSE2)
+
+inline probe_group::probe_group(const int8_t *ctrl) noexcept:
+    ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+{}
+
+
+inline uint32_t probe_group::match(int8_t tag) const noexcept
+{
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), ctrl_)));
+}
+
+
+inline uint32_t probe_group::match_empty() const noexcept
+{
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl_empty), ctrl_)));
+}
+
+
+/** \brief Empty or deleted slots, which both have the sign bit set.
+ */
+inline uint32_t probe_group::match_available() const noexcept
+{
+    return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_));
+}
+
+#else
+
+inline probe_group::probe_group(const int8_t *ctrl) noexcept:
+    ctrl_(ctrl)
+{}
+
+
+inline uint32_t probe_group::match(int8_t tag) const noexcept
+{
+    uint32_t mask = 0;
+    for (size_t i = 0; i < width; ++i) {
+        mask |= uint32_t(ctrl_[i] == tag) << i;
+    }
+    return mask;
+}
+
+
+inline uint32_t probe_group::match_empty() const noexcept
+{
+    return match(ctrl_empty);
+}
+
+
+inline uint32_t probe_group::match_available() const noexcept
+{
+    uint32_t mask = 0;
+    for (size_t i = 0; i < width; ++i) {
+        mask |= uint32_t(ctrl_[i] < 0) << i;
+    }
+    return mask;
+}
+
+#endif
+
+
+/** \brief Forward iterator over the full slots of a flat map.
+ */
+template <typename Value>
+class flat_iterator
+{
+protected:
+    const int8_t *ctrl_ = nullptr;
+    Value *slot_ = nullptr;
+    Value *last_ = nullptr;
+
+    void skip() noexcept
+    {
+        while (slot_ != last_ && *ctrl_ < 0) {
+            ++ctrl_;
+            ++slot_;
+        }
+    }
+
+    template <typename U>
+    friend class flat_iterator;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    flat_iterator() = default;
+
+    flat_iterator(const int8_t *ctrl,
+            Value *slot,
+            Value *last) noexcept:
+        ctrl_(ctrl),
+        slot_(slot),
+        last_(last)
+    {
+        skip();
+    }
+
+    template <typename U>
+    flat_iterator(const flat_iterator<U> &other) noexcept:
+        ctrl_(other.ctrl_),
+        slot_(other.slot_),
+        last_(other.last_)
+    {}
+
+    reference operator*() const noexcept
+    {
+        return *slot_;
+    }
+
+    pointer operator->() const noexcept
+    {
+        return slot_;
+    }
+
+    flat_iterator & operator++() noexcept
+    {
+        ++ctrl_;
+        ++slot_;
+        skip();
+        return *this;
+    }
+
+    flat_iterator operator++(int) noexcept
+    {
+        flat_iterator copy(*this);
+        ++*this;
+        return copy;
+    }
+
+    template <typename U>
+    bool operator==(const flat_iterator<U> &other) const noexcept
+    {
+        return slot_ == other.slot_;
+    }
+
+    template <typename U>
+    bool operator!=(const flat_iterator<U> &other) const noexcept
+    {
+        return slot_ != other.slot_;
+    }
+};
+
+}   /* detail */
+
+// DECLARATION
+// -----------
+
+
+/** \brief Open-addressing hash map from string views to values.
+ *
+ *  Follows the Swiss table layout: a control byte per slot holds a
+ *  7-bit tag of the key's hash, and lookups compare 16 tags at once
+ *  with SSE2 before touching any slot. Slots hold the key's pointer and
+ *  length inline with the value, so a tag match is confirmed by length
+ *  and pointer before the key bytes are compared.
+ *
+ *  \warning The map stores views: the lifetime of each key's data must
+ *  outlive its entry.
+ */
+template <
+    typename V,
+    typename Hash = string_hash
+>
+class flat_string_map
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef string key_type;
+    typedef V mapped_type;
+    typedef std::pair<string, V> value_type;
+    typedef Hash hasher;
+    typedef size_t size_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef detail::flat_iterator<value_type> iterator;
+    typedef detail::flat_iterator<const value_type> const_iterator;
+
+protected:
+    std::vector<int8_t> ctrl_;
+    value_type *slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    size_t growth_left_ = 0;
+    Hash hash_;
+
+    static int8_t tag(size_t hash) noexcept;
+    void set_ctrl(size_t index,
+        int8_t value) noexcept;
+    size_t find_index(const string &key,
+        size_t hash) const noexcept;
+    size_t find_available(size_t hash) const noexcept;
+    void rehash(size_t capacity);
+    void destroy() noexcept;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    flat_string_map() = default;
+    flat_string_map(const flat_string_map &other);
+    flat_string_map & operator=(const flat_string_map &other);
+    flat_string_map(flat_string_map &&other) noexcept;
+    flat_string_map & operator=(flat_string_map &&other) noexcept;
+    ~flat_string_map();
+
+    explicit flat_string_map(size_t count);
+    flat_string_map(std::initializer_list<value_type> list);
+
+    // ITERATORS
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // CAPACITY
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+    size_t capacity() const noexcept;
+    double load_factor() const noexcept;
+
+    // MODIFIERS
+    void clear() noexcept;
+    void reserve(size_t count);
+    std::pair<iterator, bool> insert(const value_type &value);
+    template <typename... Ts>
+    std::pair<iterator, bool> emplace(const string &key,
+        Ts &&... ts);
+    size_t erase(const string &key);
+    void swap(flat_string_map &other) noexcept;
+
+    // LOOKUP
+    V & operator[](const string &key);
+    V & at(const string &key);
+    const V & at(const string &key) const;
+    iterator find(const string &key) noexcept;
+    const_iterator find(const string &key) const noexcept;
+    size_t count(const string &key) const noexcept;
+    bool contains(const string &key) const noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename V, typename H>
+flat_string_map<V, H>::flat_string_map(const flat_string_map &other):
+    hash_(other.hash_)
+{
+    reserve(other.size());
+    for (const value_type &value: other) {
+        insert(value);
+    }
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::operator=(const flat_string_map &other)
+    -> flat_string_map &
+{
+    if (this != &other) {
+        flat_string_map copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+
+template <typename V, typename H>
+flat_string_map<V, H>::flat_string_map(flat_string_map &&other) noexcept
+{
+    swap(other);
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::operator=(flat_string_map &&other) noexcept
+    -> flat_string_map &
+{
+    swap(other);
+    return *this;
+}
+
+
+template <typename V, typename H>
+flat_string_map<V, H>::~flat_string_map()
+{
+    destroy();
+}
+
+
+template <typename V, typename H>
+flat_string_map<V, H>::flat_string_map(size_t count)
+{
+    reserve(count);
+}
+
+
+template <typename V, typename H>
+flat_string_map<V, H>::flat_string_map(std::initializer_list<value_type> list)
+{
+    reserve(list.size());
+    for (const value_type &value: list) {
+        insert(value);
+    }
+}
+
+
+template <typename V, typename H>
+int8_t flat_string_map<V, H>::tag(size_t hash) noexcept
+{
+    return static_cast<int8_t>(hash & 0x7F);
+}
+
+
+/** \brief Set a control byte, mirroring the first group past the end.
+ *
+ *  The mirror lets a group load starting near the end read the
+ *  wrapped-around bytes without a second load.
+ */
+template <typename V, typename H>
+void flat_string_map<V, H>::set_ctrl(size_t index,
+    int8_t value) noexcept
+{
+    ctrl_[index] = value;
+    if (index < detail::probe_group::width) {
+        ctrl_[capacity_ + index] = value;
+    }
+}
+
+
+/** \brief Probe group by group for `key`, stopping at an empty slot.
+ *
+ *  \return         Slot index, or `capacity_` if absent.
+ */
+template <typename V, typename H>
+size_t flat_string_map<V, H>::find_index(const string &key,
+    size_t hash) const noexcept
+{
+    if (size_ == 0) {
+        return capacity_;
+    }
+
+    const size_t mask = capacity_ - 1;
+    const int8_t t = tag(hash);
+    size_t position = (hash >> 7) & mask;
+    for (size_t step = detail::probe_group::width; ; step += detail::probe_group::width) {
+        detail::probe_group group(ctrl_.data() + position);
+        for (uint32_t match = group.match(t); match; match &= match - 1) {
+            size_t index = (position + detail::ctz32(match)) & mask;
+            const string &candidate = slots_[index].first;
+            if (candidate.size() == key.size() && (key.empty() || candidate.data() == key.data()
+                || std::memcmp(candidate.data(), key.data(), key.size()) == 0)) {
+                return index;
+            }
+        }
+        if (group.match_empty()) {
+            return capacity_;
+        }
+        position = (position + step) & mask;
+    }
+}
+
+
+/** \brief First empty or deleted slot on the probe sequence of `hash`.
+ */
+template <typename V, typename H>
+size_t flat_string_map<V, H>::find_available(size_t hash) const noexcept
+{
+    const size_t mask = capacity_ - 1;
+    size_t position = (hash >> 7) & mask;
+    for (size_t step = detail::probe_group::width; ; step += detail::probe_group::width) {
+        uint32_t match = detail::probe_group(ctrl_.data() + position).match_available();
+        if (match) {
+            return (position + detail::ctz32(match)) & mask;
+        }
+        position = (position + step) & mask;
+    }
+}
+
+
+/** \brief Move every entry into a table of `capacity` slots.
+ *
+ *  Entries are copied instead when their move constructor may throw,
+ *  and the new table replaces the old one only once every entry is
+ *  placed, so a throwing rehash leaves the map unchanged.
+ */
+template <typename V, typename H>
+void flat_string_map<V, H>::rehash(size_t capacity)
+{
+    flat_string_map table;
+    table.hash_ = hash_;
+    table.ctrl_.assign(capacity + detail::probe_group::width, detail::ctrl_empty);
+    table.slots_ = std::allocator<value_type>().allocate(capacity);
+    table.capacity_ = capacity;
+    table.growth_left_ = capacity - capacity / 8;
+
+    for (size_t i = 0; i < capacity_; ++i) {
+        if (ctrl_[i] >= 0) {
+            size_t hash = hash_(slots_[i].first);
+            size_t index = table.find_available(hash);
+            ::new (static_cast<void*>(table.slots_ + index)) value_type(std::move_if_noexcept(slots_[i]));
+            table.set_ctrl(index, tag(hash));
+            ++table.size_;
+            --table.growth_left_;
+        }
+    }
+    swap(table);
+}
+
+
+template <typename V, typename H>
+void flat_string_map<V, H>::destroy() noexcept
+{
+    if (slots_) {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (size_t i = 0; i < capacity_; ++i) {
+                if (ctrl_[i] >= 0) {
+                    slots_[i].~value_type();
+                }
+            }
+        }
+        std::allocator<value_type>().deallocate(slots_, capacity_);
+    }
+    slots_ = nullptr;
+    ctrl_.clear();
+    capacity_ = size_ = growth_left_ = 0;
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::begin() noexcept
+    -> iterator
+{
+    return iterator(ctrl_.data(), slots_, slots_ + capacity_);
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::end() noexcept
+    -> iterator
+{
+    return iterator(nullptr, slots_ + capacity_, slots_ + capacity_);
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::begin() const noexcept
+    -> const_iterator
+{
+    return const_iterator(ctrl_.data(), slots_, slots_ + capacity_);
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator(nullptr, slots_ + capacity_, slots_ + capacity_);
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename V, typename H>
+size_t flat_string_map<V, H>::size() const noexcept
+{
+    return size_;
+}
+
+
+template <typename V, typename H>
+bool flat_string_map<V, H>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename V, typename H>
+size_t flat_string_map<V, H>::capacity() const noexcept
+{
+    return capacity_;
+}
+
+
+template <typename V, typename H>
+double flat_string_map<V, H>::load_factor() const noexcept
+{
+    return capacity_ ? static_cast<double>(size_) / capacity_ : 0.0;
+}
+
+
+template <typename V, typename H>
+void flat_string_map<V, H>::clear() noexcept
+{
+    if (!std::is_trivially_destructible<value_type>::value) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                slots_[i].~value_type();
+            }
+        }
+    }
+    std::fill(ctrl_.begin(), ctrl_.end(), detail::ctrl_empty);
+    size_ = 0;
+    growth_left_ = capacity_ - capacity_ / 8;
+}
+
+
+/** \brief Grow so `count` entries fit under the 7/8 maximum load.
+ */
+template <typename V, typename H>
+void flat_string_map<V, H>::reserve(size_t count)
+{
+    size_t capacity = detail::probe_group::width;
+    while (capacity - capacity / 8 < count) {
+        capacity *= 2;
+    }
+    if (capacity > capacity_) {
+        rehash(capacity);
+    }
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::insert(const value_type &value)
+    -> std::pair<iterator, bool>
+{
+    return emplace(value.first, value.second);
+}
+
+
+template <typename V, typename H>
+template <typename... Ts>
+auto flat_string_map<V, H>::emplace(const string &key,
+    Ts &&... ts)
+    -> std::pair<iterator, bool>
+{
+    size_t hash = hash_(key);
+    size_t index = find_index(key, hash);
+    if (index != capacity_) {
+        return std::make_pair(iterator(ctrl_.data() + index, slots_ + index, slots_ + capacity_), false);
+    }
+
+    if (growth_left_ == 0) {
+        // grow when mostly full, otherwise only purge deleted slots
+        rehash(capacity_ == 0 ? detail::probe_group::width : size_ * 2 >= capacity_ ? capacity_ * 2 : capacity_);
+    }
+    index = find_available(hash);
+    ::new (static_cast<void*>(slots_ + index)) value_type(std::piecewise_construct,
+        std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Ts>(ts)...));
+    if (ctrl_[index] == detail::ctrl_empty) {
+        --growth_left_;
+    }
+    set_ctrl(index, tag(hash));
+    ++size_;
+
+    return std::make_pair(iterator(ctrl_.data() + index, slots_ + index, slots_ + capacity_), true);
+}
+
+
+/** \brief Remove `key`, leaving a deleted marker so probes continue past it.
+ */
+template <typename V, typename H>
+size_t flat_string_map<V, H>::erase(const string &key)
+{
+    size_t index = find_index(key, hash_(key));
+    if (index == capacity_) {
+        return 0;
+    }
+    slots_[index].~value_type();
+    set_ctrl(index, detail::ctrl_deleted);
+    --size_;
+    return 1;
+}
+
+
+template <typename V, typename H>
+void flat_string_map<V, H>::swap(flat_string_map &other) noexcept
+{
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+}
+
+
+template <typename V, typename H>
+V & flat_string_map<V, H>::operator[](const string &key)
+{
+    return emplace(key).first->second;
+}
+
+
+template <typename V, typename H>
+V & flat_string_map<V, H>::at(const string &key)
+{
+    size_t index = find_index(key, hash_(key));
+    if (index == capacity_) {
+        throw std::out_of_range("flat_string_map::at().");
+    }
+    return slots_[index].second;
+}
+
+
+template <typename V, typename H>
+const V & flat_string_map<V, H>::at(const string &key) const
+{
+    size_t index = find_index(key, hash_(key));
+    if (index == capacity_) {
+        throw std::out_of_range("flat_string_map::at().");
+    }
+    return slots_[index].second;
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::find(const string &key) noexcept
+    -> iterator
+{
+    size_t index = find_index(key, hash_(key));
+    if (index == capacity_) {
+        return end();
+    }
+    return iterator(ctrl_.data() + index, slots_ + index, slots_ + capacity_);
+}
+
+
+template <typename V, typename H>
+auto flat_string_map<V, H>::find(const string &key) const noexcept
+    -> const_iterator
+{
+    size_t index = find_index(key, hash_(key));
+    if (index == capacity_) {
+        return end();
+    }
+    return const_iterator(ctrl_.data() + index, slots_ + index, slots_ + capacity_);
+}
+
+
+template <typename V, typename H>
+size_t flat_string_map<V, H>::count(const string &key) const noexcept
+{
+    return contains(key) ? 1 : 0;
+}
+
+
+template <typename V, typename H>
+bool flat_string_map<V, H>::contains(const string &key) const noexcept
+{
+    return find_index(key, hash_(key)) != capacity_;
+}
+
+}   /* wtl */
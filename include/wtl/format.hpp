@@ -0,0 +1,651 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/arena.hpp>
+#include <wtl/string.hpp>
+#include <wtl/detail/digits.hpp>
+#include <wtl/detail/ryu.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Radix of a formatted integer, as in format spec types.
+ */
+enum class format_type
+{
+    decimal,        // d
+    hex,            // x
+    upper_hex,      // X
+    octal,          // o
+    binary,         // b
+};
+
+
+/** \brief Output buffer for formatting numbers and views without allocation.
+ *
+ *  Writes into a caller-supplied buffer, throwing `std::length_error`
+ *  when a value does not fit, or into blocks of a caller-supplied arena, moving
+ *  to a block twice the size when one is full. Views returned by
+ *  `format` or `str` stay valid until the arena is reset, but only
+ *  the latest reflects later writes.
+ */
+class format_buffer
+{
+protected:
+    char *first_ = nullptr;
+    char *cursor_ = nullptr;
+    char *last_ = nullptr;
+    arena *arena_ = nullptr;
+
+    void grow(size_t n);
+
+public:
+    // MEMBER VARIABLES
+    // ----------------
+    static const size_t max_integer_size = 65;
+    static const size_t max_float_size = 24;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    format_buffer(char *first,
+        size_t size) noexcept;
+    explicit format_buffer(arena &scratch,
+        size_t capacity = 256);
+
+    // CAPACITY
+    size_t size() const noexcept;
+    size_t capacity() const noexcept;
+    bool empty() const noexcept;
+    char * reserve(size_t n);
+
+    // MODIFIERS
+    void clear() noexcept;
+    format_buffer & append(const string &str);
+    format_buffer & append(const char *str);
+    format_buffer & append(char c);
+    format_buffer & append(bool value);
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, format_buffer &>::type
+    append(T value,
+        format_type type = format_type::decimal);
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, format_buffer &>::type
+    append(T value);
+
+    // VIEWS
+    char * data() const noexcept;
+    string str() const noexcept;
+};
+
+
+/** \brief Base of the format string types created by `WTL_FORMAT`.
+ */
+struct format_string
+{};
+
+
+/** \brief Format string checked at compile time against its arguments.
+ *
+ *  Fields are `{}`, or `{:d}`, `{:x}`, `{:X}`, `{:o}` or `{:b}` for
+ *  integers, and `{{` and `}}` escape braces.
+ */
+#define WTL_FORMAT(literal)                                             \
+    [] {                                                                \
+        struct spec: ::wtl::format_string                               \
+        {                                                               \
+            static constexpr const char * data() noexcept               \
+            {                                                           \
+                return literal;                                         \
+            }                                                           \
+        };                                                              \
+        return spec();                                                  \
+    }()
+
+
+// IMPLEMENTATION
+// --------------
+
+namespace detail
+{
+// INTEGERS
+// --------
+
+
+template <typename T>
+bool is_negative(T value,
+    std::true_type) noexcept
+{
+    return value < 0;
+}
+
+
+template <typename T>
+bool is_negative(T,
+    std::false_type) noexcept
+{
+    return false;
+}
+
+
+template <typename T>
+uint64_t magnitude(T value,
+    bool &negative) noexcept
+{
+    typedef typename std::make_unsigned<T>::type unsigned_type;
+    negative = is_negative(value, std::is_signed<T>());
+    const unsigned_type bits = static_cast<unsigned_type>(value);
+    return negative ? static_cast<unsigned_type>(0 - bits) : bits;
+}
+
+
+/** \brief Write `value` in decimal at `first`, returning the end.
+ */
+template <typename T>
+char * format_integer(char *first,
+    T value) noexcept
+{
+    bool negative;
+    const uint64_t digits = magnitude(value, negative);
+    *first = '-';
+    first += negative;
+    char *last = first + count_digits(digits);
+    write_digits(last, digits);
+    return last;
+}
+
+
+/** \brief Write `value` with `shift` bits per digit at `first`.
+ */
+template <typename T>
+char * format_power2(char *first,
+    T value,
+    unsigned shift,
+    bool upper) noexcept
+{
+    const char *alphabet = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    bool negative;
+    uint64_t digits = magnitude(value, negative);
+    *first = '-';
+    first += negative;
+    const unsigned bits = 64 - clz64(digits | 1);
+    char *last = first + (bits + shift - 1) / shift;
+    const uint64_t mask = (uint64_t(1) << shift) - 1;
+    for (char *p = last; p != first; digits >>= shift) {
+        *--p = alphabet[digits & mask];
+    }
+    return last;
+}
+
+
+template <typename T>
+char * format_integer(char *first,
+    T value,
+    format_type type) noexcept
+{
+    switch (type) {
+        case format_type::hex:
+            return format_power2(first, value, 4, false);
+        case format_type::upper_hex:
+            return format_power2(first, value, 4, true);
+        case format_type::octal:
+            return format_power2(first, value, 3, false);
+        case format_type::binary:
+            return format_power2(first, value, 1, false);
+        default:
+            return format_integer(first, value);
+    }
+}
+
+// FLOATS
+// ------
+
+
+/** \brief Write the decimal digits of a 128-bit value backwards, returning the count.
+ */
+inline size_t write_uint128(char *last,
+    uint64_t high,
+    uint64_t low) noexcept
+{
+    uint32_t limbs[4] = {
+        static_cast<uint32_t>(high >> 32), static_cast<uint32_t>(high),
+        static_cast<uint32_t>(low >> 32), static_cast<uint32_t>(low),
+    };
+    size_t count = 0;
+    for (;;) {
+        // divide by 10^9, and emit the remainder
+        uint64_t remainder = 0;
+        for (uint32_t &limb: limbs) {
+            const uint64_t current = (remainder << 32) | limb;
+            limb = static_cast<uint32_t>(current / 1000000000);
+            remainder = current % 1000000000;
+        }
+        if (!(limbs[0] | limbs[1] | limbs[2] | limbs[3])) {
+            write_digits(last - count, remainder);
+            return count + count_digits(remainder);
+        }
+        for (size_t i = 0; i < 9; ++i, remainder /= 10) {
+            *(last - ++count) = static_cast<char>('0' + remainder % 10);
+        }
+    }
+}
+
+
+/** \brief Write the shortest representation that parses back to `value`.
+ *
+ *  Picks fixed or scientific notation, whichever is shorter, and fixed
+ *  on ties, as `std::to_chars` does, with digits from Ryu. Like it,
+ *  integers in fixed notation print all their digits exactly.
+ */
+template <typename T>
+char * format_float(char *first,
+    T value) noexcept
+{
+    typedef binary_format<T> format;
+    typedef typename format::bits_type bits_type;
+    const int total_bits = static_cast<int>(sizeof(T) * 8);
+    bits_type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    const uint64_t ieee_mantissa = bits & ((bits_type(1) << format::mantissa_bits) - 1);
+    const uint32_t ieee_exponent = static_cast<uint32_t>(bits >> format::mantissa_bits) & format::infinite_power;
+
+    *first = '-';
+    first += bits >> (total_bits - 1);
+    if (ieee_exponent == static_cast<uint32_t>(format::infinite_power)) {
+        std::memcpy(first, ieee_mantissa ? "nan" : "inf", 3);
+        return first + 3;
+    } else if (ieee_exponent == 0 && ieee_mantissa == 0) {
+        *first = '0';
+        return first + 1;
+    }
+
+    const decimal_float decimal = ryu<T>(ieee_mantissa, ieee_exponent);
+    const int32_t length = static_cast<int32_t>(count_digits(decimal.mantissa));
+    const int32_t exponent = decimal.exponent + length - 1;
+    const int32_t exponent_length = exponent >= 100 || exponent <= -100 ? 3 : 2;
+    const int32_t scientific_length = length + (length > 1) + 2 + exponent_length;
+
+    // integers in fixed notation print their exact digits, not zeros
+    if (decimal.exponent > 0 && exponent < scientific_length) {
+        const int bias = -format::minimum_exponent;
+        const int e2 = static_cast<int>(ieee_exponent) - bias - format::mantissa_bits;
+        const uint64_t m2 = (uint64_t(1) << format::mantissa_bits) | ieee_mantissa;
+        char digits[40];
+        size_t count;
+        if (e2 <= 0) {
+            count = write_uint128(digits + sizeof(digits), 0, m2 >> -e2);
+        } else {
+            count = write_uint128(digits + sizeof(digits), m2 >> (64 - e2), m2 << e2);
+        }
+        if (static_cast<int32_t>(count) <= scientific_length) {
+            std::memcpy(first, digits + sizeof(digits) - count, count);
+            return first + count;
+        }
+    }
+
+    int32_t fixed_length;
+    if (decimal.exponent >= 0) {
+        fixed_length = length + decimal.exponent;
+    } else if (exponent >= 0) {
+        fixed_length = length + 1;
+    } else {
+        fixed_length = length + 1 - exponent;
+    }
+
+    if (fixed_length <= scientific_length) {
+        if (decimal.exponent >= 0) {
+            write_digits(first + length, decimal.mantissa);
+            std::memset(first + length, '0', static_cast<size_t>(decimal.exponent));
+        } else if (exponent >= 0) {
+            write_digits(first + length + 1, decimal.mantissa);
+            std::memmove(first, first + 1, static_cast<size_t>(exponent + 1));
+            first[exponent + 1] = '.';
+        } else {
+            std::memset(first, '0', static_cast<size_t>(1 - exponent));
+            first[1] = '.';
+            write_digits(first + fixed_length, decimal.mantissa);
+        }
+        return first + fixed_length;
+    }
+
+    write_digits(first + length + 1, decimal.mantissa);
+    first[0] = first[1];
+    first[1] = '.';
+    char *p = first + length + (length > 1);
+    *p++ = 'e';
+    *p++ = exponent < 0 ? '-' : '+';
+    const uint32_t abs_exponent = static_cast<uint32_t>(exponent < 0 ? -exponent : exponent);
+    write_digits(p + exponent_length, abs_exponent);
+    if (abs_exponent < 10) {
+        *p = '0';
+    }
+    return p + exponent_length;
+}
+
+// FORMAT STRINGS
+// --------------
+
+static const size_t format_error = static_cast<size_t>(-1);
+
+
+constexpr bool is_format_type(char c) noexcept
+{
+    return c == 'd' || c == 'x' || c == 'X' || c == 'o' || c == 'b';
+}
+
+
+constexpr bool is_format_escape(const char *s) noexcept
+{
+    return (s[0] == '{' && s[1] == '{') || (s[0] == '}' && s[1] == '}');
+}
+
+
+/** \brief Number of fields in a format string, or `format_error`.
+ */
+constexpr size_t format_fields(const char *s,
+    size_t count = 0) noexcept
+{
+    return *s == '\0' ? count
+        : is_format_escape(s) ? format_fields(s + 2, count)
+        : s[0] == '{' && s[1] == '}' ? format_fields(s + 2, count + 1)
+        : s[0] == '{' && s[1] == ':' && is_format_type(s[2]) && s[3] == '}' ? format_fields(s + 4, count + 1)
+        : s[0] == '{' || s[0] == '}' ? format_error
+        : format_fields(s + 1, count);
+}
+
+
+/** \brief Type character of field `index`, or `'\0'` for `{}`.
+ */
+constexpr char format_type_at(const char *s,
+    size_t index) noexcept
+{
+    return *s == '\0' ? '\0'
+        : is_format_escape(s) ? format_type_at(s + 2, index)
+        : s[0] == '{' && s[1] == '}' ? (index == 0 ? '\0' : format_type_at(s + 2, index - 1))
+        : s[0] == '{' ? (index == 0 ? s[2] : format_type_at(s + 4, index - 1))
+        : format_type_at(s + 1, index);
+}
+
+
+inline format_type to_format_type(char c) noexcept
+{
+    switch (c) {
+        case 'x':
+            return format_type::hex;
+        case 'X':
+            return format_type::upper_hex;
+        case 'o':
+            return format_type::octal;
+        case 'b':
+            return format_type::binary;
+        default:
+            return format_type::decimal;
+    }
+}
+
+
+/** \brief Copy literal text up to the next field, and return its type.
+ */
+inline char format_literal(format_buffer &buffer,
+    const char *&spec)
+{
+    for (;;) {
+        const char *start = spec;
+        while (*spec && *spec != '{' && *spec != '}') {
+            ++spec;
+        }
+        buffer.append(string(start, spec - start));
+        if (*spec == '\0') {
+            return '\0';
+        } else if (is_format_escape(spec)) {
+            buffer.append(*spec);
+            spec += 2;
+        } else if (spec[1] == '}') {
+            spec += 2;
+            return '\0';
+        } else {
+            const char type = spec[2];
+            spec += 4;
+            return type;
+        }
+    }
+}
+
+
+template <typename T>
+struct is_format_integer: std::integral_constant<bool,
+    std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value>
+{};
+
+
+template <typename T>
+void format_arg(format_buffer &buffer,
+    const T &value,
+    char type,
+    std::true_type)
+{
+    buffer.append(value, to_format_type(type));
+}
+
+
+template <typename T>
+void format_arg(format_buffer &buffer,
+    const T &value,
+    char,
+    std::false_type)
+{
+    buffer.append(value);
+}
+
+
+template <typename Spec, size_t Index>
+void format_args(format_buffer &buffer,
+    const char *&spec)
+{
+    format_literal(buffer, spec);
+}
+
+
+template <typename Spec, size_t Index, typename T, typename... Args>
+void format_args(format_buffer &buffer,
+    const char *&spec,
+    const T &value,
+    const Args &...args)
+{
+    static_assert(format_type_at(Spec::data(), Index) == '\0' || is_format_integer<T>::value,
+        "wtl::format(): integer format type for a non-integer argument.");
+    const char type = format_literal(buffer, spec);
+    format_arg(buffer, value, type, is_format_integer<T>());
+    format_args<Spec, Index + 1>(buffer, spec, args...);
+}
+
+}   /* detail */
+
+
+inline format_buffer::format_buffer(char *first,
+        size_t size) noexcept:
+    first_(first),
+    cursor_(first),
+    last_(first + size)
+{}
+
+
+inline format_buffer::format_buffer(arena &scratch,
+        size_t capacity):
+    arena_(&scratch)
+{
+    first_ = cursor_ = static_cast<char*>(scratch.allocate(capacity, 1));
+    last_ = first_ + capacity;
+}
+
+
+inline size_t format_buffer::size() const noexcept
+{
+    return static_cast<size_t>(cursor_ - first_);
+}
+
+
+inline size_t format_buffer::capacity() const noexcept
+{
+    return static_cast<size_t>(last_ - first_);
+}
+
+
+inline bool format_buffer::empty() const noexcept
+{
+    return cursor_ == first_;
+}
+
+
+/** \brief Move the contents to an arena block with room for `n` more bytes.
+ */
+inline void format_buffer::grow(size_t n)
+{
+    if (!arena_) {
+        throw std::length_error("format_buffer::reserve().");
+    }
+    const size_t length = size();
+    const size_t capacity = std::max(2 * this->capacity(), length + n);
+    char *data = static_cast<char*>(arena_->allocate(capacity, 1));
+    if (length) {
+        std::memcpy(data, first_, length);
+    }
+    first_ = data;
+    cursor_ = data + length;
+    last_ = data + capacity;
+}
+
+
+/** \brief Ensure room for `n` more bytes, and return where they start.
+ */
+inline char * format_buffer::reserve(size_t n)
+{
+    if (static_cast<size_t>(last_ - cursor_) < n) {
+        grow(n);
+    }
+    return cursor_;
+}
+
+
+inline void format_buffer::clear() noexcept
+{
+    cursor_ = first_;
+}
+
+
+inline format_buffer & format_buffer::append(const string &str)
+{
+    if (!str.empty()) {
+        std::memcpy(reserve(str.size()), str.data(), str.size());
+        cursor_ += str.size();
+    }
+    return *this;
+}
+
+
+inline format_buffer & format_buffer::append(const char *str)
+{
+    return append(string(str));
+}
+
+
+inline format_buffer & format_buffer::append(char c)
+{
+    *reserve(1) = c;
+    ++cursor_;
+    return *this;
+}
+
+
+inline format_buffer & format_buffer::append(bool value)
+{
+    return append(value ? string("true", 4) : string("false", 5));
+}
+
+
+/** \brief Append `value`, in place when room remains for the longest integer.
+ */
+template <typename T>
+auto format_buffer::append(T value,
+    format_type type)
+    -> typename std::enable_if<std::is_integral<T>::value, format_buffer &>::type
+{
+    if (static_cast<size_t>(last_ - cursor_) >= max_integer_size) {
+        cursor_ = detail::format_integer(cursor_, value, type);
+        return *this;
+    }
+    char temp[max_integer_size];
+    return append(string(temp, detail::format_integer(temp, value, type) - temp));
+}
+
+
+template <typename T>
+auto format_buffer::append(T value)
+    -> typename std::enable_if<std::is_floating_point<T>::value, format_buffer &>::type
+{
+    if (static_cast<size_t>(last_ - cursor_) >= max_float_size) {
+        cursor_ = detail::format_float(cursor_, value);
+        return *this;
+    }
+    char temp[max_float_size];
+    return append(string(temp, detail::format_float(temp, value) - temp));
+}
+
+
+inline char * format_buffer::data() const noexcept
+{
+    return first_;
+}
+
+
+/** \brief View of everything written since construction or `clear`.
+ */
+inline string format_buffer::str() const noexcept
+{
+    return string(first_, size());
+}
+
+
+template <typename T>
+format_buffer & operator<<(format_buffer &buffer,
+    const T &value)
+{
+    return buffer.append(value);
+}
+
+
+/** \brief Append `args` formatted by a `WTL_FORMAT` string, returning what was written.
+ *
+ *  The field count and field types are checked at compile time.
+ */
+template <typename Spec, typename... Args>
+string format(format_buffer &buffer,
+    Spec,
+    const Args &...args)
+{
+    static_assert(std::is_base_of<format_string, Spec>::value,
+        "wtl::format(): format strings must be created with WTL_FORMAT.");
+    static_assert(detail::format_fields(Spec::data()) != detail::format_error,
+        "wtl::format(): malformed format string.");
+    static_assert(detail::format_fields(Spec::data()) == sizeof...(Args),
+        "wtl::format(): argument count does not match the format string.");
+
+    const size_t start = buffer.size();
+    const char *spec = Spec::data();
+    detail::format_args<Spec, 0>(buffer, spec, args...);
+    return string(buffer.data() + start, buffer.size() - start);
+}
+
+}   /* wtl */
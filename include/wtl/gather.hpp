@@ -0,0 +1,262 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/segmented_string.hpp>
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+#include <wtl/detail/posix.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <system_error>
+#include <vector>
+
+#if defined(WTL_POSIX)
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Batch of views written to a file descriptor with `writev`.
+ *
+ *  Views are recorded as `iovec` entries rather than copied, and a
+ *  view that starts where the previous one ends extends its entry.
+ *  `clear` keeps the capacity, so a writer reused between messages
+ *  stops allocating once it has held the largest one.
+ *
+ *  \warning The viewed data must outlive the write.
+ */
+class gather_writer
+{
+protected:
+    std::vector<struct iovec> iov_;
+    size_t bytes_ = 0;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    gather_writer() = default;
+    explicit gather_writer(size_t capacity);
+
+    // CAPACITY
+    size_t size() const noexcept;
+    size_t bytes() const noexcept;
+    bool empty() const noexcept;
+    size_t capacity() const noexcept;
+    void reserve(size_t capacity);
+
+    // ELEMENT ACCESS
+    const struct iovec * data() const noexcept;
+
+    // MODIFIERS
+    gather_writer & append(const void *data,
+        size_t length);
+    gather_writer & append(const string &str);
+    gather_writer & append(const vector<char> &vec);
+    gather_writer & append(const segmented_string &str);
+    gather_writer & operator<<(const string &str);
+    gather_writer & operator<<(const vector<char> &vec);
+    gather_writer & operator<<(const segmented_string &str);
+    void clear() noexcept;
+
+    // OUTPUT
+    size_t write(int fd) const;
+    size_t flush(int fd);
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+namespace detail
+{
+// HELPERS
+// -------
+
+#if defined(IOV_MAX)
+static const size_t iov_max = IOV_MAX;
+#else
+static const size_t iov_max = 1024;
+#endif
+
+
+inline void gather_error(int error)
+{
+    throw std::system_error(error, std::generic_category(), "gather_writer::write().");
+}
+
+}   /* detail */
+
+
+inline gather_writer::gather_writer(size_t capacity)
+{
+    iov_.reserve(capacity);
+}
+
+
+/** \brief Number of `iovec` entries.
+ */
+inline size_t gather_writer::size() const noexcept
+{
+    return iov_.size();
+}
+
+
+/** \brief Total bytes to write.
+ */
+inline size_t gather_writer::bytes() const noexcept
+{
+    return bytes_;
+}
+
+
+inline bool gather_writer::empty() const noexcept
+{
+    return bytes_ == 0;
+}
+
+
+inline size_t gather_writer::capacity() const noexcept
+{
+    return iov_.capacity();
+}
+
+
+inline void gather_writer::reserve(size_t capacity)
+{
+    iov_.reserve(capacity);
+}
+
+
+inline const struct iovec * gather_writer::data() const noexcept
+{
+    return iov_.data();
+}
+
+
+inline gather_writer & gather_writer::append(const void *data,
+    size_t length)
+{
+    if (length == 0) {
+        return *this;
+    }
+
+    char *first = static_cast<char*>(const_cast<void*>(data));
+    if (!iov_.empty() && static_cast<char*>(iov_.back().iov_base) + iov_.back().iov_len == first) {
+        iov_.back().iov_len += length;
+    } else {
+        struct iovec entry;
+        entry.iov_base = first;
+        entry.iov_len = length;
+        iov_.push_back(entry);
+    }
+    bytes_ += length;
+    return *this;
+}
+
+
+inline gather_writer & gather_writer::append(const string &str)
+{
+    return append(str.data(), str.size());
+}
+
+
+inline gather_writer & gather_writer::append(const vector<char> &vec)
+{
+    return append(vec.data(), vec.size());
+}
+
+
+inline gather_writer & gather_writer::append(const segmented_string &str)
+{
+    for (const string &segment: str.segments()) {
+        append(segment);
+    }
+    return *this;
+}
+
+
+inline gather_writer & gather_writer::operator<<(const string &str)
+{
+    return append(str);
+}
+
+
+inline gather_writer & gather_writer::operator<<(const vector<char> &vec)
+{
+    return append(vec);
+}
+
+
+inline gather_writer & gather_writer::operator<<(const segmented_string &str)
+{
+    return append(str);
+}
+
+
+/** \brief Remove every view, keeping the capacity.
+ */
+inline void gather_writer::clear() noexcept
+{
+    iov_.clear();
+    bytes_ = 0;
+}
+
+
+/** \brief Write every view to `fd`, returning the bytes written.
+ *
+ *  Entries are submitted `IOV_MAX` at a time. After a short write, the
+ *  rest of a partially written entry is sent with `write`, and `writev`
+ *  resumes at the next entry, so the entries are never modified.
+ *  Interrupted calls are retried, and other errors throw
+ *  `std::system_error`.
+ */
+inline size_t gather_writer::write(int fd) const
+{
+    size_t index = 0;
+    size_t offset = 0;
+    while (index < iov_.size()) {
+        ssize_t written;
+        if (offset) {
+            const char *first = static_cast<const char*>(iov_[index].iov_base) + offset;
+            written = ::write(fd, first, iov_[index].iov_len - offset);
+        } else {
+            const size_t count = std::min(iov_.size() - index, detail::iov_max);
+            written = ::writev(fd, iov_.data() + index, static_cast<int>(count));
+        }
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            detail::gather_error(errno);
+        }
+
+        size_t remaining = static_cast<size_t>(written);
+        while (remaining && remaining >= iov_[index].iov_len - offset) {
+            remaining -= iov_[index].iov_len - offset;
+            offset = 0;
+            ++index;
+        }
+        offset += remaining;
+    }
+    return bytes_;
+}
+
+
+/** \brief Write every view to `fd`, then clear the writer for reuse.
+ */
+inline size_t gather_writer::flush(int fd)
+{
+    size_t written = write(fd);
+    clear();
+    return written;
+}
+
+}   /* wtl */
+
+#endif
@@ -0,0 +1,489 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/dispatch.hpp>
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+uint64_t hash_bytes(const void *data,
+    size_t length,
+    uint64_t seed = 0) noexcept;
+
+
+/** \brief Transparent hash for narrow strings, views and C-strings.
+ *
+ *  Hashes the bytes alone, so a `wtl::string` and a `std::string` with
+ *  the same contents hash equally, allowing heterogeneous lookup.
+ */
+struct string_hash
+{
+    typedef void is_transparent;
+
+    size_t operator()(const string &str) const noexcept;
+    size_t operator()(const std::string &str) const noexcept;
+    size_t operator()(const char *str) const noexcept;
+};
+
+
+/** \brief Transparent equality for narrow strings, views and C-strings.
+ */
+struct string_equal
+{
+    typedef void is_transparent;
+
+    template <typename Left, typename Right>
+    bool operator()(const Left &left,
+        const Right &right) const noexcept;
+};
+
+
+namespace detail
+{
+// CONSTANTS
+// ---------
+
+static const uint64_t hash_secret[16] = {
+    0x2CB0F69F4ABEA221, 0x9417034723148989, 0xDD555950609DFE03, 0xDBAFB150DEB12800,
+    0x7E789B2E6C442CB6, 0xF41E5636C7E4F8C4, 0x0959D150F8FBA7E4, 0xA97316F13CDB9EEA,
+    0x74CD8258F9520068, 0x55C74A62E116868B, 0xD2F4C799A2023CBD, 0xDF98CB79A37B51B9,
+    0x396F5885524F3905, 0xAF1D56386CA3B276, 0xA9FFBE6B5104E85A, 0x6BD0C51B9FD533B3,
+};
+
+static const uint64_t hash_prime32_1 = 0x9E3779B1;
+static const uint64_t hash_prime64_1 = 0x9E3779B185EBCA87;
+
+/** \brief Inputs above this length use the striped accumulator.
+ */
+static const size_t hash_short_limit = 256;
+
+// PRIMITIVES
+// ----------
+
+
+inline uint64_t read64(const char *p) noexcept
+{
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+
+inline uint64_t read32(const char *p) noexcept
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+
+/** \brief Full 64x64 -> 128-bit multiply, in place as (low, high).
+ */
+inline void mum(uint64_t &a,
+    uint64_t &b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<uint64_t>(r);
+    b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32, la = a & 0xFFFFFFFF, lb = b & 0xFFFFFFFF;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+
+/** \brief Fold the 128-bit product of `a` and `b` to 64 bits.
+ */
+inline uint64_t mix(uint64_t a,
+    uint64_t b) noexcept
+{
+    mum(a, b);
+    return a ^ b;
+}
+
+// SHORT INPUTS
+// ------------
+
+
+/** \brief wyhash-style hash for inputs of at most `hash_short_limit` bytes.
+ */
+inline uint64_t hash_short(const char *p,
+    size_t length,
+    uint64_t seed) noexcept
+{
+    const uint64_t *s = hash_secret;
+    seed ^= mix(seed ^ s[0], s[1]);
+
+    uint64_t a, b;
+    if (length <= 16) {
+        if (length >= 4) {
+            const size_t shift = (length >> 3) << 2;
+            a = (read32(p) << 32) | read32(p + shift);
+            b = (read32(p + length - 4) << 32) | read32(p + length - 4 - shift);
+        } else if (length > 0) {
+            a = (uint64_t(uint8_t(p[0])) << 16) | (uint64_t(uint8_t(p[length >> 1])) << 8) | uint8_t(p[length - 1]);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = length;
+        if (i > 48) {
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+            do {
+                seed = mix(read64(p) ^ s[1], read64(p + 8) ^ seed);
+                see1 = mix(read64(p + 16) ^ s[2], read64(p + 24) ^ see1);
+                see2 = mix(read64(p + 32) ^ s[3], read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mix(read64(p) ^ s[1], read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+
+    a ^= s[1];
+    b ^= seed;
+    mum(a, b);
+    return mix(a ^ s[0] ^ length, b ^ s[1]);
+}
+
+// LONG INPUTS
+// -----------
+
+// Striped accumulator in the style of XXH3: eight 64-bit lanes each
+// absorb one word per 64-byte stripe through a 32x32->64 multiply of
+// the keyed word's halves, plus the neighbouring lane's raw word, and
+// are scrambled every 512 bytes. Every kernel computes identical
+// lanes, so hashes do not depend on the active `isa`.
+
+typedef void (*hash_accumulate_kernel)(uint64_t *, const char *, size_t, const uint64_t *);
+typedef void (*hash_scramble_kernel)(uint64_t *, const uint64_t *);
+
+
+/** \brief Absorb `stripes` stripes, keying stripe `s` from `key + s`.
+ */
+inline void hash_accumulate_scalar(uint64_t *acc,
+    const char *p,
+    size_t stripes,
+    const uint64_t *key) noexcept
+{
+    for (size_t s = 0; s < stripes; ++s, p += 64) {
+        for (size_t i = 0; i < 8; ++i) {
+            uint64_t value = read64(p + 8 * i);
+            uint64_t keyed = value ^ key[s + i];
+            acc[i ^ 1] += value;
+            acc[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+        }
+    }
+}
+
+
+inline void hash_scramble_scalar(uint64_t *acc,
+    const uint64_t *key) noexcept
+{
+    for (size_t i = 0; i < 8; ++i) {
+        acc[i] ^= acc[i] >> 47;
+        acc[i] ^= key[i];
+        acc[i] *= hash_prime32_1;
+    }
+}
+
+#if defined(WTL_X86)
+
+WTL_TARGET_SSE2
+inline void hash_accumulate_sse2(uint64_t *acc,
+    const char *p,
+    size_t stripes,
+    const uint64_t *key) noexcept
+{
+    __m128i lanes[4];
+    for (size_t j = 0; j < 4; ++j) {
+        lanes[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2 * j));
+    }
+    for (size_t s = 0; s < stripes; ++s, p += 64) {
+        for (size_t j = 0; j < 4; ++j) {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * j));
+            __m128i keyed = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + s + 2 * j)));
+            __m128i product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+            __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[j] = _mm_add_epi64(lanes[j], _mm_add_epi64(product, swapped));
+        }
+    }
+    for (size_t j = 0; j < 4; ++j) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2 * j), lanes[j]);
+    }
+}
+
+
+WTL_TARGET_SSE2
+inline void hash_scramble_sse2(uint64_t *acc,
+    const uint64_t *key) noexcept
+{
+    const __m128i prime = _mm_set1_epi32(static_cast<int>(hash_prime32_1));
+    for (size_t j = 0; j < 4; ++j) {
+        __m128i lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2 * j));
+        lane = _mm_xor_si128(lane, _mm_srli_epi64(lane, 47));
+        lane = _mm_xor_si128(lane, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + 2 * j)));
+        __m128i low = _mm_mul_epu32(lane, prime);
+        __m128i high = _mm_mul_epu32(_mm_srli_epi64(lane, 32), prime);
+        lane = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2 * j), lane);
+    }
+}
+
+
+WTL_TARGET_AVX2
+inline void hash_accumulate_avx2(uint64_t *acc,
+    const char *p,
+    size_t stripes,
+    const uint64_t *key) noexcept
+{
+    __m256i lanes[2];
+    for (size_t j = 0; j < 2; ++j) {
+        lanes[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4 * j));
+    }
+    for (size_t s = 0; s < stripes; ++s, p += 64) {
+        for (size_t j = 0; j < 2; ++j) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * j));
+            __m256i keyed = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + s + 4 * j)));
+            __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+            __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[j] = _mm256_add_epi64(lanes[j], _mm256_add_epi64(product, swapped));
+        }
+    }
+    for (size_t j = 0; j < 2; ++j) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4 * j), lanes[j]);
+    }
+}
+
+
+WTL_TARGET_AVX2
+inline void hash_scramble_avx2(uint64_t *acc,
+    const uint64_t *key) noexcept
+{
+    const __m256i prime = _mm256_set1_epi32(static_cast<int>(hash_prime32_1));
+    for (size_t j = 0; j < 2; ++j) {
+        __m256i lane = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4 * j));
+        lane = _mm256_xor_si256(lane, _mm256_srli_epi64(lane, 47));
+        lane = _mm256_xor_si256(lane, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + 4 * j)));
+        __m256i low = _mm256_mul_epu32(lane, prime);
+        __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(lane, 32), prime);
+        lane = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4 * j), lane);
+    }
+}
+
+#endif
+
+/** \brief Hash inputs longer than `hash_short_limit` bytes.
+ */
+template <
+    hash_accumulate_kernel Accumulate,
+    hash_scramble_kernel Scramble
+>
+uint64_t hash_long(const char *p,
+    size_t length,
+    uint64_t seed) noexcept
+{
+    uint64_t key[16];
+    for (size_t i = 0; i < 16; ++i) {
+        key[i] = (i & 1) ? hash_secret[i] - seed : hash_secret[i] + seed;
+    }
+    uint64_t acc[8] = {
+        0x00000000C2B2AE3D, 0x9E3779B185EBCA87, 0xC2B2AE3D27D4EB4F, 0x165667B19E3779F9,
+        0x85EBCA77C2B2AE63, 0x0000000085EBCA77, 0x27D4EB2F165667C5, 0x000000009E3779B1,
+    };
+
+    // keep the final stripe out of the blocks, so it is always absorbed last
+    const size_t blocks = (length - 1) / 512;
+    for (size_t b = 0; b < blocks; ++b) {
+        Accumulate(acc, p + 512 * b, 8, key);
+        Scramble(acc, key + 8);
+    }
+    const size_t rest = length - 512 * blocks;
+    Accumulate(acc, p + 512 * blocks, (rest - 1) / 64, key);
+    Accumulate(acc, p + length - 64, 1, key + 7);
+
+    uint64_t h = length * hash_prime64_1;
+    for (size_t i = 0; i < 4; ++i) {
+        h += mix(acc[2 * i] ^ key[8 + 2 * i], acc[2 * i + 1] ^ key[9 + 2 * i]);
+    }
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9;
+    return h ^ (h >> 32);
+}
+
+
+/** \brief Combine an element hash into a running hash.
+ */
+inline uint64_t hash_combine(uint64_t seed,
+    uint64_t value) noexcept
+{
+    return mix(seed ^ value, hash_secret[0]);
+}
+
+
+template <typename T>
+size_t hash_elements(const T *first,
+    size_t length,
+    std::true_type) noexcept
+{
+    return static_cast<size_t>(hash_bytes(first, length * sizeof(T)));
+}
+
+
+template <typename T>
+size_t hash_elements(const T *first,
+    size_t length,
+    std::false_type)
+{
+    uint64_t seed = hash_secret[1] ^ length;
+    std::hash<T> hasher;
+    for (size_t i = 0; i < length; ++i) {
+        seed = hash_combine(seed, hasher(first[i]));
+    }
+    return static_cast<size_t>(seed);
+}
+
+
+/** \brief Whether equal values of `T` always have equal bytes.
+ */
+template <typename T>
+struct is_bytewise_hashable: std::integral_constant<bool,
+    std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value>
+{};
+
+}   /* detail */
+
+
+// IMPLEMENTATION
+// --------------
+
+
+/** \brief 64-bit non-cryptographic hash of `length` bytes.
+ *
+ *  Short inputs use a wyhash-style multiply-fold. Longer inputs use an
+ *  XXH3-style striped accumulator, vectorized for the active `isa`.
+ *  Values are stable within a build and across instruction sets, but
+ *  are not a portable serialization format.
+ */
+inline uint64_t hash_bytes(const void *data,
+    size_t length,
+    uint64_t seed) noexcept
+{
+    using namespace detail;
+
+    const char *p = static_cast<const char*>(data);
+    if (length <= hash_short_limit) {
+        return hash_short(p, length, seed);
+    }
+
+    typedef uint64_t (*kernel)(const char *, size_t, uint64_t);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &hash_long<&hash_accumulate_scalar, &hash_scramble_scalar>,
+        &hash_long<&hash_accumulate_sse2, &hash_scramble_sse2>,
+        &hash_long<&hash_accumulate_sse2, &hash_scramble_sse2>,
+        &hash_long<&hash_accumulate_avx2, &hash_scramble_avx2>,
+        &hash_long<&hash_accumulate_avx2, &hash_scramble_avx2>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &hash_long<&hash_accumulate_scalar, &hash_scramble_scalar>,
+        &hash_long<&hash_accumulate_scalar, &hash_scramble_scalar>,
+        &hash_long<&hash_accumulate_scalar, &hash_scramble_scalar>,
+        &hash_long<&hash_accumulate_scalar, &hash_scramble_scalar>,
+        &hash_long<&hash_accumulate_scalar, &hash_scramble_scalar>,
+    };
+#endif
+    return dispatch(table)(p, length, seed);
+}
+
+
+inline size_t string_hash::operator()(const string &str) const noexcept
+{
+    return static_cast<size_t>(hash_bytes(str.data(), str.size()));
+}
+
+
+inline size_t string_hash::operator()(const std::string &str) const noexcept
+{
+    return static_cast<size_t>(hash_bytes(str.data(), str.size()));
+}
+
+
+inline size_t string_hash::operator()(const char *str) const noexcept
+{
+    return static_cast<size_t>(hash_bytes(str, strlen(str)));
+}
+
+
+template <typename Left, typename Right>
+bool string_equal::operator()(const Left &left,
+    const Right &right) const noexcept
+{
+    return string(left) == string(right);
+}
+
+}   /* wtl */
+
+
+namespace std
+{
+// SPECIALIZATION
+// --------------
+
+
+template <typename Char, typename Traits>
+struct hash<wtl::basic_string<Char, Traits>>
+{
+    size_t operator()(const wtl::basic_string<Char, Traits> &str) const noexcept
+    {
+        return static_cast<size_t>(wtl::hash_bytes(str.data(), str.size() * sizeof(Char)));
+    }
+};
+
+
+/** \brief Hash the bytes of integral, enum and pointer elements, and
+ *  combine `std::hash` of each element otherwise.
+ */
+template <typename T>
+struct hash<wtl::vector<T>>
+{
+    size_t operator()(const wtl::vector<T> &vector) const
+    {
+        return wtl::detail::hash_elements(vector.data(), vector.size(), wtl::detail::is_bytewise_hashable<T>());
+    }
+};
+
+}   /* std */
@@ -0,0 +1,195 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/arena.hpp>
+#include <wtl/flat_string_map.hpp>
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Memory held by an `interner`.
+ */
+struct interner_stats
+{
+    size_t strings;
+    size_t blocks;
+    size_t reserved;
+    size_t used;
+    size_t index_capacity;
+};
+
+
+/** \brief Table of unique strings with stable views and dense IDs.
+ *
+ *  The first occurrence of each string is copied, null-terminated, into
+ *  an arena, and assigned the next 32-bit ID. Later occurrences find the
+ *  copy through a `flat_string_map` keyed by the arena's views, so
+ *  interning a repeated token neither allocates nor copies.
+ *
+ *  Returned views remain valid until `reset` or destruction.
+ */
+class interner
+{
+protected:
+    arena arena_;
+    flat_string_map<uint32_t> index_;
+    std::vector<string> strings_;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    interner() = default;
+    interner(const interner &other) = delete;
+    interner & operator=(const interner &other) = delete;
+    interner(interner &&other) = default;
+    interner & operator=(interner &&other) = default;
+
+    explicit interner(size_t block_size);
+
+    // INTERNING
+    uint32_t id(const string &str);
+    string intern(const string &str);
+    std::vector<uint32_t> intern(const vector<string> &strings);
+
+    // LOOKUP
+    bool find(const string &str,
+        uint32_t &id) const noexcept;
+    bool contains(const string &str) const noexcept;
+    const string & operator[](uint32_t id) const noexcept;
+    const string & at(uint32_t id) const;
+
+    // CAPACITY
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+    interner_stats stats() const noexcept;
+
+    // MODIFIERS
+    void reset() noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+inline interner::interner(size_t block_size):
+    arena_(block_size)
+{}
+
+
+/** \brief Intern `str`, returning its ID.
+ */
+inline uint32_t interner::id(const string &str)
+{
+    auto found = index_.find(str);
+    if (found != index_.end()) {
+        return found->second;
+    }
+    if (strings_.size() >= UINT32_MAX) {
+        throw std::length_error("interner::id().");
+    }
+
+    string copy = arena_.copy(str);
+    uint32_t next = static_cast<uint32_t>(strings_.size());
+    strings_.push_back(copy);
+    index_.emplace(copy, next);
+    return next;
+}
+
+
+/** \brief Intern `str`, returning the stable view of its copy.
+ */
+inline string interner::intern(const string &str)
+{
+    return strings_[id(str)];
+}
+
+
+/** \brief Intern each string, returning their IDs in order.
+ */
+inline std::vector<uint32_t> interner::intern(const vector<string> &strings)
+{
+    std::vector<uint32_t> ids;
+    ids.reserve(strings.size());
+    for (const string &str: strings) {
+        ids.push_back(id(str));
+    }
+    return ids;
+}
+
+
+inline bool interner::find(const string &str,
+    uint32_t &id) const noexcept
+{
+    auto found = index_.find(str);
+    if (found == index_.end()) {
+        return false;
+    }
+    id = found->second;
+    return true;
+}
+
+
+inline bool interner::contains(const string &str) const noexcept
+{
+    return index_.contains(str);
+}
+
+
+inline const string & interner::operator[](uint32_t id) const noexcept
+{
+    return strings_[id];
+}
+
+
+inline const string & interner::at(uint32_t id) const
+{
+    if (id >= strings_.size()) {
+        throw std::out_of_range("interner::at().");
+    }
+    return strings_[id];
+}
+
+
+inline size_t interner::size() const noexcept
+{
+    return strings_.size();
+}
+
+
+inline bool interner::empty() const noexcept
+{
+    return strings_.empty();
+}
+
+
+inline interner_stats interner::stats() const noexcept
+{
+    return interner_stats {strings_.size(), arena_.blocks(), arena_.reserved(), arena_.used(), index_.capacity()};
+}
+
+
+/** \brief Forget every string in constant time, invalidating all views and IDs.
+ *
+ *  The arena is rewound and keeps its blocks for refilling, while the
+ *  index is swapped for an empty table allocated on the next insert.
+ */
+inline void interner::reset() noexcept
+{
+    arena_.rewind();
+    flat_string_map<uint32_t>().swap(index_);
+    strings_.clear();
+}
+
+}   /* wtl */
@@ -0,0 +1,476 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/dispatch.hpp>
+#include <wtl/string.hpp>
+#include <wtl/detail/search.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Lazy range of the lines of a string.
+ *
+ *  Lines end at each `'\n'`, found as by `find(char)`, and a trailing
+ *  `'\r'` is removed from lines ending in CRLF. A final line without a
+ *  newline is still yielded, but a trailing newline does not start an
+ *  empty line, so `"a\nb"` and `"a\nb\n"` both have 2 lines.
+ */
+template <
+    typename Char,
+    typename Traits
+>
+class basic_line_range
+{
+protected:
+    basic_string<Char, Traits> str_;
+
+public:
+    class iterator;
+    typedef iterator const_iterator;
+    typedef basic_string<Char, Traits> value_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    basic_line_range(const basic_string<Char, Traits> &str);
+
+    // ITERATORS
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+};
+
+
+/** \brief Forward iterator over the lines of a string.
+ */
+template <typename C, typename T>
+class basic_line_range<C, T>::iterator
+{
+protected:
+    basic_string<C, T> line_;
+    const C *next_ = nullptr;
+    const C *last_ = nullptr;
+    bool end_ = true;
+
+    void advance() noexcept;
+
+    friend class basic_line_range<C, T>;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef basic_string<C, T> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+
+    iterator() = default;
+
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+    iterator & operator++() noexcept;
+    iterator operator++(int) noexcept;
+
+    bool operator==(const iterator &other) const noexcept;
+    bool operator!=(const iterator &other) const noexcept;
+};
+
+
+/** \brief Random-access index of the lines of a string.
+ *
+ *  Records the offset of every line start, with the same line rules
+ *  as `lines`. Newlines are counted with SIMD in a first pass, which
+ *  sizes the index exactly, and recorded in a second. Both passes split
+ *  the string into one shard per thread, and each shard writes its
+ *  offsets at its position in the prefix sum of the counts, so the
+ *  index is built without locks or merging.
+ *
+ *  \warning The string must outlive the index.
+ */
+class line_index
+{
+protected:
+    string str_;
+    std::vector<size_t> starts_;
+
+public:
+    // MEMBER VARIABLES
+    // ----------------
+    static const size_t min_shard = 1 << 20;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    line_index();
+    explicit line_index(const string &str,
+        size_t threads = 1);
+
+    // CAPACITY
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    // ELEMENT ACCESS
+    string operator[](size_t line) const noexcept;
+    string at(size_t line) const;
+    const string & str() const noexcept;
+
+    // OFFSETS
+    size_t offset(size_t line) const noexcept;
+    size_t line_of(size_t offset) const noexcept;
+    std::pair<size_t, size_t> shard(size_t index,
+        size_t count) const noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+namespace detail
+{
+// RECORDING
+// ---------
+
+
+/** \brief Write `base + i` for each index `i` of `c`, returning the count.
+ */
+inline size_t record_char(const char *first,
+    size_t length,
+    char c,
+    size_t base,
+    size_t *out) noexcept
+{
+    size_t count = 0;
+    const char *last = first + length;
+    for (const char *it = first; (it = find_char(it, last - it, c)); ++it) {
+        out[count++] = base + (it - first);
+    }
+    return count;
+}
+
+#if defined(WTL_X86)
+
+WTL_TARGET_SSE2
+inline size_t record_char_sse2(const char *first,
+    size_t length,
+    char c,
+    size_t base,
+    size_t *out) noexcept
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t count = 0;
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16) {
+        __m128i eq = _mm_cmpeq_epi8(needle, _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + offset)));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        while (mask) {
+            out[count++] = base + offset + ctz32(mask);
+            mask &= mask - 1;
+        }
+    }
+    return count + record_char(first + offset, length - offset, c, base + offset, out + count);
+}
+
+
+WTL_TARGET_AVX2
+inline size_t record_char_avx2(const char *first,
+    size_t length,
+    char c,
+    size_t base,
+    size_t *out) noexcept
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t count = 0;
+    size_t offset = 0;
+    for (; offset + 32 <= length; offset += 32) {
+        __m256i eq = _mm256_cmpeq_epi8(needle, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + offset)));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        while (mask) {
+            out[count++] = base + offset + ctz32(mask);
+            mask &= mask - 1;
+        }
+    }
+    return count + record_char_sse2(first + offset, length - offset, c, base + offset, out + count);
+}
+
+#endif
+
+inline size_t record_char_dispatch(const char *first,
+    size_t length,
+    char c,
+    size_t base,
+    size_t *out) noexcept
+{
+    typedef size_t (*kernel)(const char *, size_t, char, size_t, size_t *);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &record_char, &record_char_sse2, &record_char_sse2, &record_char_avx2, &record_char_avx2,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &record_char, &record_char, &record_char, &record_char, &record_char,
+    };
+#endif
+    return dispatch(table)(first, length, c, base, out);
+}
+
+
+/** \brief Run `function(i)` for each shard, the first on this thread.
+ */
+template <typename Function>
+void for_each_shard(size_t shards,
+    Function function)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(shards - 1);
+    for (size_t i = 1; i < shards; ++i) {
+        threads.emplace_back(function, i);
+    }
+    function(0);
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+}
+
+
+/** \brief Remove the `'\r'` of a CRLF line ending at `last`.
+ */
+template <typename Char, typename Traits>
+basic_string<Char, Traits> strip_cr(const Char *first,
+    const Char *last)
+{
+    if (last != first && last[-1] == Char('\r')) {
+        --last;
+    }
+    return basic_string<Char, Traits>(first, last - first);
+}
+
+}   /* detail */
+
+
+template <typename C, typename T>
+basic_line_range<C, T>::basic_line_range(const basic_string<C, T> &str):
+    str_(str)
+{}
+
+
+template <typename C, typename T>
+auto basic_line_range<C, T>::begin() const noexcept
+    -> iterator
+{
+    iterator it;
+    it.next_ = str_.data();
+    it.last_ = str_.data() + str_.size();
+    it.end_ = false;
+    it.advance();
+    return it;
+}
+
+
+template <typename C, typename T>
+auto basic_line_range<C, T>::end() const noexcept
+    -> iterator
+{
+    return iterator();
+}
+
+
+template <typename C, typename T>
+void basic_line_range<C, T>::iterator::advance() noexcept
+{
+    if (next_ == last_) {
+        end_ = true;
+        line_ = basic_string<C, T>();
+        return;
+    }
+
+    const C *first = next_;
+    const C *found = detail::find_char(first, last_ - first, C('\n'));
+    if (found) {
+        line_ = detail::strip_cr<C, T>(first, found);
+        next_ = found + 1;
+    } else {
+        line_ = basic_string<C, T>(first, last_ - first);
+        next_ = last_;
+    }
+}
+
+
+template <typename C, typename T>
+auto basic_line_range<C, T>::iterator::operator*() const noexcept
+    -> reference
+{
+    return line_;
+}
+
+
+template <typename C, typename T>
+auto basic_line_range<C, T>::iterator::operator->() const noexcept
+    -> pointer
+{
+    return &line_;
+}
+
+
+template <typename C, typename T>
+auto basic_line_range<C, T>::iterator::operator++() noexcept
+    -> iterator &
+{
+    advance();
+    return *this;
+}
+
+
+template <typename C, typename T>
+auto basic_line_range<C, T>::iterator::operator++(int) noexcept
+    -> iterator
+{
+    iterator copy(*this);
+    advance();
+    return copy;
+}
+
+
+template <typename C, typename T>
+bool basic_line_range<C, T>::iterator::operator==(const iterator &other) const noexcept
+{
+    if (end_ || other.end_) {
+        return end_ == other.end_;
+    }
+    return next_ == other.next_;
+}
+
+
+template <typename C, typename T>
+bool basic_line_range<C, T>::iterator::operator!=(const iterator &other) const noexcept
+{
+    return !(*this == other);
+}
+
+
+/** \brief Lazy range of the lines of `str`.
+ */
+template <typename Char, typename Traits>
+basic_line_range<Char, Traits> lines(const basic_string<Char, Traits> &str)
+{
+    return basic_line_range<Char, Traits>(str);
+}
+
+
+inline line_index::line_index():
+    starts_(1, 0)
+{}
+
+
+/** \brief Index `str`, using up to `threads` threads.
+ *
+ *  Shards are at least `min_shard` bytes, so small strings are indexed
+ *  on the calling thread. `starts_` holds the start of every line, then
+ *  the start of the line past the end, which for a missing final
+ *  newline is placed after a virtual newline at `str.size()`.
+ */
+inline line_index::line_index(const string &str,
+        size_t threads):
+    str_(str)
+{
+    const size_t length = str.size();
+    const size_t shards = std::max<size_t>(1, std::min(threads, length / min_shard));
+    std::vector<size_t> bounds(shards + 1);
+    for (size_t i = 0; i <= shards; ++i) {
+        bounds[i] = length / shards * i + std::min(i, length % shards);
+    }
+
+    std::vector<size_t> counts(shards + 1, 0);
+    detail::for_each_shard(shards, [&](size_t i) {
+        counts[i + 1] = detail::count_char(str.data() + bounds[i], bounds[i + 1] - bounds[i], '\n');
+    });
+    for (size_t i = 0; i < shards; ++i) {
+        counts[i + 1] += counts[i];
+    }
+
+    const bool unterminated = length && str.back() != '\n';
+    starts_.resize(1 + counts[shards] + unterminated);
+    starts_[0] = 0;
+    detail::for_each_shard(shards, [&](size_t i) {
+        detail::record_char_dispatch(str.data() + bounds[i], bounds[i + 1] - bounds[i], '\n', bounds[i] + 1, starts_.data() + 1 + counts[i]);
+    });
+    if (unterminated) {
+        starts_.back() = length + 1;
+    }
+}
+
+
+inline size_t line_index::size() const noexcept
+{
+    return starts_.size() - 1;
+}
+
+
+inline bool line_index::empty() const noexcept
+{
+    return size() == 0;
+}
+
+
+inline string line_index::operator[](size_t line) const noexcept
+{
+    const char *first = str_.data() + starts_[line];
+    const size_t end = starts_[line + 1] - 1;
+    if (end == str_.size()) {
+        return string(first, str_.data() + end - first);
+    }
+    return detail::strip_cr<char, std::char_traits<char>>(first, str_.data() + end);
+}
+
+
+inline string line_index::at(size_t line) const
+{
+    if (line >= size()) {
+        throw std::out_of_range("line_index::at().");
+    }
+    return operator[](line);
+}
+
+
+inline const string & line_index::str() const noexcept
+{
+    return str_;
+}
+
+
+/** \brief Byte offset of the start of `line`.
+ */
+inline size_t line_index::offset(size_t line) const noexcept
+{
+    return starts_[line];
+}
+
+
+/** \brief Line containing the byte at `offset`, newlines included.
+ */
+inline size_t line_index::line_of(size_t offset) const noexcept
+{
+    return std::upper_bound(starts_.begin(), starts_.end() - 1, offset) - starts_.begin() - 1;
+}
+
+
+/** \brief Lines `[first, last)` of shard `index`, out of `count` even shards.
+ */
+inline std::pair<size_t, size_t> line_index::shard(size_t index,
+    size_t count) const noexcept
+{
+    const size_t lines = size();
+    return std::make_pair(lines / count * index + std::min(index, lines % count),
+        lines / count * (index + 1) + std::min(index + 1, lines % count));
+}
+
+}   /* wtl */
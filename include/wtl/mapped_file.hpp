@@ -0,0 +1,344 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+#include <wtl/detail/posix.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(WTL_POSIX)
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Access requested for a file mapping.
+ *
+ *  `private_write` mappings are writable copy-on-write, so edits are
+ *  never written back to the file.
+ */
+enum class map_mode
+{
+    read_only,
+    private_write,
+};
+
+
+/** \brief Expected access pattern, passed to the kernel as `madvise`.
+ */
+enum class map_advice
+{
+    normal,
+    sequential,
+    random,
+    willneed,
+    hugepage,
+};
+
+
+/** \brief RAII memory map of an entire file.
+ *
+ *  The contents are exposed as views, so a file is processed in place
+ *  without copying or allocating. Views are invalidated when the file
+ *  is closed, moved from, or destroyed.
+ */
+class mapped_file
+{
+protected:
+    void *address_ = nullptr;
+    size_t size_ = 0;
+    map_mode mode_ = map_mode::read_only;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    mapped_file() = default;
+    mapped_file(const mapped_file &other) = delete;
+    mapped_file & operator=(const mapped_file &other) = delete;
+    mapped_file(mapped_file &&other) noexcept;
+    mapped_file & operator=(mapped_file &&other) noexcept;
+    ~mapped_file();
+
+    explicit mapped_file(const char *path,
+        map_mode mode = map_mode::read_only);
+    explicit mapped_file(const std::string &path,
+        map_mode mode = map_mode::read_only);
+
+    void close() noexcept;
+
+    // CAPACITY
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+    bool is_open() const noexcept;
+    map_mode mode() const noexcept;
+
+    // ELEMENT ACCESS
+    const char * data() const noexcept;
+    char * mutable_data();
+
+    // CONVERSIONS
+    string str() const noexcept;
+    template <typename T>
+    vector<T> as_vector() const;
+    template <typename T>
+    vector<T> as_vector(size_t offset,
+        size_t count) const;
+
+    // HINTS
+    bool advise(map_advice advice) const noexcept;
+    bool advise(map_advice advice,
+        size_t offset,
+        size_t length) const noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+namespace detail
+{
+// HELPERS
+// -------
+
+
+/** \brief Open `path` and get its size, throwing `std::system_error`.
+ */
+inline int open_file(const char *path,
+    int flags,
+    size_t &size,
+    const char *what)
+{
+    int fd = ::open(path, flags);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), what);
+    }
+    size = static_cast<size_t>(st.st_size);
+    return fd;
+}
+
+
+inline int map_advice_flag(map_advice advice) noexcept
+{
+    switch (advice) {
+        case map_advice::sequential:
+            return MADV_SEQUENTIAL;
+        case map_advice::random:
+            return MADV_RANDOM;
+        case map_advice::willneed:
+            return MADV_WILLNEED;
+        case map_advice::hugepage:
+#if defined(MADV_HUGEPAGE)
+            return MADV_HUGEPAGE;
+#else
+            return -1;
+#endif
+        default:
+            return MADV_NORMAL;
+    }
+}
+
+}   /* detail */
+
+
+inline mapped_file::mapped_file(mapped_file &&other) noexcept:
+    address_(other.address_),
+    size_(other.size_),
+    mode_(other.mode_)
+{
+    other.address_ = nullptr;
+    other.size_ = 0;
+}
+
+
+inline mapped_file & mapped_file::operator=(mapped_file &&other) noexcept
+{
+    if (this != &other) {
+        close();
+        std::swap(address_, other.address_);
+        std::swap(size_, other.size_);
+        std::swap(mode_, other.mode_);
+    }
+    return *this;
+}
+
+
+inline mapped_file::~mapped_file()
+{
+    close();
+}
+
+
+/** \brief Map all of `path`, which is opened read-only in either mode.
+ *
+ *  An empty file has no mapping, and yields empty views.
+ */
+inline mapped_file::mapped_file(const char *path,
+        map_mode mode):
+    mode_(mode)
+{
+    size_t size;
+    int fd = detail::open_file(path, O_RDONLY, size, "mapped_file::mapped_file().");
+    if (size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    int protection = mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    void *address = ::mmap(nullptr, size, protection, MAP_PRIVATE, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), "mapped_file::mapped_file().");
+    }
+    address_ = address;
+    size_ = size;
+}
+
+
+inline mapped_file::mapped_file(const std::string &path,
+        map_mode mode):
+    mapped_file(path.data(), mode)
+{}
+
+
+inline void mapped_file::close() noexcept
+{
+    if (address_) {
+        ::munmap(address_, size_);
+        address_ = nullptr;
+        size_ = 0;
+    }
+}
+
+
+inline size_t mapped_file::size() const noexcept
+{
+    return size_;
+}
+
+
+inline bool mapped_file::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+inline bool mapped_file::is_open() const noexcept
+{
+    return address_ != nullptr;
+}
+
+
+inline map_mode mapped_file::mode() const noexcept
+{
+    return mode_;
+}
+
+
+inline const char * mapped_file::data() const noexcept
+{
+    return static_cast<const char*>(address_);
+}
+
+
+/** \brief Writable contents, which requires `map_mode::private_write`.
+ */
+inline char * mapped_file::mutable_data()
+{
+    if (mode_ != map_mode::private_write) {
+        throw std::logic_error("mapped_file::mutable_data().");
+    }
+    return static_cast<char*>(address_);
+}
+
+
+inline string mapped_file::str() const noexcept
+{
+    return string(data(), size());
+}
+
+
+/** \brief View the whole file as an array of `T`.
+ *
+ *  Throws `std::invalid_argument` if the size is not a multiple of
+ *  `sizeof(T)`.
+ */
+template <typename T>
+vector<T> mapped_file::as_vector() const
+{
+    if (size_ % sizeof(T) != 0) {
+        throw std::invalid_argument("mapped_file::as_vector().");
+    }
+    return as_vector<T>(0, size_ / sizeof(T));
+}
+
+
+/** \brief View `count` elements of `T` starting `offset` bytes in.
+ *
+ *  Throws `std::out_of_range` if the elements extend past the end,
+ *  and `std::invalid_argument` if `offset` misaligns `T`.
+ */
+template <typename T>
+vector<T> mapped_file::as_vector(size_t offset,
+    size_t count) const
+{
+    if (offset > size_ || count > (size_ - offset) / sizeof(T)) {
+        throw std::out_of_range("mapped_file::as_vector().");
+    }
+    const char *first = data() + offset;
+    if (reinterpret_cast<uintptr_t>(first) % alignof(T) != 0) {
+        throw std::invalid_argument("mapped_file::as_vector().");
+    }
+    return vector<T>(reinterpret_cast<const T*>(first), count);
+}
+
+
+/** \brief Hint the access pattern for the whole file.
+ */
+inline bool mapped_file::advise(map_advice advice) const noexcept
+{
+    return advise(advice, 0, size_);
+}
+
+
+/** \brief Hint the access pattern for `length` bytes from `offset`.
+ *
+ *  The range is widened to page boundaries. Returns false if the
+ *  kernel rejects or does not support the hint, which is harmless.
+ */
+inline bool mapped_file::advise(map_advice advice,
+    size_t offset,
+    size_t length) const noexcept
+{
+    int flag = detail::map_advice_flag(advice);
+    if (!address_ || flag < 0 || offset >= size_) {
+        return false;
+    }
+
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t start = offset / page * page;
+    length = std::min(length, size_ - offset) + (offset - start);
+    return ::madvise(static_cast<char*>(address_) + start, length, flag) == 0;
+}
+
+}   /* wtl */
+
+#endif
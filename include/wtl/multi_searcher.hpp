@@ -0,0 +1,317 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/string.hpp>
+
+#include <deque>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Aho-Corasick matcher for many narrow needles in one pass.
+ *
+ *  Compiles the needles into a dense DFA. Bytes that occur in no needle
+ *  share one equivalence class, so each state holds one transition per
+ *  distinct needle byte rather than 256. Transitions store the
+ *  premultiplied row offset of the target state, with the top bit set
+ *  when the target reports matches, so a scan step is one table load.
+ *
+ *  The matcher copies what it needs from the needles, which may be
+ *  released after construction. Empty needles never match.
+ */
+class multi_searcher
+{
+public:
+    // MEMBER TYPES
+    // ------------
+
+    /** \brief Match of needle `pattern` starting at `offset`.
+     */
+    struct match
+    {
+        size_t pattern;
+        size_t offset;
+    };
+
+protected:
+    enum : uint32_t
+    {
+        output_flag = 0x80000000,
+        missing = 0xFFFFFFFF,
+    };
+
+    uint8_t classes_[256] = {};
+    uint32_t alphabet_ = 1;
+    std::vector<uint32_t> table_;
+    std::vector<uint32_t> output_offsets_;
+    std::vector<uint32_t> outputs_;
+    std::vector<size_t> lengths_;
+
+    template <typename Iter>
+    void build(Iter first,
+        Iter last);
+
+    template <typename Callback>
+    bool scan(const string &haystack,
+        uint32_t &state,
+        size_t base,
+        Callback &&callback) const;
+
+    friend class multi_stream_searcher;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    multi_searcher();
+    multi_searcher(std::initializer_list<string> needles);
+
+    template <typename Iter>
+    multi_searcher(Iter first,
+        Iter last);
+
+    template <typename Range>
+    explicit multi_searcher(const Range &needles);
+
+    // PROPERTIES
+    size_t size() const noexcept;
+    size_t states() const noexcept;
+
+    // SEARCH
+    template <typename Callback>
+    void find_all(const string &haystack,
+        Callback &&callback) const;
+    std::vector<match> find_all(const string &haystack) const;
+    bool find_first(const string &haystack,
+        match &result) const;
+    bool contains(const string &haystack) const;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+inline multi_searcher::multi_searcher():
+    multi_searcher(std::initializer_list<string>())
+{}
+
+
+inline multi_searcher::multi_searcher(std::initializer_list<string> needles)
+{
+    build(needles.begin(), needles.end());
+}
+
+
+template <typename Iter>
+multi_searcher::multi_searcher(Iter first,
+    Iter last)
+{
+    build(first, last);
+}
+
+
+template <typename Range>
+multi_searcher::multi_searcher(const Range &needles)
+{
+    build(needles.begin(), needles.end());
+}
+
+
+/** \brief Build the trie, then complete it into a DFA breadth-first.
+ */
+template <typename Iter>
+void multi_searcher::build(Iter first,
+    Iter last)
+{
+    // byte classes: one per byte used in a needle, plus one for the rest
+    std::vector<string> needles;
+    bool used[256] = {};
+    for (; first != last; ++first) {
+        string needle(*first);
+        needles.push_back(needle);
+        for (char c: needle) {
+            used[static_cast<uint8_t>(c)] = true;
+        }
+    }
+    size_t distinct = static_cast<size_t>(std::count(used, used + 256, true));
+    alphabet_ = distinct == 256 ? 256 : 1;
+    for (size_t byte = 0; byte < 256; ++byte) {
+        if (distinct == 256) {
+            classes_[byte] = static_cast<uint8_t>(byte);
+        } else if (used[byte]) {
+            classes_[byte] = static_cast<uint8_t>(alphabet_++);
+        }
+    }
+
+    // trie, with missing edges marked and states as row numbers
+    std::vector<std::vector<uint32_t>> own(1);
+    table_.assign(alphabet_, missing);
+    for (size_t id = 0; id < needles.size(); ++id) {
+        const string &needle = needles[id];
+        lengths_.push_back(needle.size());
+        if (needle.empty()) {
+            continue;
+        }
+
+        uint32_t state = 0;
+        for (char c: needle) {
+            uint32_t &edge = table_[state * alphabet_ + classes_[static_cast<uint8_t>(c)]];
+            if (edge == missing) {
+                if (table_.size() + alphabet_ >= output_flag) {
+                    throw std::length_error("multi_searcher::multi_searcher().");
+                }
+                edge = static_cast<uint32_t>(own.size());
+                own.emplace_back();
+                table_.resize(table_.size() + alphabet_, missing);
+            }
+            state = table_[state * alphabet_ + classes_[static_cast<uint8_t>(c)]];
+        }
+        own[state].push_back(static_cast<uint32_t>(id));
+    }
+
+    // failure links: missing edges borrow the failure state's edge,
+    // and each state inherits the outputs of its failure state
+    const size_t count = own.size();
+    std::vector<uint32_t> fail(count, 0);
+    std::vector<std::vector<uint32_t>> outputs(count);
+    std::deque<uint32_t> queue;
+    for (uint32_t c = 0; c < alphabet_; ++c) {
+        uint32_t &edge = table_[c];
+        if (edge == missing) {
+            edge = 0;
+        } else {
+            queue.push_back(edge);
+        }
+    }
+    outputs[0] = own[0];
+    while (!queue.empty()) {
+        uint32_t state = queue.front();
+        queue.pop_front();
+        outputs[state] = own[state];
+        outputs[state].insert(outputs[state].end(), outputs[fail[state]].begin(), outputs[fail[state]].end());
+
+        for (uint32_t c = 0; c < alphabet_; ++c) {
+            uint32_t &edge = table_[state * alphabet_ + c];
+            uint32_t fallback = table_[fail[state] * alphabet_ + c];
+            if (edge == missing) {
+                edge = fallback;
+            } else {
+                fail[edge] = fallback;
+                queue.push_back(edge);
+            }
+        }
+    }
+
+    // premultiply targets and flag those with outputs
+    output_offsets_.assign(1, 0);
+    for (size_t state = 0; state < count; ++state) {
+        outputs_.insert(outputs_.end(), outputs[state].begin(), outputs[state].end());
+        output_offsets_.push_back(static_cast<uint32_t>(outputs_.size()));
+    }
+    for (uint32_t &edge: table_) {
+        uint32_t flag = outputs[edge].empty() ? 0 : static_cast<uint32_t>(output_flag);
+        edge = (edge * alphabet_) | flag;
+    }
+}
+
+
+/** \brief Run the DFA from `state`, stopping early once `callback` returns false.
+ *
+ *  Match offsets are relative to `base` bytes before `haystack`, and
+ *  `state` is left where the scan ends, so a scan may resume in the
+ *  next chunk of a stream.
+ *
+ *  \return         Whether the scan was stopped early.
+ */
+template <typename Callback>
+bool multi_searcher::scan(const string &haystack,
+    uint32_t &state,
+    size_t base,
+    Callback &&callback) const
+{
+    const uint32_t *table = table_.data();
+    const uint8_t *first = reinterpret_cast<const uint8_t*>(haystack.data());
+    const size_t length = haystack.size();
+    for (size_t i = 0; i < length; ++i) {
+        uint32_t next = table[state + classes_[first[i]]];
+        state = next & ~output_flag;
+        if (next & output_flag) {
+            size_t row = state / alphabet_;
+            for (uint32_t j = output_offsets_[row]; j < output_offsets_[row + 1]; ++j) {
+                size_t id = outputs_[j];
+                if (!callback(match {id, base + i + 1 - lengths_[id]})) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+
+inline size_t multi_searcher::size() const noexcept
+{
+    return lengths_.size();
+}
+
+
+inline size_t multi_searcher::states() const noexcept
+{
+    return table_.size() / alphabet_;
+}
+
+
+/** \brief Call `callback(match)` for every match, in order of match end.
+ */
+template <typename Callback>
+void multi_searcher::find_all(const string &haystack,
+    Callback &&callback) const
+{
+    uint32_t state = 0;
+    scan(haystack, state, 0, [&callback](const match &m) {
+        callback(m);
+        return true;
+    });
+}
+
+
+inline auto multi_searcher::find_all(const string &haystack) const
+    -> std::vector<match>
+{
+    std::vector<match> matches;
+    find_all(haystack, [&matches](const match &m) {
+        matches.push_back(m);
+    });
+    return matches;
+}
+
+
+/** \brief Find the match that ends first, stopping the scan there.
+ */
+inline bool multi_searcher::find_first(const string &haystack,
+    match &result) const
+{
+    uint32_t state = 0;
+    return scan(haystack, state, 0, [&result](const match &m) {
+        result = m;
+        return false;
+    });
+}
+
+
+inline bool multi_searcher::contains(const string &haystack) const
+{
+    match result;
+    return find_first(haystack, result);
+}
+
+}   /* wtl */
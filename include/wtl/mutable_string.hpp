@@ -0,0 +1,372 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/string.hpp>
+#include <wtl/detail/inplace.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Mutable STL string wrapper.
+ *
+ *  Binds a mutable pointer and the string length, for algorithms that
+ *  modify characters in place. Converts implicitly, and for free, to
+ *  the read-only `basic_string`.
+ *
+ *  \warning The lifetime of the source data must outlive the wrapper.
+ */
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>
+>
+class basic_mutable_string
+{
+protected:
+    Char *data_ = nullptr;
+    size_t length_ = 0;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Char value_type;
+    typedef Traits traits_type;
+    typedef Char& reference;
+    typedef const Char& const_reference;
+    typedef Char* pointer;
+    typedef const Char* const_pointer;
+    typedef std::ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef pointer iterator;
+    typedef const_pointer const_iterator;
+    typedef std::reverse_iterator<pointer> reverse_iterator;
+    typedef std::reverse_iterator<const_pointer> const_reverse_iterator;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    basic_mutable_string() = default;
+    basic_mutable_string(std::basic_string<Char, Traits> &str);
+    basic_mutable_string(Char *str,
+        size_t n);
+    basic_mutable_string(Char *begin,
+        Char *end);
+
+    // ITERATORS
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+    reverse_iterator rbegin() const noexcept;
+    reverse_iterator rend() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // CAPACITY
+    size_t size() const noexcept;
+    size_t length() const noexcept;
+    bool empty() const noexcept;
+
+    // ELEMENT ACCESS
+    reference operator[](size_type pos) const noexcept;
+    reference at(size_type pos) const;
+    reference front() const noexcept;
+    reference back() const noexcept;
+    pointer data() const noexcept;
+
+    // ALGORITHMS
+    void fill(Char c) const noexcept;
+    template <typename UnaryOperation>
+    void transform(UnaryOperation operation) const;
+    void reverse() const noexcept;
+    void sort() const;
+    void to_lower() const noexcept;
+    void to_upper() const noexcept;
+
+    // MODIFIERS
+    void swap(basic_mutable_string<Char, Traits> &other) noexcept;
+
+    // CONVERSIONS
+    basic_string<Char, Traits> str() const noexcept;
+    operator basic_string<Char, Traits>() const noexcept;
+    explicit operator bool() const noexcept;
+    explicit operator std::basic_string<Char, Traits>() const;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename C, typename T>
+void swap(basic_mutable_string<C, T> &left,
+    basic_mutable_string<C, T> &right) noexcept
+{
+    left.swap(right);
+}
+
+
+/** \brief Read exactly `str.size()` characters into `str`.
+ */
+template <typename C, typename T>
+std::basic_istream<C, T> & operator>>(std::basic_istream<C, T> &stream,
+    const basic_mutable_string<C, T> &str)
+{
+    return stream.read(str.data(), str.size());
+}
+
+
+template <typename C, typename T>
+std::basic_ostream<C, T> & operator<<(std::basic_ostream<C, T> &stream,
+    const basic_mutable_string<C, T> &str)
+{
+    return stream.write(str.data(), str.size());
+}
+
+
+template <typename C, typename T>
+basic_mutable_string<C, T>::basic_mutable_string(std::basic_string<C, T> &str):
+    data_(&str[0]),
+    length_(str.size())
+{}
+
+
+template <typename C, typename T>
+basic_mutable_string<C, T>::basic_mutable_string(C *str,
+        size_t n):
+    data_(str),
+    length_(n)
+{}
+
+
+template <typename C, typename T>
+basic_mutable_string<C, T>::basic_mutable_string(C *begin,
+        C *end):
+    data_(begin),
+    length_(end - begin)
+{}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::begin() const noexcept
+    -> iterator
+{
+    return data_;
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::end() const noexcept
+    -> iterator
+{
+    return data_ + length_;
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::rbegin() const noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(end());
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::rend() const noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(begin());
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename C, typename T>
+size_t basic_mutable_string<C, T>::size() const noexcept
+{
+    return length_;
+}
+
+
+template <typename C, typename T>
+size_t basic_mutable_string<C, T>::length() const noexcept
+{
+    return length_;
+}
+
+
+template <typename C, typename T>
+bool basic_mutable_string<C, T>::empty() const noexcept
+{
+    return length_ == 0;
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::operator[](size_type pos) const noexcept
+    -> reference
+{
+    assert(pos <= size() && "mutable_string index out of bounds");
+    return data_[pos];
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::at(size_type pos) const
+    -> reference
+{
+    if (pos >= size()) {
+        throw std::out_of_range("basic_mutable_string::at().");
+    }
+    return data_[pos];
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::front() const noexcept
+    -> reference
+{
+    assert(!empty() && "mutable_string::front(): string is empty");
+    return *data_;
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::back() const noexcept
+    -> reference
+{
+    assert(!empty() && "mutable_string::back(): string is empty");
+    return data_[length_ - 1];
+}
+
+
+template <typename C, typename T>
+auto basic_mutable_string<C, T>::data() const noexcept
+    -> pointer
+{
+    return data_;
+}
+
+
+template <typename C, typename T>
+void basic_mutable_string<C, T>::fill(C c) const noexcept
+{
+    traits_type::assign(data_, length_, c);
+}
+
+
+/** \brief Replace each character `c` with `operation(c)`.
+ */
+template <typename C, typename T>
+template <typename UnaryOperation>
+void basic_mutable_string<C, T>::transform(UnaryOperation operation) const
+{
+    std::transform(begin(), end(), begin(), operation);
+}
+
+
+template <typename C, typename T>
+void basic_mutable_string<C, T>::reverse() const noexcept
+{
+    std::reverse(begin(), end());
+}
+
+
+template <typename C, typename T>
+void basic_mutable_string<C, T>::sort() const
+{
+    std::sort(begin(), end(), [](C left, C right) {
+        return traits_type::lt(left, right);
+    });
+}
+
+
+/** \brief Lowercase ASCII letters, with SIMD for narrow strings.
+ *
+ *  Other characters, including non-ASCII letters, are unchanged, so
+ *  the result is independent of the locale.
+ */
+template <typename C, typename T>
+void basic_mutable_string<C, T>::to_lower() const noexcept
+{
+    detail::ascii_case(data_, length_, 'A');
+}
+
+
+/** \brief Uppercase ASCII letters, with SIMD for narrow strings.
+ */
+template <typename C, typename T>
+void basic_mutable_string<C, T>::to_upper() const noexcept
+{
+    detail::ascii_case(data_, length_, 'a');
+}
+
+
+template <typename C, typename T>
+void basic_mutable_string<C, T>::swap(basic_mutable_string<C, T> &other) noexcept
+{
+    std::swap(data_, other.data_);
+    std::swap(length_, other.length_);
+}
+
+
+template <typename C, typename T>
+basic_string<C, T> basic_mutable_string<C, T>::str() const noexcept
+{
+    return basic_string<C, T>(data_, length_);
+}
+
+
+template <typename C, typename T>
+basic_mutable_string<C, T>::operator basic_string<C, T>() const noexcept
+{
+    return str();
+}
+
+
+template <typename C, typename T>
+basic_mutable_string<C, T>::operator bool() const noexcept
+{
+    return !empty();
+}
+
+
+template <typename C, typename T>
+basic_mutable_string<C, T>::operator std::basic_string<C, T>() const
+{
+    return std::basic_string<C, T>(data_, length_);
+}
+
+// TYPES
+// -----
+
+typedef basic_mutable_string<char> mutable_string;
+typedef basic_mutable_string<wchar_t> mutable_wstring;
+typedef basic_mutable_string<char16_t> mutable_u16string;
+typedef basic_mutable_string<char32_t> mutable_u32string;
+
+}   /* wtl */
@@ -0,0 +1,324 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/vector.hpp>
+#include <wtl/detail/inplace.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Mutable STL vector wrapper.
+ *
+ *  Binds a mutable pointer and the vector length, for algorithms that
+ *  modify elements in place. Converts implicitly, and for free, to the
+ *  read-only `vector<T>`.
+ *
+ *  \warning The lifetime of the source data must outlive the wrapper.
+ */
+template <typename T>
+class mutable_vector
+{
+protected:
+    T *data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef T value_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef std::ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef pointer iterator;
+    typedef const_pointer const_iterator;
+    typedef std::reverse_iterator<pointer> reverse_iterator;
+    typedef std::reverse_iterator<const_pointer> const_reverse_iterator;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    mutable_vector() = default;
+    mutable_vector(std::vector<T> &vector);
+    mutable_vector(T *t,
+        size_type n);
+    mutable_vector(T *first,
+        T *last);
+
+    // ITERATORS
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+    reverse_iterator rbegin() const noexcept;
+    reverse_iterator rend() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // CAPACITY
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    // ELEMENT ACCESS
+    reference operator[](size_type pos) const noexcept;
+    reference at(size_type pos) const;
+    reference front() const noexcept;
+    reference back() const noexcept;
+    pointer data() const noexcept;
+
+    // ALGORITHMS
+    void fill(const T &value) const;
+    template <typename UnaryOperation>
+    void transform(UnaryOperation operation) const;
+    void reverse() const;
+    void sort() const;
+    template <typename Compare>
+    void sort(Compare compare) const;
+    void byteswap() const noexcept;
+
+    // MODIFIERS
+    void swap(mutable_vector<T> &other) noexcept;
+
+    // CONVERSIONS
+    operator vector<T>() const noexcept;
+    explicit operator bool() const noexcept;
+    explicit operator std::vector<T>() const;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T>
+void swap(mutable_vector<T> &left,
+    mutable_vector<T> &right) noexcept
+{
+    left.swap(right);
+}
+
+
+template <typename T>
+mutable_vector<T>::mutable_vector(std::vector<T> &vector):
+    data_(vector.data()),
+    size_(vector.size())
+{}
+
+
+template <typename T>
+mutable_vector<T>::mutable_vector(T *t,
+        size_type n):
+    data_(t),
+    size_(n)
+{}
+
+
+template <typename T>
+mutable_vector<T>::mutable_vector(T *first,
+        T *last):
+    data_(first),
+    size_(last - first)
+{}
+
+
+template <typename T>
+auto mutable_vector<T>::begin() const noexcept
+    -> iterator
+{
+    return data_;
+}
+
+
+template <typename T>
+auto mutable_vector<T>::end() const noexcept
+    -> iterator
+{
+    return data_ + size_;
+}
+
+
+template <typename T>
+auto mutable_vector<T>::rbegin() const noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(end());
+}
+
+
+template <typename T>
+auto mutable_vector<T>::rend() const noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(begin());
+}
+
+
+template <typename T>
+auto mutable_vector<T>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename T>
+auto mutable_vector<T>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename T>
+size_t mutable_vector<T>::size() const noexcept
+{
+    return size_;
+}
+
+
+template <typename T>
+bool mutable_vector<T>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename T>
+auto mutable_vector<T>::operator[](size_type pos) const noexcept
+    -> reference
+{
+    assert(pos <= size() && "mutable_vector index out of bounds");
+    return data_[pos];
+}
+
+
+template <typename T>
+auto mutable_vector<T>::at(size_type pos) const
+    -> reference
+{
+    if (pos >= size()) {
+        throw std::out_of_range("mutable_vector::at().");
+    }
+    return data_[pos];
+}
+
+
+template <typename T>
+auto mutable_vector<T>::front() const noexcept
+    -> reference
+{
+    assert(!empty() && "mutable_vector::front(): vector is empty");
+    return *data_;
+}
+
+
+template <typename T>
+auto mutable_vector<T>::back() const noexcept
+    -> reference
+{
+    assert(!empty() && "mutable_vector::back(): vector is empty");
+    return data_[size_ - 1];
+}
+
+
+template <typename T>
+auto mutable_vector<T>::data() const noexcept
+    -> pointer
+{
+    return data_;
+}
+
+
+template <typename T>
+void mutable_vector<T>::fill(const T &value) const
+{
+    std::fill(begin(), end(), value);
+}
+
+
+/** \brief Replace each element `x` with `operation(x)`.
+ */
+template <typename T>
+template <typename UnaryOperation>
+void mutable_vector<T>::transform(UnaryOperation operation) const
+{
+    std::transform(begin(), end(), begin(), operation);
+}
+
+
+template <typename T>
+void mutable_vector<T>::reverse() const
+{
+    std::reverse(begin(), end());
+}
+
+
+template <typename T>
+void mutable_vector<T>::sort() const
+{
+    std::sort(begin(), end());
+}
+
+
+template <typename T>
+template <typename Compare>
+void mutable_vector<T>::sort(Compare compare) const
+{
+    std::sort(begin(), end(), compare);
+}
+
+
+/** \brief Reverse the byte order of each element, with SIMD shuffles.
+ *
+ *  Requires arithmetic elements of 2, 4 or 8 bytes.
+ */
+template <typename T>
+void mutable_vector<T>::byteswap() const noexcept
+{
+    static_assert(std::is_arithmetic<T>::value && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8),
+        "mutable_vector::byteswap() requires 2, 4 or 8-byte arithmetic elements.");
+    detail::byteswap<sizeof(T)>(reinterpret_cast<char*>(data_), size_);
+}
+
+
+template <typename T>
+void mutable_vector<T>::swap(mutable_vector<T> &other) noexcept
+{
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+}
+
+
+template <typename T>
+mutable_vector<T>::operator vector<T>() const noexcept
+{
+    return vector<T>(data_, size_);
+}
+
+
+template <typename T>
+mutable_vector<T>::operator bool() const noexcept
+{
+    return !empty();
+}
+
+
+template <typename T>
+mutable_vector<T>::operator std::vector<T>() const
+{
+    return std::vector<T>(begin(), end());
+}
+
+}   /* wtl */
@@ -0,0 +1,576 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/mapped_file.hpp>
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <system_error>
+#include <vector>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Allocator reserving zeroed slack past every allocation.
+ *
+ *  Each block is 64-byte aligned and followed by `Padding` readable,
+ *  zeroed bytes. Since a container's size never exceeds its capacity,
+ *  `std::vector<T, padded_allocator<T>>` guarantees the slack past
+ *  `size()`, and may back a `padded_string` or `padded_vector`.
+ */
+template <
+    typename T,
+    size_t Padding = simd_padding
+>
+class padded_allocator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef padded_allocator<U, Padding> other;
+    };
+
+    // MEMBER VARIABLES
+    // ----------------
+    static const size_t padding = Padding;
+    static const size_t alignment = 64;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    padded_allocator() = default;
+
+    template <typename U>
+    padded_allocator(const padded_allocator<U, Padding> &other) noexcept;
+
+    T * allocate(size_t n);
+    void deallocate(T *p,
+        size_t n) noexcept;
+};
+
+
+/** \brief String wrapper guaranteeing `simd_padding` readable bytes past the end.
+ *
+ *  Searches select kernels that load whole blocks across the end of
+ *  the data and mask the result, rather than finishing with scalar
+ *  code. Every substring of a padded string is itself padded.
+ *
+ *  \warning The lifetime of the source data must outlive the wrapper.
+ */
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>
+>
+class basic_padded_string: public basic_string<Char, Traits>
+{
+protected:
+    typedef basic_string<Char, Traits> base;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef typename base::size_type size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    basic_padded_string() = default;
+    basic_padded_string(const basic_padded_string<Char, Traits> &str) = default;
+    basic_padded_string<Char, Traits> & operator=(const basic_padded_string<Char, Traits> &str) = default;
+
+    basic_padded_string(const Char *str,
+        size_t n,
+        assume_padded_t);
+
+    template <size_t Padding>
+    basic_padded_string(const std::vector<Char, padded_allocator<Char, Padding>> &str);
+
+    // STRING OPERATIONS
+    basic_padded_string<Char, Traits> substr(size_type pos = 0,
+        size_type len = base::npos) const;
+
+    // FIND
+    using base::find;
+    size_t find(const base &str,
+        size_t pos = 0) const noexcept;
+    size_t find(const std::string &str,
+        size_t pos = 0) const;
+    size_t find(const char *array,
+        size_t pos = 0) const;
+    size_t find(const char *cstring,
+        size_t pos,
+        size_t length) const;
+    size_t find(char c,
+        size_t pos = 0) const noexcept;
+
+    // RFIND
+    using base::rfind;
+    size_t rfind(const base &str,
+        size_t pos = 0) const noexcept;
+    size_t rfind(const std::string &str,
+        size_t pos = 0) const;
+    size_t rfind(const char *array,
+        size_t pos = 0) const;
+    size_t rfind(const char *cstring,
+        size_t pos,
+        size_t length) const;
+    size_t rfind(char c,
+        size_t pos = 0) const noexcept;
+
+    // CHARACTER SETS
+    using base::find_first_of;
+    using base::find_first_not_of;
+    using base::find_last_of;
+    using base::find_last_not_of;
+    size_t find_first_of(const byteset &set,
+        size_t pos = 0) const noexcept;
+    size_t find_first_not_of(const byteset &set,
+        size_t pos = 0) const noexcept;
+    size_t find_last_of(const byteset &set,
+        size_t pos = 0) const noexcept;
+    size_t find_last_not_of(const byteset &set,
+        size_t pos = 0) const noexcept;
+};
+
+
+/** \brief Vector wrapper guaranteeing `simd_padding` readable bytes past the end.
+ *
+ *  \warning The lifetime of the source data must outlive the wrapper.
+ */
+template <typename T>
+class padded_vector: public vector<T>
+{
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    padded_vector() = default;
+    padded_vector(const padded_vector<T> &vector) = default;
+    padded_vector<T> & operator=(const padded_vector<T> &vector) = default;
+
+    padded_vector(const T *t,
+        size_t n,
+        assume_padded_t);
+
+    template <size_t Padding>
+    padded_vector(const std::vector<T, padded_allocator<T, Padding>> &vector);
+};
+
+#if defined(WTL_POSIX)
+
+/** \brief Read-only file mapping followed by `simd_padding` zeroed bytes.
+ *
+ *  Reserves an anonymous mapping large enough for the file and its
+ *  slack, then maps the file over its start, so the bytes past the end
+ *  of the file are readable zeros rather than a fault.
+ */
+class padded_file
+{
+protected:
+    void *address_ = nullptr;
+    size_t size_ = 0;
+    size_t mapped_ = 0;
+
+    void close() noexcept;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    padded_file() = default;
+    padded_file(const padded_file &other) = delete;
+    padded_file & operator=(const padded_file &other) = delete;
+    padded_file(padded_file &&other) noexcept;
+    padded_file & operator=(padded_file &&other) noexcept;
+    ~padded_file();
+
+    explicit padded_file(const char *path);
+    explicit padded_file(const std::string &path);
+
+    // CAPACITY
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    // ELEMENT ACCESS
+    const char * data() const noexcept;
+
+    // CONVERSIONS
+    basic_padded_string<char> str() const noexcept;
+};
+
+#endif
+
+// IMPLEMENTATION
+// --------------
+
+template <typename T, size_t P>
+const size_t padded_allocator<T, P>::padding;
+
+template <typename T, size_t P>
+const size_t padded_allocator<T, P>::alignment;
+
+
+template <typename T, size_t P>
+template <typename U>
+padded_allocator<T, P>::padded_allocator(const padded_allocator<U, P> &) noexcept
+{}
+
+
+/** \brief Allocate aligned storage, storing the raw pointer just before it.
+ */
+template <typename T, size_t P>
+T * padded_allocator<T, P>::allocate(size_t n)
+{
+    const size_t limit = std::numeric_limits<size_t>::max() - P - 2 * alignment;
+    if (n > limit / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+
+    const size_t bytes = n * sizeof(T);
+    char *raw = static_cast<char*>(::operator new(bytes + P + alignment));
+    uintptr_t address = reinterpret_cast<uintptr_t>(raw) + alignment;
+    char *aligned = reinterpret_cast<char*>(address & ~uintptr_t(alignment - 1));
+    std::memcpy(aligned - sizeof(char*), &raw, sizeof(char*));
+    std::memset(aligned + bytes, 0, P);
+
+    return reinterpret_cast<T*>(aligned);
+}
+
+
+template <typename T, size_t P>
+void padded_allocator<T, P>::deallocate(T *p,
+    size_t) noexcept
+{
+    char *raw;
+    std::memcpy(&raw, reinterpret_cast<char*>(p) - sizeof(char*), sizeof(char*));
+    ::operator delete(raw);
+}
+
+
+template <typename T, typename U, size_t P>
+bool operator==(const padded_allocator<T, P> &,
+    const padded_allocator<U, P> &) noexcept
+{
+    return true;
+}
+
+
+template <typename T, typename U, size_t P>
+bool operator!=(const padded_allocator<T, P> &,
+    const padded_allocator<U, P> &) noexcept
+{
+    return false;
+}
+
+
+/** \brief Wrap data the caller guarantees is followed by `simd_padding` readable bytes.
+ */
+template <typename C, typename T>
+basic_padded_string<C, T>::basic_padded_string(const C *str,
+        size_t n,
+        assume_padded_t):
+    base(str, n)
+{}
+
+
+template <typename C, typename T>
+template <size_t Padding>
+basic_padded_string<C, T>::basic_padded_string(const std::vector<C, padded_allocator<C, Padding>> &str):
+    base(str.data(), str.size())
+{
+    static_assert(Padding >= simd_padding, "Allocator padding is narrower than simd_padding.");
+}
+
+
+template <typename C, typename T>
+auto basic_padded_string<C, T>::substr(size_type pos,
+    size_type len) const
+    -> basic_padded_string<C, T>
+{
+    base str(*this, pos, len);
+    return basic_padded_string<C, T>(str.data(), str.size(), assume_padded);
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::find(const base &str,
+    size_t pos) const noexcept
+{
+    if (pos > this->size()) {
+        return base::npos;
+    }
+    auto *found = detail::find(this->data()+pos, this->size()-pos, str.data(), str.size(), assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::find(const std::string &str,
+    size_t pos) const
+{
+    return find(str.data(), pos, str.size());
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::find(const char *array,
+    size_t pos) const
+{
+    return find(array, pos, strlen(array));
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::find(const char *array,
+    size_t pos,
+    size_t length) const
+{
+    if (pos > this->size()) {
+        return base::npos;
+    }
+    auto *found = detail::find(this->data()+pos, this->size()-pos, array, length, assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::find(char c,
+    size_t pos) const noexcept
+{
+    if (pos >= this->size()) {
+        return base::npos;
+    }
+    auto *found = detail::find_char(this->data()+pos, this->size()-pos, c, assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::rfind(const base &str,
+    size_t pos) const noexcept
+{
+    if (pos > this->size()) {
+        return base::npos;
+    }
+    auto *found = detail::rfind(this->data()+pos, this->size()-pos, str.data(), str.size(), assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::rfind(const std::string &str,
+    size_t pos) const
+{
+    return rfind(str.data(), pos, str.size());
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::rfind(const char *array,
+    size_t pos) const
+{
+    return rfind(array, pos, strlen(array));
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::rfind(const char *array,
+    size_t pos,
+    size_t length) const
+{
+    if (pos > this->size()) {
+        return base::npos;
+    }
+    auto *found = detail::rfind(this->data()+pos, this->size()-pos, array, length, assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::rfind(char c,
+    size_t pos) const noexcept
+{
+    if (pos >= this->size()) {
+        return base::npos;
+    }
+    auto *found = detail::rfind_char(this->data()+pos, this->size()-pos, c, assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::find_first_of(const byteset &set,
+    size_t pos) const noexcept
+{
+    if (pos > this->size()) {
+        return base::npos;
+    }
+    auto *found = set.find_first_of(this->data()+pos, this->size()-pos, assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::find_first_not_of(const byteset &set,
+    size_t pos) const noexcept
+{
+    if (pos > this->size()) {
+        return base::npos;
+    }
+    auto *found = set.find_first_not_of(this->data()+pos, this->size()-pos, assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::find_last_of(const byteset &set,
+    size_t pos) const noexcept
+{
+    if (pos > this->size()) {
+        return base::npos;
+    }
+    auto *found = set.find_last_of(this->data()+pos, this->size()-pos, assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_padded_string<C, T>::find_last_not_of(const byteset &set,
+    size_t pos) const noexcept
+{
+    if (pos > this->size()) {
+        return base::npos;
+    }
+    auto *found = set.find_last_not_of(this->data()+pos, this->size()-pos, assume_padded);
+    return found ? found - this->data() : base::npos;
+}
+
+
+/** \brief Wrap data the caller guarantees is followed by `simd_padding` readable bytes.
+ */
+template <typename T>
+padded_vector<T>::padded_vector(const T *t,
+        size_t n,
+        assume_padded_t):
+    vector<T>(t, n)
+{}
+
+
+template <typename T>
+template <size_t Padding>
+padded_vector<T>::padded_vector(const std::vector<T, padded_allocator<T, Padding>> &vector):
+    wtl::vector<T>(vector.data(), vector.size())
+{
+    static_assert(Padding >= simd_padding, "Allocator padding is narrower than simd_padding.");
+}
+
+#if defined(WTL_POSIX)
+
+inline padded_file::padded_file(padded_file &&other) noexcept:
+    address_(other.address_),
+    size_(other.size_),
+    mapped_(other.mapped_)
+{
+    other.address_ = nullptr;
+    other.size_ = other.mapped_ = 0;
+}
+
+
+inline padded_file & padded_file::operator=(padded_file &&other) noexcept
+{
+    if (this != &other) {
+        close();
+        std::swap(address_, other.address_);
+        std::swap(size_, other.size_);
+        std::swap(mapped_, other.mapped_);
+    }
+    return *this;
+}
+
+
+inline padded_file::~padded_file()
+{
+    close();
+}
+
+
+inline padded_file::padded_file(const char *path)
+{
+    int fd = detail::open_file(path, O_RDONLY, size_, "padded_file::padded_file().");
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    mapped_ = (size_ + simd_padding + page - 1) / page * page;
+    void *base = ::mmap(nullptr, mapped_, PROT_READ, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (base != MAP_FAILED && size_ && ::mmap(base, size_, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        ::munmap(base, mapped_);
+        base = MAP_FAILED;
+    }
+    int error = errno;
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), "padded_file::padded_file().");
+    }
+    address_ = base;
+}
+
+
+inline padded_file::padded_file(const std::string &path):
+    padded_file(path.data())
+{}
+
+
+inline void padded_file::close() noexcept
+{
+    if (address_) {
+        ::munmap(address_, mapped_);
+        address_ = nullptr;
+        size_ = mapped_ = 0;
+    }
+}
+
+
+inline size_t padded_file::size() const noexcept
+{
+    return size_;
+}
+
+
+inline bool padded_file::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+inline const char * padded_file::data() const noexcept
+{
+    return static_cast<const char*>(address_);
+}
+
+
+inline basic_padded_string<char> padded_file::str() const noexcept
+{
+    return basic_padded_string<char>(data(), size(), assume_padded);
+}
+
+#endif
+
+// TYPES
+// -----
+
+typedef basic_padded_string<char> padded_string;
+typedef basic_padded_string<wchar_t> padded_wstring;
+typedef basic_padded_string<char16_t> padded_u16string;
+typedef basic_padded_string<char32_t> padded_u32string;
+
+}   /* wtl */
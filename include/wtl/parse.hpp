@@ -0,0 +1,493 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/dispatch.hpp>
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+#include <wtl/detail/digits.hpp>
+#include <wtl/detail/float.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Reason a string could not be parsed.
+ */
+enum class parse_error
+{
+    none,
+    invalid_argument,
+    out_of_range,
+};
+
+
+/** \brief Parsed value, or the error and a value-initialized value.
+ */
+template <typename T>
+struct parse_result
+{
+    T value;
+    parse_error error;
+
+    explicit operator bool() const noexcept
+    {
+        return error == parse_error::none;
+    }
+};
+
+
+template <typename T>
+parse_result<T> parse(const string &str,
+    int base = 10) noexcept;
+
+template <typename T>
+size_t parse(const vector<string> &column,
+    T *out,
+    int base = 10) noexcept;
+
+
+// IMPLEMENTATION
+// --------------
+
+namespace detail
+{
+// INTEGERS
+// --------
+
+
+/** \brief Parse decimal digits into `value`, up to `max`.
+ *
+ *  After leading zeros, up to 19 digits always fit in 64 bits, so only
+ *  a 20th digit needs an overflow check. Runs of 16 and 8 digits are
+ *  converted together.
+ */
+template <typename Digits16>
+parse_error parse_decimal(const char *first,
+    size_t length,
+    uint64_t max,
+    uint64_t &value) noexcept
+{
+    while (length && *first == '0') {
+        ++first;
+        --length;
+    }
+
+    if (length > 20) {
+        for (size_t i = 0; i < length; ++i) {
+            if (static_cast<unsigned char>(first[i] - '0') > 9) {
+                return parse_error::invalid_argument;
+            }
+        }
+        return parse_error::out_of_range;
+    }
+
+    uint64_t result = 0;
+    size_t i = 0;
+    const size_t head = std::min<size_t>(length, 19);
+    if (head >= 16) {
+        if (!Digits16::convert(first, result)) {
+            return parse_error::invalid_argument;
+        }
+        i = 16;
+    }
+    if (i + 8 <= head) {
+        const uint64_t word = load_le64(first + i);
+        if (!is_eight_digits(word)) {
+            return parse_error::invalid_argument;
+        }
+        result = result * 100000000 + eight_digits(word);
+        i += 8;
+    }
+    for (; i < head; ++i) {
+        const unsigned digit = static_cast<unsigned char>(first[i] - '0');
+        if (digit > 9) {
+            return parse_error::invalid_argument;
+        }
+        result = result * 10 + digit;
+    }
+
+    if (length == 20) {
+        const unsigned digit = static_cast<unsigned char>(first[19] - '0');
+        if (digit > 9) {
+            return parse_error::invalid_argument;
+        } else if (result > (UINT64_MAX - digit) / 10) {
+            return parse_error::out_of_range;
+        }
+        result = result * 10 + digit;
+    }
+    if (result > max) {
+        return parse_error::out_of_range;
+    }
+    value = result;
+    return parse_error::none;
+}
+
+
+/** \brief Parse digits in `base`, case-insensitively, up to `max`.
+ */
+inline parse_error parse_radix(const char *first,
+    size_t length,
+    unsigned base,
+    uint64_t max,
+    uint64_t &value) noexcept
+{
+    uint64_t result = 0;
+    bool overflow = false;
+    for (size_t i = 0; i < length; ++i) {
+        const unsigned c = static_cast<unsigned char>(first[i]);
+        unsigned digit = 36;
+        if (c - '0' < 10) {
+            digit = c - '0';
+        } else if ((c | 0x20) - 'a' < 26) {
+            digit = (c | 0x20) - 'a' + 10;
+        }
+        if (digit >= base) {
+            return parse_error::invalid_argument;
+        } else if (overflow || result > (max - digit) / base) {
+            overflow = true;
+        } else {
+            result = result * base + digit;
+        }
+    }
+    if (overflow) {
+        return parse_error::out_of_range;
+    }
+    value = result;
+    return parse_error::none;
+}
+
+
+template <typename T, typename Digits16>
+parse_result<T> parse_integer(const char *first,
+    size_t length,
+    int base) noexcept
+{
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+        "wtl::parse() requires a non-bool integer type.");
+    assert(base >= 2 && base <= 36 && "wtl::parse(): base must be in [2, 36]");
+    typedef typename std::make_unsigned<T>::type unsigned_type;
+
+    const bool negative = length && *first == '-';
+    first += negative;
+    length -= negative;
+    if (!length || (negative && !std::is_signed<T>::value)) {
+        return parse_result<T> {T(), parse_error::invalid_argument};
+    }
+
+    // the magnitude of the minimum is one past the maximum
+    const uint64_t max = uint64_t(std::numeric_limits<T>::max()) + negative;
+    uint64_t magnitude = 0;
+    parse_error error;
+    if (base == 10) {
+        error = parse_decimal<Digits16>(first, length, max, magnitude);
+    } else {
+        error = parse_radix(first, length, static_cast<unsigned>(base), max, magnitude);
+    }
+    if (error != parse_error::none) {
+        return parse_result<T> {T(), error};
+    }
+
+    unsigned_type value = static_cast<unsigned_type>(magnitude);
+    if (negative) {
+        value = static_cast<unsigned_type>(0 - value);
+    }
+    return parse_result<T> {static_cast<T>(value), parse_error::none};
+}
+
+
+// FLOATS
+// ------
+
+
+/** \brief End of the run of ASCII digits at `first`.
+ */
+inline const char * skip_digits(const char *first,
+    const char *last) noexcept
+{
+    while (last - first >= 8 && is_eight_digits(load_le64(first))) {
+        first += 8;
+    }
+    while (first < last && static_cast<unsigned char>(*first - '0') <= 9) {
+        ++first;
+    }
+    return first;
+}
+
+
+/** \brief Append the digits in `[first, last)` to `w`, 8 at a time.
+ */
+inline void accumulate_digits(const char *first,
+    const char *last,
+    uint64_t &w) noexcept
+{
+    for (; last - first >= 8; first += 8) {
+        w = w * 100000000 + eight_digits(load_le64(first));
+    }
+    for (; first < last; ++first) {
+        w = w * 10 + static_cast<unsigned>(*first - '0');
+    }
+}
+
+
+inline bool equal_ignore_case(const char *first,
+    size_t length,
+    const char *lower) noexcept
+{
+    size_t i = 0;
+    for (; i < length && lower[i]; ++i) {
+        if ((first[i] | 0x20) != lower[i]) {
+            return false;
+        }
+    }
+    return i == length && !lower[i];
+}
+
+
+/** \brief Parse a decimal floating-point literal spanning `length` bytes.
+ *
+ *  Mantissas of up to 19 significant digits are exact in 64 bits, and
+ *  take Clinger's fast path when both they and the power of ten are
+ *  exact, or Eisel-Lemire otherwise. Longer mantissas are truncated,
+ *  and only when rounding the truncated and the next mantissa differ,
+ *  fall back to exact decimal conversion.
+ */
+template <typename T>
+parse_result<T> parse_float(const char *first,
+    size_t length) noexcept
+{
+    typedef binary_format<T> format;
+    const char *last = first + length;
+    const bool negative = first < last && *first == '-';
+    first += negative;
+
+    if (first < last && *first != '.' && static_cast<unsigned char>(*first - '0') > 9) {
+        const size_t size = static_cast<size_t>(last - first);
+        T value;
+        if (equal_ignore_case(first, size, "inf") || equal_ignore_case(first, size, "infinity")) {
+            value = std::numeric_limits<T>::infinity();
+        } else if (equal_ignore_case(first, size, "nan")) {
+            value = std::numeric_limits<T>::quiet_NaN();
+        } else {
+            return parse_result<T> {T(), parse_error::invalid_argument};
+        }
+        return parse_result<T> {negative ? -value : value, parse_error::none};
+    }
+
+    const char *integer = first;
+    const char *integer_end = skip_digits(first, last);
+    const char *fraction = integer_end;
+    const char *fraction_end = integer_end;
+    if (fraction_end < last && *fraction_end == '.') {
+        fraction = fraction_end + 1;
+        fraction_end = skip_digits(fraction, last);
+    }
+    if (integer == integer_end && fraction == fraction_end) {
+        return parse_result<T> {T(), parse_error::invalid_argument};
+    }
+
+    // saturate, since exponents this large give zero or infinity anyway
+    const char *p = fraction_end;
+    int64_t exponent = 0;
+    if (p < last && (*p | 0x20) == 'e') {
+        ++p;
+        const bool negative_exponent = p < last && *p == '-';
+        p += p < last && (*p == '-' || *p == '+');
+        const char *digits = p;
+        for (; p < last && static_cast<unsigned char>(*p - '0') <= 9; ++p) {
+            if (exponent < 0x10000000) {
+                exponent = exponent * 10 + (*p - '0');
+            }
+        }
+        if (p == digits) {
+            return parse_result<T> {T(), parse_error::invalid_argument};
+        }
+        exponent = negative_exponent ? -exponent : exponent;
+    }
+    if (p != last) {
+        return parse_result<T> {T(), parse_error::invalid_argument};
+    }
+
+    // take up to 19 significant digits
+    while (integer < integer_end && *integer == '0') {
+        ++integer;
+    }
+    const char *significant = fraction;
+    if (integer == integer_end) {
+        while (significant < fraction_end && *significant == '0') {
+            ++significant;
+        }
+    }
+    const int64_t leading_zeros = significant - fraction;
+    const size_t integer_digits = static_cast<size_t>(integer_end - integer);
+    const size_t fraction_digits = static_cast<size_t>(fraction_end - significant);
+    const size_t taken_integer = std::min<size_t>(integer_digits, 19);
+    const size_t taken_fraction = std::min<size_t>(fraction_digits, 19 - taken_integer);
+    const bool truncated = integer_digits + fraction_digits > 19;
+    uint64_t w = 0;
+    accumulate_digits(integer, integer + taken_integer, w);
+    accumulate_digits(significant, significant + taken_fraction, w);
+    const int64_t q = exponent + static_cast<int64_t>(integer_digits - taken_integer) - leading_zeros - static_cast<int64_t>(taken_fraction);
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    if (!truncated && q >= -format::max_exponent_fast_path && q <= format::max_exponent_fast_path
+        && w <= (uint64_t(2) << format::mantissa_bits)) {
+        T value = static_cast<T>(w);
+        value = q < 0 ? value / exact_pow10<T>(static_cast<int>(-q)) : value * exact_pow10<T>(static_cast<int>(q));
+        return parse_result<T> {negative ? -value : value, parse_error::none};
+    }
+#endif
+
+    adjusted_mantissa am = eisel_lemire<T>(q, w);
+    if (truncated) {
+        const adjusted_mantissa next = eisel_lemire<T>(q, w + 1);
+        if (am.mantissa != next.mantissa || am.power2 != next.power2) {
+            decimal d;
+            d.num_digits = 0;
+            d.truncated = false;
+            decimal_append(d, integer, integer_end);
+            decimal_append(d, significant, fraction_end);
+            decimal_trim(d);
+            const int64_t point = (integer_digits ? static_cast<int64_t>(integer_digits) : -leading_zeros) + exponent;
+            d.decimal_point = static_cast<int32_t>(std::max<int64_t>(-100000, std::min<int64_t>(point, 100000)));
+            am = decimal_to_binary<T>(d);
+        }
+    }
+    if (am.power2 == format::infinite_power) {
+        return parse_result<T> {T(), parse_error::out_of_range};
+    }
+    return parse_result<T> {to_float<T>(am, negative), parse_error::none};
+}
+
+
+template <typename T, typename Digits16>
+parse_result<T> parse_number(const char *first,
+    size_t length,
+    int base,
+    std::false_type) noexcept
+{
+    return parse_integer<T, Digits16>(first, length, base);
+}
+
+
+template <typename T, typename Digits16>
+parse_result<T> parse_number(const char *first,
+    size_t length,
+    int base,
+    std::true_type) noexcept
+{
+    assert(base == 10 && "wtl::parse(): floating-point values must be decimal");
+    (void) base;
+    return parse_float<T>(first, length);
+}
+
+
+template <typename T, typename Digits16>
+parse_result<T> parse_number(const char *first,
+    size_t length,
+    int base) noexcept
+{
+    return parse_number<T, Digits16>(first, length, base, std::is_floating_point<T>());
+}
+
+
+template <typename T, typename Digits16>
+size_t parse_column_impl(const string *first,
+    size_t length,
+    T *out,
+    int base) noexcept
+{
+    for (size_t i = 0; i < length; ++i) {
+        const parse_result<T> result = parse_number<T, Digits16>(first[i].data(), first[i].size(), base);
+        if (!result) {
+            return i;
+        }
+        out[i] = result.value;
+    }
+    return length;
+}
+
+
+template <typename T>
+size_t parse_column_scalar(const string *first,
+    size_t length,
+    T *out,
+    int base) noexcept
+{
+    return parse_column_impl<T, digits16_swar>(first, length, out, base);
+}
+
+#if defined(WTL_X86)
+
+template <typename T>
+WTL_TARGET_SSSE3
+size_t parse_column_ssse3(const string *first,
+    size_t length,
+    T *out,
+    int base) noexcept
+{
+    return parse_column_impl<T, digits16_ssse3>(first, length, out, base);
+}
+
+#endif
+
+}   /* detail */
+
+
+/** \brief Parse a number spanning all of `str`, without exceptions.
+ *
+ *  Integers accept an optional `'-'` for signed types, then digits in
+ *  `base`, from 2 to 36, with letters in either case. Decimal digits
+ *  are converted 8 and 16 at a time.
+ *
+ *  `float` and `double` accept an optional `'-'`, then decimal digits
+ *  with an optional `'.'` and exponent, or `inf`, `infinity` or `nan`
+ *  in any case, and are correctly rounded. Finite values too large
+ *  for `T` are out of range, and `base` must be 10.
+ *
+ *  Unlike `std::stoll` or `std::strtod`, none of these allocate, skip
+ *  whitespace, need a null terminator, or consult the locale.
+ */
+template <typename T>
+parse_result<T> parse(const string &str,
+    int base) noexcept
+{
+    return detail::parse_number<T, detail::digits16_swar>(str.data(), str.size(), base);
+}
+
+
+/** \brief Parse each field of `column` into `out`, stopping at an error.
+ *
+ *  Returns the index of the first field that fails, which `parse<T>`
+ *  can then explain, or `column.size()` if all succeed.
+ */
+template <typename T>
+size_t parse(const vector<string> &column,
+    T *out,
+    int base) noexcept
+{
+    typedef size_t (*kernel)(const string *, size_t, T *, int);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &detail::parse_column_scalar<T>, &detail::parse_column_scalar<T>, &detail::parse_column_ssse3<T>, &detail::parse_column_ssse3<T>, &detail::parse_column_ssse3<T>,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &detail::parse_column_scalar<T>, &detail::parse_column_scalar<T>, &detail::parse_column_scalar<T>, &detail::parse_column_scalar<T>, &detail::parse_column_scalar<T>,
+    };
+#endif
+    return detail::dispatch(table)(column.data(), column.size(), out, base);
+}
+
+}   /* wtl */
@@ -0,0 +1,329 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/string.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Algorithm selected by a searcher for its needle.
+ */
+enum class search_strategy
+{
+    empty,
+    character,
+    filter,
+    horspool,
+    two_way,
+};
+
+
+/** \brief Precompiled substring searcher.
+ *
+ *  Analyzes the needle once, picking `memchr` for single characters,
+ *  the SIMD first/last byte filter for short narrow needles, a
+ *  Boyer-Moore-Horspool shift table for long narrow needles, and
+ *  Two-Way for periodic or wide-character needles. The searcher is
+ *  immutable after construction, and may be shared between threads.
+ *
+ *  Searchers also model the `std::search` searcher protocol over
+ *  iterators to contiguous storage.
+ *
+ *  \warning The lifetime of the needle must outlive the searcher.
+ */
+template <
+    typename Char,
+    typename Traits
+>
+class basic_searcher
+{
+protected:
+    basic_string<Char, Traits> needle_;
+    search_strategy strategy_ = search_strategy::empty;
+    detail::two_way_factorization forward_;
+    detail::two_way_factorization reverse_;
+    size_t shift_[256] = {};
+
+    void initialize();
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Char value_type;
+    typedef Traits traits_type;
+
+    // MEMBER VARIABLES
+    // ----------------
+    static const size_t filter_limit = 32;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    basic_searcher();
+    basic_searcher(const basic_searcher<Char, Traits> &other) = default;
+    basic_searcher<Char, Traits> & operator=(const basic_searcher<Char, Traits> &other) = default;
+
+    basic_searcher(const basic_string<Char, Traits> &needle);
+    basic_searcher(const std::basic_string<Char, Traits> &needle);
+    basic_searcher(const Char *needle);
+    basic_searcher(const Char *needle,
+        size_t n);
+
+    // PROPERTIES
+    const basic_string<Char, Traits> & needle() const noexcept;
+    size_t size() const noexcept;
+    search_strategy strategy() const noexcept;
+
+    // SEARCH
+    const Char * find(const Char *first,
+        size_t length) const noexcept;
+    const Char * rfind(const Char *first,
+        size_t length) const noexcept;
+
+    template <typename RandomIt>
+    std::pair<RandomIt, RandomIt> operator()(RandomIt first,
+        RandomIt last) const;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+template <typename C, typename T>
+const size_t basic_searcher<C, T>::filter_limit;
+
+
+template <typename C, typename T>
+basic_searcher<C, T>::basic_searcher()
+{
+    initialize();
+}
+
+
+template <typename C, typename T>
+basic_searcher<C, T>::basic_searcher(const basic_string<C, T> &needle):
+    needle_(needle)
+{
+    initialize();
+}
+
+
+template <typename C, typename T>
+basic_searcher<C, T>::basic_searcher(const std::basic_string<C, T> &needle):
+    needle_(needle)
+{
+    initialize();
+}
+
+
+template <typename C, typename T>
+basic_searcher<C, T>::basic_searcher(const C *needle):
+    needle_(needle)
+{
+    initialize();
+}
+
+
+template <typename C, typename T>
+basic_searcher<C, T>::basic_searcher(const C *needle,
+        size_t n):
+    needle_(needle, n)
+{
+    initialize();
+}
+
+
+template <typename C, typename T>
+void basic_searcher<C, T>::initialize()
+{
+    const C *first = needle_.data();
+    const size_t n = needle_.size();
+    if (n == 0) {
+        strategy_ = search_strategy::empty;
+        return;
+    } else if (n == 1) {
+        strategy_ = search_strategy::character;
+        return;
+    }
+
+    forward_ = detail::two_way_factorize(first, n);
+    reverse_ = detail::two_way_factorize(std::reverse_iterator<const C*>(first + n), n);
+    if (sizeof(C) != 1 || forward_.periodic) {
+        strategy_ = search_strategy::two_way;
+    } else if (n <= filter_limit) {
+        strategy_ = search_strategy::filter;
+    } else {
+        strategy_ = search_strategy::horspool;
+        std::fill(shift_, shift_ + 256, n);
+        for (size_t i = 0; i + 1 < n; ++i) {
+            shift_[static_cast<unsigned char>(first[i])] = n - 1 - i;
+        }
+    }
+}
+
+
+template <typename C, typename T>
+auto basic_searcher<C, T>::needle() const noexcept
+    -> const basic_string<C, T> &
+{
+    return needle_;
+}
+
+
+template <typename C, typename T>
+size_t basic_searcher<C, T>::size() const noexcept
+{
+    return needle_.size();
+}
+
+
+template <typename C, typename T>
+search_strategy basic_searcher<C, T>::strategy() const noexcept
+{
+    return strategy_;
+}
+
+
+template <typename C, typename T>
+const C * basic_searcher<C, T>::find(const C *first,
+    size_t length) const noexcept
+{
+    const C *substr = needle_.data();
+    const size_t sublen = needle_.size();
+    if (sublen > length) {
+        return nullptr;
+    }
+
+    switch (strategy_) {
+        case search_strategy::empty:
+            return first;
+        case search_strategy::character:
+            return detail::find_char(first, length, *substr);
+        case search_strategy::filter:
+            return detail::find_substr(first, length, substr, sublen);
+        case search_strategy::horspool: {
+            // charge every compared character, and once the charge
+            // outgrows the scanned prefix, finish with Two-Way to
+            // bound the search at O(n)
+            const C last = substr[sublen - 1];
+            size_t compared = 0;
+            for (size_t pos = 0; pos <= length - sublen; ) {
+                const C c = first[pos + sublen - 1];
+                if (c == last) {
+                    const C *mismatch = std::mismatch(substr, substr + sublen - 1, first + pos).first;
+                    if (mismatch == substr + sublen - 1) {
+                        return first + pos;
+                    }
+                    compared += static_cast<size_t>(mismatch - substr) + 1;
+                    if (compared > 4 * (pos + sublen)) {
+                        size_t offset = detail::two_way_search(first + pos, length - pos, substr, sublen, forward_);
+                        return offset == SIZE_MAX ? nullptr : first + pos + offset;
+                    }
+                }
+                pos += shift_[static_cast<unsigned char>(c)];
+            }
+            return nullptr;
+        }
+        case search_strategy::two_way:
+        default: {
+            size_t offset = detail::two_way_search(first, length, substr, sublen, forward_);
+            return offset == SIZE_MAX ? nullptr : first + offset;
+        }
+    }
+}
+
+
+template <typename C, typename T>
+const C * basic_searcher<C, T>::rfind(const C *first,
+    size_t length) const noexcept
+{
+    typedef std::reverse_iterator<const C*> reverse;
+
+    const C *substr = needle_.data();
+    const size_t sublen = needle_.size();
+    if (sublen > length) {
+        return nullptr;
+    }
+
+    switch (strategy_) {
+        case search_strategy::empty:
+            return first + length;
+        case search_strategy::character:
+            return detail::rfind_char(first, length, *substr);
+        case search_strategy::filter:
+        case search_strategy::horspool:
+            return detail::rfind_substr(first, length, substr, sublen);
+        case search_strategy::two_way:
+        default: {
+            size_t offset = detail::two_way_search(reverse(first + length), length,
+                reverse(substr + sublen), sublen, reverse_);
+            return offset == SIZE_MAX ? nullptr : first + (length - offset - sublen);
+        }
+    }
+}
+
+
+/** \brief Search `[first, last)`, which must be contiguous storage.
+ *
+ *  \return         Iterator range of the first match, or `{last, last}`.
+ */
+template <typename C, typename T>
+template <typename RandomIt>
+std::pair<RandomIt, RandomIt> basic_searcher<C, T>::operator()(RandomIt first,
+    RandomIt last) const
+{
+    if (first == last) {
+        return std::make_pair(first, needle_.empty() ? first : last);
+    }
+
+    const C *data = std::addressof(*first);
+    const C *found = find(data, static_cast<size_t>(last - first));
+    if (!found) {
+        return std::make_pair(last, last);
+    }
+    RandomIt match = first + (found - data);
+    return std::make_pair(match, match + size());
+}
+
+
+template <typename C, typename T>
+size_t basic_string<C, T>::find(const basic_searcher<C, T> &searcher,
+    size_t pos) const noexcept
+{
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = searcher.find(data()+pos, size()-pos);
+    return found ? found - data() : npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_string<C, T>::rfind(const basic_searcher<C, T> &searcher,
+    size_t pos) const noexcept
+{
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = searcher.rfind(data()+pos, size()-pos);
+    return found ? found - data() : npos;
+}
+
+// TYPES
+// -----
+
+typedef basic_searcher<char> searcher;
+typedef basic_searcher<wchar_t> wsearcher;
+typedef basic_searcher<char16_t> u16searcher;
+typedef basic_searcher<char32_t> u32searcher;
+
+}   /* wtl */
@@ -0,0 +1,838 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/string.hpp>
+#include <wtl/detail/posix.hpp>
+#include <wtl/detail/search.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief String view over non-contiguous segments.
+ *
+ *  Binds an ordered list of `basic_string` segments, such as a scatter
+ *  list or the two halves of a wrapped ring buffer, and exposes them as
+ *  a single string without linearizing them. Element access locates
+ *  the segment by binary search over the segment offsets.
+ *
+ *  Searches run the contiguous kernels over each segment, and only
+ *  compare across segments for matches starting in the last
+ *  `size() - 1` elements of a segment. Empty segments are dropped.
+ *
+ *  \warning The lifetime of the source data must outlive the wrapper.
+ */
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>
+>
+class basic_segmented_string
+{
+public:
+    class iterator;
+
+    // MEMBER TYPES
+    // ------------
+    typedef Char value_type;
+    typedef Traits traits_type;
+    typedef const Char& reference;
+    typedef const Char& const_reference;
+    typedef const Char* pointer;
+    typedef const Char* const_pointer;
+    typedef std::ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef iterator const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef reverse_iterator const_reverse_iterator;
+    typedef basic_string<Char, Traits> segment_type;
+
+    // MEMBER VARIABLES
+    // ----------------
+    static const size_t npos = SIZE_MAX;
+
+protected:
+    std::vector<segment_type> segments_;
+    std::vector<size_t> offsets_ = std::vector<size_t>(1, 0);
+
+    size_t segment_of(size_t pos) const noexcept;
+    int compare_at(size_t pos,
+        const Char *s,
+        size_t n) const noexcept;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    basic_segmented_string() = default;
+    basic_segmented_string(const segment_type &str);
+    basic_segmented_string(std::initializer_list<segment_type> list);
+    template <typename Iter>
+    basic_segmented_string(Iter first,
+        Iter last);
+
+    // ITERATORS
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // CAPACITY
+    size_t size() const noexcept;
+    size_t length() const noexcept;
+    bool empty() const noexcept;
+
+    // ELEMENT ACCESS
+    const_reference operator[](size_type pos) const noexcept;
+    const_reference at(size_type pos) const;
+    const_reference front() const noexcept;
+    const_reference back() const noexcept;
+
+    // SEGMENTS
+    const std::vector<segment_type> & segments() const noexcept;
+    size_t segment_offset(size_t index) const noexcept;
+
+    // MODIFIERS
+    void push_back(const segment_type &str);
+    void clear() noexcept;
+    void swap(basic_segmented_string<Char, Traits> &other) noexcept;
+
+    // FIND
+    size_t find(const segment_type &str,
+        size_t pos = 0) const noexcept;
+    size_t find(Char c,
+        size_t pos = 0) const noexcept;
+    bool contains(const segment_type &str) const noexcept;
+
+    // COMPARE
+    int compare(const segment_type &str) const noexcept;
+    int compare(const basic_segmented_string<Char, Traits> &str) const noexcept;
+
+    basic_segmented_string<Char, Traits> substr(size_type pos = 0,
+        size_type len = npos) const;
+
+    // CONVERSIONS
+    size_t copy(Char *dst,
+        size_t count,
+        size_t pos = 0) const;
+    explicit operator std::basic_string<Char, Traits>() const;
+
+#if defined(WTL_POSIX)
+    size_t to_iovec(struct iovec *iov,
+        size_t count) const noexcept;
+    std::vector<struct iovec> to_iovec() const;
+#endif
+};
+
+
+/** \brief Random-access iterator over a segmented string.
+ *
+ *  Keeps the current segment, so stepping only crosses into the next
+ *  segment at its boundary, and jumps search for the segment again
+ *  only when they leave the current one.
+ */
+template <typename C, typename T>
+class basic_segmented_string<C, T>::iterator
+{
+protected:
+    const basic_segmented_string<C, T> *string_ = nullptr;
+    size_t segment_ = 0;
+    size_t pos_ = 0;
+
+    iterator(const basic_segmented_string<C, T> *string,
+        size_t segment,
+        size_t pos) noexcept;
+
+    friend class basic_segmented_string<C, T>;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef C value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const C* pointer;
+    typedef const C& reference;
+
+    iterator() = default;
+
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+    reference operator[](difference_type n) const noexcept;
+    iterator & operator++() noexcept;
+    iterator operator++(int) noexcept;
+    iterator & operator--() noexcept;
+    iterator operator--(int) noexcept;
+    iterator & operator+=(difference_type n) noexcept;
+    iterator & operator-=(difference_type n) noexcept;
+    iterator operator+(difference_type n) const noexcept;
+    iterator operator-(difference_type n) const noexcept;
+    difference_type operator-(const iterator &other) const noexcept;
+
+    bool operator==(const iterator &other) const noexcept;
+    bool operator!=(const iterator &other) const noexcept;
+    bool operator<(const iterator &other) const noexcept;
+    bool operator<=(const iterator &other) const noexcept;
+    bool operator>(const iterator &other) const noexcept;
+    bool operator>=(const iterator &other) const noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+template <typename C, typename T>
+const size_t basic_segmented_string<C, T>::npos;
+
+
+/** \brief Index of the segment holding `pos`, or the count at the end.
+ */
+template <typename C, typename T>
+size_t basic_segmented_string<C, T>::segment_of(size_t pos) const noexcept
+{
+    return std::upper_bound(offsets_.begin(), offsets_.end(), pos) - offsets_.begin() - 1;
+}
+
+
+/** \brief Compare the `n` elements from `pos`, which must exist, to `s`.
+ */
+template <typename C, typename T>
+int basic_segmented_string<C, T>::compare_at(size_t pos,
+    const C *s,
+    size_t n) const noexcept
+{
+    for (size_t i = segment_of(pos); n; ++i) {
+        const size_t local = pos - offsets_[i];
+        const size_t count = std::min(n, segments_[i].size() - local);
+        int result = traits_type::compare(segments_[i].data() + local, s, count);
+        if (result != 0) {
+            return result;
+        }
+        pos += count;
+        s += count;
+        n -= count;
+    }
+    return 0;
+}
+
+
+template <typename C, typename T>
+basic_segmented_string<C, T>::basic_segmented_string(const segment_type &str)
+{
+    push_back(str);
+}
+
+
+template <typename C, typename T>
+basic_segmented_string<C, T>::basic_segmented_string(std::initializer_list<segment_type> list):
+    basic_segmented_string(list.begin(), list.end())
+{}
+
+
+template <typename C, typename T>
+template <typename Iter>
+basic_segmented_string<C, T>::basic_segmented_string(Iter first,
+    Iter last)
+{
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::begin() const noexcept
+    -> const_iterator
+{
+    return const_iterator(this, 0, 0);
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator(this, segments_.size(), size());
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::rbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(end());
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::rend() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(begin());
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename C, typename T>
+size_t basic_segmented_string<C, T>::size() const noexcept
+{
+    return offsets_.back();
+}
+
+
+template <typename C, typename T>
+size_t basic_segmented_string<C, T>::length() const noexcept
+{
+    return size();
+}
+
+
+template <typename C, typename T>
+bool basic_segmented_string<C, T>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::operator[](size_type pos) const noexcept
+    -> const_reference
+{
+    size_t i = segment_of(pos);
+    return segments_[i].data()[pos - offsets_[i]];
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::at(size_type pos) const
+    -> const_reference
+{
+    if (pos >= size()) {
+        throw std::out_of_range("basic_segmented_string::at().");
+    }
+    return operator[](pos);
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::front() const noexcept
+    -> const_reference
+{
+    return segments_.front().front();
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::back() const noexcept
+    -> const_reference
+{
+    return segments_.back().back();
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::segments() const noexcept
+    -> const std::vector<segment_type> &
+{
+    return segments_;
+}
+
+
+/** \brief Position of the first element of segment `index`.
+ */
+template <typename C, typename T>
+size_t basic_segmented_string<C, T>::segment_offset(size_t index) const noexcept
+{
+    return offsets_[index];
+}
+
+
+/** \brief Append a segment, which is ignored if empty.
+ */
+template <typename C, typename T>
+void basic_segmented_string<C, T>::push_back(const segment_type &str)
+{
+    if (!str.empty()) {
+        segments_.push_back(str);
+        offsets_.push_back(offsets_.back() + str.size());
+    }
+}
+
+
+template <typename C, typename T>
+void basic_segmented_string<C, T>::clear() noexcept
+{
+    segments_.clear();
+    offsets_.resize(1);
+}
+
+
+template <typename C, typename T>
+void basic_segmented_string<C, T>::swap(basic_segmented_string<C, T> &other) noexcept
+{
+    segments_.swap(other.segments_);
+    offsets_.swap(other.offsets_);
+}
+
+
+/** \brief Find the first occurrence of `str` at or after `pos`.
+ *
+ *  Each segment is first searched in place, which finds any match
+ *  contained in it. Otherwise, candidates in its last `str.size() - 1`
+ *  elements are located by their first element, and compared across
+ *  the following segments.
+ */
+template <typename C, typename T>
+size_t basic_segmented_string<C, T>::find(const segment_type &str,
+    size_t pos) const noexcept
+{
+    const size_t m = str.size();
+    if (pos > size()) {
+        return npos;
+    } else if (m == 0) {
+        return pos;
+    } else if (m > size() - pos) {
+        return npos;
+    }
+
+    for (size_t i = segment_of(pos); i < segments_.size(); ++i) {
+        const C *data = segments_[i].data();
+        const size_t length = segments_[i].size();
+        const size_t first = pos > offsets_[i] ? pos - offsets_[i] : 0;
+        if (const C *found = detail::find(data + first, length - first, str.data(), m)) {
+            return offsets_[i] + (found - data);
+        }
+
+        // matches straddling the end of the segment
+        const size_t tail = std::max(first, length - std::min(length, m - 1));
+        for (const C *it = data + tail; (it = detail::find_char(it, length - (it - data), str.front())); ++it) {
+            const size_t offset = offsets_[i] + (it - data);
+            if (size() - offset < m) {
+                return npos;
+            } else if (compare_at(offset, str.data(), m) == 0) {
+                return offset;
+            }
+        }
+    }
+    return npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_segmented_string<C, T>::find(C c,
+    size_t pos) const noexcept
+{
+    if (pos >= size()) {
+        return npos;
+    }
+    for (size_t i = segment_of(pos); i < segments_.size(); ++i) {
+        const C *data = segments_[i].data();
+        const size_t first = pos > offsets_[i] ? pos - offsets_[i] : 0;
+        if (const C *found = detail::find_char(data + first, segments_[i].size() - first, c)) {
+            return offsets_[i] + (found - data);
+        }
+    }
+    return npos;
+}
+
+
+template <typename C, typename T>
+bool basic_segmented_string<C, T>::contains(const segment_type &str) const noexcept
+{
+    return find(str) != npos;
+}
+
+
+template <typename C, typename T>
+int basic_segmented_string<C, T>::compare(const segment_type &str) const noexcept
+{
+    const size_t n = std::min(size(), str.size());
+    int result = compare_at(0, str.data(), n);
+    if (result != 0) {
+        return result;
+    } else if (size() < str.size()) {
+        return -1;
+    } else if (size() > str.size()) {
+        return 1;
+    }
+    return 0;
+}
+
+
+/** \brief Compare segment by segment of `str`, so neither is linearized.
+ */
+template <typename C, typename T>
+int basic_segmented_string<C, T>::compare(const basic_segmented_string<C, T> &str) const noexcept
+{
+    const size_t n = std::min(size(), str.size());
+    size_t pos = 0;
+    for (size_t i = 0; pos < n; ++i) {
+        const size_t count = std::min(str.segments_[i].size(), n - pos);
+        int result = compare_at(pos, str.segments_[i].data(), count);
+        if (result != 0) {
+            return result;
+        }
+        pos += count;
+    }
+
+    if (size() < str.size()) {
+        return -1;
+    } else if (size() > str.size()) {
+        return 1;
+    }
+    return 0;
+}
+
+
+/** \brief View of up to `len` elements from `pos`, sharing the segments.
+ */
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::substr(size_type pos,
+    size_type len) const
+    -> basic_segmented_string<C, T>
+{
+    if (pos > size()) {
+        throw std::out_of_range("basic_segmented_string::substr().");
+    }
+
+    basic_segmented_string<C, T> result;
+    len = std::min(len, size() - pos);
+    for (size_t i = segment_of(pos); len; ++i) {
+        const size_t local = pos - offsets_[i];
+        const size_t count = std::min(len, segments_[i].size() - local);
+        result.push_back(segment_type(segments_[i].data() + local, count));
+        pos += count;
+        len -= count;
+    }
+    return result;
+}
+
+
+/** \brief Copy up to `count` elements from `pos` to `dst`, returning the count.
+ */
+template <typename C, typename T>
+size_t basic_segmented_string<C, T>::copy(C *dst,
+    size_t count,
+    size_t pos) const
+{
+    if (pos > size()) {
+        throw std::out_of_range("basic_segmented_string::copy().");
+    }
+
+    count = std::min(count, size() - pos);
+    size_t copied = 0;
+    for (size_t i = segment_of(pos); copied < count; ++i) {
+        const size_t local = pos + copied - offsets_[i];
+        const size_t n = std::min(count - copied, segments_[i].size() - local);
+        traits_type::copy(dst + copied, segments_[i].data() + local, n);
+        copied += n;
+    }
+    return copied;
+}
+
+
+template <typename C, typename T>
+basic_segmented_string<C, T>::operator std::basic_string<C, T>() const
+{
+    std::basic_string<C, T> str(size(), C());
+    if (!str.empty()) {
+        copy(&str[0], str.size());
+    }
+    return str;
+}
+
+#if defined(WTL_POSIX)
+
+/** \brief Write up to `count` segments to `iov`, returning the number written.
+ *
+ *  Lengths are in bytes, for `writev`. The caller should pass at most
+ *  `IOV_MAX` entries per call.
+ */
+template <typename C, typename T>
+size_t basic_segmented_string<C, T>::to_iovec(struct iovec *iov,
+    size_t count) const noexcept
+{
+    count = std::min(count, segments_.size());
+    for (size_t i = 0; i < count; ++i) {
+        iov[i].iov_base = const_cast<C*>(segments_[i].data());
+        iov[i].iov_len = segments_[i].size() * sizeof(C);
+    }
+    return count;
+}
+
+
+template <typename C, typename T>
+std::vector<struct iovec> basic_segmented_string<C, T>::to_iovec() const
+{
+    std::vector<struct iovec> iov(segments_.size());
+    to_iovec(iov.data(), iov.size());
+    return iov;
+}
+
+#endif
+
+template <typename C, typename T>
+basic_segmented_string<C, T>::iterator::iterator(const basic_segmented_string<C, T> *string,
+        size_t segment,
+        size_t pos) noexcept:
+    string_(string),
+    segment_(segment),
+    pos_(pos)
+{}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator*() const noexcept
+    -> reference
+{
+    return string_->segments_[segment_].data()[pos_ - string_->offsets_[segment_]];
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator->() const noexcept
+    -> pointer
+{
+    return &operator*();
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator[](difference_type n) const noexcept
+    -> reference
+{
+    return *(*this + n);
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator++() noexcept
+    -> iterator &
+{
+    if (++pos_ == string_->offsets_[segment_ + 1]) {
+        ++segment_;
+    }
+    return *this;
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator++(int) noexcept
+    -> iterator
+{
+    iterator copy(*this);
+    ++*this;
+    return copy;
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator--() noexcept
+    -> iterator &
+{
+    if (pos_-- == string_->offsets_[segment_]) {
+        --segment_;
+    }
+    return *this;
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator--(int) noexcept
+    -> iterator
+{
+    iterator copy(*this);
+    --*this;
+    return copy;
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator+=(difference_type n) noexcept
+    -> iterator &
+{
+    pos_ += n;
+    const size_t segments = string_->segments_.size();
+    if (segment_ >= segments || pos_ < string_->offsets_[segment_] || pos_ >= string_->offsets_[segment_ + 1]) {
+        segment_ = string_->segment_of(pos_);
+    }
+    return *this;
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator-=(difference_type n) noexcept
+    -> iterator &
+{
+    return *this += -n;
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator+(difference_type n) const noexcept
+    -> iterator
+{
+    iterator copy(*this);
+    return copy += n;
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator-(difference_type n) const noexcept
+    -> iterator
+{
+    iterator copy(*this);
+    return copy -= n;
+}
+
+
+template <typename C, typename T>
+auto basic_segmented_string<C, T>::iterator::operator-(const iterator &other) const noexcept
+    -> difference_type
+{
+    return static_cast<difference_type>(pos_ - other.pos_);
+}
+
+
+template <typename C, typename T>
+bool basic_segmented_string<C, T>::iterator::operator==(const iterator &other) const noexcept
+{
+    return pos_ == other.pos_;
+}
+
+
+template <typename C, typename T>
+bool basic_segmented_string<C, T>::iterator::operator!=(const iterator &other) const noexcept
+{
+    return pos_ != other.pos_;
+}
+
+
+template <typename C, typename T>
+bool basic_segmented_string<C, T>::iterator::operator<(const iterator &other) const noexcept
+{
+    return pos_ < other.pos_;
+}
+
+
+template <typename C, typename T>
+bool basic_segmented_string<C, T>::iterator::operator<=(const iterator &other) const noexcept
+{
+    return pos_ <= other.pos_;
+}
+
+
+template <typename C, typename T>
+bool basic_segmented_string<C, T>::iterator::operator>(const iterator &other) const noexcept
+{
+    return pos_ > other.pos_;
+}
+
+
+template <typename C, typename T>
+bool basic_segmented_string<C, T>::iterator::operator>=(const iterator &other) const noexcept
+{
+    return pos_ >= other.pos_;
+}
+
+// NON-MEMBER FUNCTIONS
+// --------------------
+
+
+template <typename C, typename T>
+void swap(basic_segmented_string<C, T> &left,
+    basic_segmented_string<C, T> &right) noexcept
+{
+    left.swap(right);
+}
+
+
+template <typename C, typename T>
+bool operator==(const basic_segmented_string<C, T> &left,
+    const basic_segmented_string<C, T> &right) noexcept
+{
+    return left.size() == right.size() && left.compare(right) == 0;
+}
+
+
+template <typename C, typename T>
+bool operator==(const basic_segmented_string<C, T> &left,
+    const basic_string<C, T> &right) noexcept
+{
+    return left.size() == right.size() && left.compare(right) == 0;
+}
+
+
+template <typename C, typename T>
+bool operator==(const basic_string<C, T> &left,
+    const basic_segmented_string<C, T> &right) noexcept
+{
+    return right == left;
+}
+
+
+template <typename C, typename T>
+bool operator!=(const basic_segmented_string<C, T> &left,
+    const basic_segmented_string<C, T> &right) noexcept
+{
+    return !(left == right);
+}
+
+
+template <typename C, typename T>
+bool operator!=(const basic_segmented_string<C, T> &left,
+    const basic_string<C, T> &right) noexcept
+{
+    return !(left == right);
+}
+
+
+template <typename C, typename T>
+bool operator!=(const basic_string<C, T> &left,
+    const basic_segmented_string<C, T> &right) noexcept
+{
+    return !(right == left);
+}
+
+
+template <typename C, typename T>
+bool operator<(const basic_segmented_string<C, T> &left,
+    const basic_segmented_string<C, T> &right) noexcept
+{
+    return left.compare(right) < 0;
+}
+
+// TYPES
+// -----
+
+typedef basic_segmented_string<char> segmented_string;
+typedef basic_segmented_string<wchar_t> wsegmented_string;
+typedef basic_segmented_string<char16_t> u16segmented_string;
+typedef basic_segmented_string<char32_t> u32segmented_string;
+
+}   /* wtl */
@@ -0,0 +1,381 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/byteset.hpp>
+#include <wtl/string.hpp>
+
+#include <iterator>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Whether `split` yields the empty tokens between adjacent delimiters.
+ */
+enum class split_empty
+{
+    keep,
+    skip,
+};
+
+namespace detail
+{
+// DELIMITERS
+// ----------
+
+
+/** \brief Single character delimiter, found with `memchr`.
+ */
+template <typename Char>
+struct char_delimiter
+{
+    Char c;
+
+    const Char * find(const Char *first,
+        size_t length) const noexcept
+    {
+        return find_char(first, length, c);
+    }
+
+    size_t size() const noexcept
+    {
+        return 1;
+    }
+};
+
+
+/** \brief Substring delimiter, found with the SIMD filter or Two-Way.
+ *
+ *  An empty needle never matches, so the input is a single token.
+ */
+template <typename Char, typename Traits>
+struct substr_delimiter
+{
+    basic_string<Char, Traits> needle;
+
+    const Char * find(const Char *first,
+        size_t length) const noexcept
+    {
+        if (needle.empty()) {
+            return nullptr;
+        }
+        return detail::find(first, length, needle.data(), needle.size());
+    }
+
+    size_t size() const noexcept
+    {
+        return needle.size();
+    }
+};
+
+
+/** \brief Any byte of a set delimits, found with the byteset classifier.
+ */
+struct byteset_delimiter
+{
+    byteset set;
+
+    const char * find(const char *first,
+        size_t length) const noexcept
+    {
+        return set.find_first_of(first, length);
+    }
+
+    size_t size() const noexcept
+    {
+        return 1;
+    }
+};
+
+}   /* detail */
+
+
+/** \brief Lazy range of the tokens between delimiters.
+ *
+ *  Each increment scans from the end of the last delimiter to the next
+ *  one with the delimiter's vectorized search, and yields a view into
+ *  the source. Nothing is copied or allocated.
+ *
+ *  \warning Iterators refer to the range, which must outlive them.
+ */
+template <
+    typename Char,
+    typename Traits,
+    typename Delimiter
+>
+class basic_split_range
+{
+public:
+    class iterator;
+    typedef iterator const_iterator;
+    typedef basic_string<Char, Traits> value_type;
+
+protected:
+    basic_string<Char, Traits> str_;
+    Delimiter delimiter_;
+    split_empty empty_;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    basic_split_range(const basic_string<Char, Traits> &str,
+        const Delimiter &delimiter,
+        split_empty empty = split_empty::keep);
+
+    // ITERATORS
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+
+    // PROPERTIES
+    const basic_string<Char, Traits> & str() const noexcept;
+    const Delimiter & delimiter() const noexcept;
+    split_empty empty_tokens() const noexcept;
+};
+
+
+/** \brief Forward iterator over the tokens of a split range.
+ */
+template <typename C, typename T, typename D>
+class basic_split_range<C, T, D>::iterator
+{
+protected:
+    const basic_split_range<C, T, D> *range_ = nullptr;
+    basic_string<C, T> token_;
+    const C *next_ = nullptr;
+    bool last_ = false;
+    bool end_ = true;
+
+    void advance() noexcept;
+
+    friend class basic_split_range<C, T, D>;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef basic_string<C, T> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+
+    iterator() = default;
+
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+    iterator & operator++() noexcept;
+    iterator operator++(int) noexcept;
+
+    bool operator==(const iterator &other) const noexcept;
+    bool operator!=(const iterator &other) const noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename C, typename T, typename D>
+basic_split_range<C, T, D>::basic_split_range(const basic_string<C, T> &str,
+        const D &delimiter,
+        split_empty empty):
+    str_(str),
+    delimiter_(delimiter),
+    empty_(empty)
+{}
+
+
+template <typename C, typename T, typename D>
+auto basic_split_range<C, T, D>::begin() const noexcept
+    -> iterator
+{
+    iterator it;
+    it.range_ = this;
+    it.next_ = str_.data();
+    it.end_ = false;
+    it.advance();
+    return it;
+}
+
+
+template <typename C, typename T, typename D>
+auto basic_split_range<C, T, D>::end() const noexcept
+    -> iterator
+{
+    iterator it;
+    it.range_ = this;
+    return it;
+}
+
+
+template <typename C, typename T, typename D>
+auto basic_split_range<C, T, D>::str() const noexcept
+    -> const basic_string<C, T> &
+{
+    return str_;
+}
+
+
+template <typename C, typename T, typename D>
+auto basic_split_range<C, T, D>::delimiter() const noexcept
+    -> const D &
+{
+    return delimiter_;
+}
+
+
+template <typename C, typename T, typename D>
+split_empty basic_split_range<C, T, D>::empty_tokens() const noexcept
+{
+    return empty_;
+}
+
+
+/** \brief Move to the token starting at `next_`, or past the end.
+ *
+ *  `last_` is set once the token after the final delimiter has been
+ *  yielded, independent of the source's data pointer.
+ */
+template <typename C, typename T, typename D>
+void basic_split_range<C, T, D>::iterator::advance() noexcept
+{
+    const C *last = range_->str_.data() + range_->str_.size();
+    do {
+        if (last_) {
+            end_ = true;
+            token_ = basic_string<C, T>();
+            return;
+        }
+
+        const C *first = next_;
+        const C *found = range_->delimiter_.find(first, last - first);
+        if (found) {
+            token_ = basic_string<C, T>(first, found - first);
+            next_ = found + range_->delimiter_.size();
+        } else {
+            token_ = basic_string<C, T>(first, last - first);
+            next_ = last;
+            last_ = true;
+        }
+    } while (token_.empty() && range_->empty_ == split_empty::skip);
+}
+
+
+template <typename C, typename T, typename D>
+auto basic_split_range<C, T, D>::iterator::operator*() const noexcept
+    -> reference
+{
+    return token_;
+}
+
+
+template <typename C, typename T, typename D>
+auto basic_split_range<C, T, D>::iterator::operator->() const noexcept
+    -> pointer
+{
+    return &token_;
+}
+
+
+template <typename C, typename T, typename D>
+auto basic_split_range<C, T, D>::iterator::operator++() noexcept
+    -> iterator &
+{
+    advance();
+    return *this;
+}
+
+
+template <typename C, typename T, typename D>
+auto basic_split_range<C, T, D>::iterator::operator++(int) noexcept
+    -> iterator
+{
+    iterator copy(*this);
+    advance();
+    return copy;
+}
+
+
+template <typename C, typename T, typename D>
+bool basic_split_range<C, T, D>::iterator::operator==(const iterator &other) const noexcept
+{
+    if (end_ || other.end_) {
+        return end_ == other.end_;
+    }
+    return token_.data() == other.token_.data() && next_ == other.next_ && last_ == other.last_;
+}
+
+
+template <typename C, typename T, typename D>
+bool basic_split_range<C, T, D>::iterator::operator!=(const iterator &other) const noexcept
+{
+    return !(*this == other);
+}
+
+// SPLIT
+// -----
+
+
+/** \brief Split `str` on each occurrence of `c`.
+ */
+template <typename Char, typename Traits>
+basic_split_range<Char, Traits, detail::char_delimiter<Char>> split(const basic_string<Char, Traits> &str,
+    Char c,
+    split_empty empty = split_empty::keep)
+{
+    return {str, detail::char_delimiter<Char> {c}, empty};
+}
+
+
+/** \brief Split `str` on each occurrence of the substring `delimiter`.
+ */
+template <typename Char, typename Traits>
+basic_split_range<Char, Traits, detail::substr_delimiter<Char, Traits>> split(const basic_string<Char, Traits> &str,
+    const basic_string<Char, Traits> &delimiter,
+    split_empty empty = split_empty::keep)
+{
+    return {str, detail::substr_delimiter<Char, Traits> {delimiter}, empty};
+}
+
+
+/** \brief Split `str` on each occurrence of the substring `delimiter`.
+ */
+template <typename Char, typename Traits>
+basic_split_range<Char, Traits, detail::substr_delimiter<Char, Traits>> split(const basic_string<Char, Traits> &str,
+    const Char *delimiter,
+    split_empty empty = split_empty::keep)
+{
+    return split(str, basic_string<Char, Traits>(delimiter), empty);
+}
+
+
+/** \brief Split `str` on each occurrence of the substring `delimiter`.
+ */
+template <typename Char, typename Traits>
+basic_split_range<Char, Traits, detail::substr_delimiter<Char, Traits>> split(const basic_string<Char, Traits> &str,
+    const std::basic_string<Char, Traits> &delimiter,
+    split_empty empty = split_empty::keep)
+{
+    return split(str, basic_string<Char, Traits>(delimiter), empty);
+}
+
+
+/** \brief Split `str` on any byte in `set`.
+ */
+template <typename Traits>
+basic_split_range<char, Traits, detail::byteset_delimiter> split(const basic_string<char, Traits> &str,
+    const byteset &set,
+    split_empty empty = split_empty::keep)
+{
+    return {str, detail::byteset_delimiter {set}, empty};
+}
+
+// ALIAS
+// -----
+
+template <typename Delimiter>
+using split_range = basic_split_range<char, std::char_traits<char>, Delimiter>;
+
+}   /* wtl */
@@ -0,0 +1,284 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/multi_searcher.hpp>
+#include <wtl/string.hpp>
+
+#include <algorithm>
+#include <vector>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Substring search over a stream fed in chunks.
+ *
+ *  Finds matches that straddle chunk boundaries without copying any
+ *  chunk. Within a chunk, whole matches are found with the vectorized
+ *  search behind `basic_string::find`. Across boundaries, the only
+ *  state kept is the KMP state: the length of the longest suffix of the
+ *  stream that is a prefix of the needle. A partial match is resolved
+ *  with KMP steps at the start of the next chunk, and the state for the
+ *  end of a chunk is recomputed from its last `size() - 1` elements.
+ *
+ *  Match offsets count elements from the start of the stream, and are
+ *  reported in increasing order, overlapping matches included. Empty
+ *  needles never match.
+ *
+ *  \warning The lifetime of the needle must outlive the searcher.
+ */
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>
+>
+class basic_stream_searcher
+{
+protected:
+    basic_string<Char, Traits> needle_;
+    std::vector<size_t> failure_;
+    size_t matched_ = 0;
+    size_t offset_ = 0;
+
+    bool step(Char c) noexcept;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    basic_stream_searcher(const basic_string<Char, Traits> &needle);
+
+    // PROPERTIES
+    const basic_string<Char, Traits> & needle() const noexcept;
+    size_t offset() const noexcept;
+    size_t pending() const noexcept;
+
+    // STREAM
+    template <typename Callback>
+    void feed(const basic_string<Char, Traits> &chunk,
+        Callback &&callback);
+    std::vector<size_t> feed(const basic_string<Char, Traits> &chunk);
+    void reset() noexcept;
+};
+
+
+/** \brief Aho-Corasick search over a stream fed in chunks.
+ *
+ *  Carries the DFA state of a `multi_searcher` from one chunk to the
+ *  next, so each chunk is scanned once, in place. Match offsets count
+ *  bytes from the start of the stream.
+ *
+ *  \warning The lifetime of the searcher must outlive the stream.
+ */
+class multi_stream_searcher
+{
+protected:
+    const multi_searcher *searcher_;
+    uint32_t state_ = 0;
+    size_t offset_ = 0;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    explicit multi_stream_searcher(const multi_searcher &searcher);
+
+    // PROPERTIES
+    size_t offset() const noexcept;
+
+    // STREAM
+    template <typename Callback>
+    void feed(const string &chunk,
+        Callback &&callback);
+    std::vector<multi_searcher::match> feed(const string &chunk);
+    void reset() noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+/** \brief Build the KMP failure function of the needle.
+ *
+ *  `failure_[i]` is the length of the longest proper border of the
+ *  first `i` elements of the needle.
+ */
+template <typename C, typename T>
+basic_stream_searcher<C, T>::basic_stream_searcher(const basic_string<C, T> &needle):
+    needle_(needle),
+    failure_(needle.size() + 1, 0)
+{
+    const C *data = needle_.data();
+    size_t k = 0;
+    for (size_t i = 1; i < needle_.size(); ++i) {
+        while (k && data[i] != data[k]) {
+            k = failure_[k];
+        }
+        if (data[i] == data[k]) {
+            ++k;
+        }
+        failure_[i + 1] = k;
+    }
+}
+
+
+/** \brief Advance the KMP state by `c`, returning whether a match ends.
+ */
+template <typename C, typename T>
+bool basic_stream_searcher<C, T>::step(C c) noexcept
+{
+    const C *data = needle_.data();
+    while (matched_ && data[matched_] != c) {
+        matched_ = failure_[matched_];
+    }
+    if (data[matched_] == c) {
+        ++matched_;
+    }
+    if (matched_ == needle_.size()) {
+        matched_ = failure_[matched_];
+        return true;
+    }
+    return false;
+}
+
+
+template <typename C, typename T>
+auto basic_stream_searcher<C, T>::needle() const noexcept
+    -> const basic_string<C, T> &
+{
+    return needle_;
+}
+
+
+/** \brief Elements fed since construction or the last `reset`.
+ */
+template <typename C, typename T>
+size_t basic_stream_searcher<C, T>::offset() const noexcept
+{
+    return offset_;
+}
+
+
+/** \brief Length of the needle prefix matched by the end of the stream.
+ */
+template <typename C, typename T>
+size_t basic_stream_searcher<C, T>::pending() const noexcept
+{
+    return matched_;
+}
+
+
+/** \brief Feed the next chunk, calling `callback(offset)` for each match.
+ */
+template <typename C, typename T>
+template <typename Callback>
+void basic_stream_searcher<C, T>::feed(const basic_string<C, T> &chunk,
+    Callback &&callback)
+{
+    const C *data = chunk.data();
+    const size_t length = chunk.size();
+    const size_t m = needle_.size();
+    if (m == 0) {
+        offset_ += length;
+        return;
+    }
+
+    // resolve a partial match from earlier chunks
+    size_t i = 0;
+    for (; matched_ && i < length; ++i) {
+        if (step(data[i])) {
+            callback(offset_ + i + 1 - m);
+        }
+    }
+
+    if (i < length) {
+        // no match is in progress, so the rest are within the chunk,
+        // or start in its last `m - 1` elements
+        while (const C *found = detail::find(data + i, length - i, needle_.data(), m)) {
+            callback(offset_ + (found - data));
+            i = found - data + 1;
+        }
+        for (i = std::max(i, length - std::min(length, m - 1)); i < length; ++i) {
+            step(data[i]);
+        }
+    }
+    offset_ += length;
+}
+
+
+template <typename C, typename T>
+std::vector<size_t> basic_stream_searcher<C, T>::feed(const basic_string<C, T> &chunk)
+{
+    std::vector<size_t> offsets;
+    feed(chunk, [&offsets](size_t offset) {
+        offsets.push_back(offset);
+    });
+    return offsets;
+}
+
+
+/** \brief Start a new stream.
+ */
+template <typename C, typename T>
+void basic_stream_searcher<C, T>::reset() noexcept
+{
+    matched_ = 0;
+    offset_ = 0;
+}
+
+
+inline multi_stream_searcher::multi_stream_searcher(const multi_searcher &searcher):
+    searcher_(&searcher)
+{}
+
+
+/** \brief Bytes fed since construction or the last `reset`.
+ */
+inline size_t multi_stream_searcher::offset() const noexcept
+{
+    return offset_;
+}
+
+
+/** \brief Feed the next chunk, calling `callback(match)` for each match.
+ */
+template <typename Callback>
+void multi_stream_searcher::feed(const string &chunk,
+    Callback &&callback)
+{
+    searcher_->scan(chunk, state_, offset_, [&callback](const multi_searcher::match &m) {
+        callback(m);
+        return true;
+    });
+    offset_ += chunk.size();
+}
+
+
+inline std::vector<multi_searcher::match> multi_stream_searcher::feed(const string &chunk)
+{
+    std::vector<multi_searcher::match> matches;
+    feed(chunk, [&matches](const multi_searcher::match &m) {
+        matches.push_back(m);
+    });
+    return matches;
+}
+
+
+inline void multi_stream_searcher::reset() noexcept
+{
+    state_ = 0;
+    offset_ = 0;
+}
+
+// TYPES
+// -----
+
+typedef basic_stream_searcher<char> stream_searcher;
+typedef basic_stream_searcher<wchar_t> wstream_searcher;
+typedef basic_stream_searcher<char16_t> u16stream_searcher;
+typedef basic_stream_searcher<char32_t> u32stream_searcher;
+
+}   /* wtl */
@@ -4,12 +4,26 @@
 
 #pragma once
 
+#include <wtl/byteset.hpp>
+#include <wtl/detail/constexpr.hpp>
+#include <wtl/detail/search.hpp>
+
 #include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
 
 namespace wtl
 {
+// FORWARD
+// -------
+
+template <typename Char, typename Traits = std::char_traits<Char>>
+class basic_searcher;
+
 // DECLARATION
 // -----------
 
@@ -40,17 +54,13 @@ protected:
     friend void swap(basic_string<C, T> &left,
         basic_string<C, T> &right);
 
-    template <typename C, typename T>
-    friend std::basic_istream<C, T> & operator>>(std::basic_istream<C, T> &stream,
-        basic_string<C, T> &str);
-
     template <typename C, typename T>
     friend std::basic_ostream<C, T> & operator<<(std::basic_ostream<C, T> &stream,
-        basic_string<C, T> &str);
+        const basic_string<C, T> &str);
 
     // RELATIONAL OPERATORS
     template <typename C, typename T>
-    friend bool operator==(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator==(const basic_string<C, T> &left,
         const basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
@@ -62,15 +72,15 @@ protected:
         const std::basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
-    friend bool operator==(const C *left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator==(const C *left,
         const basic_string<C, T> &right);
 
     template <typename C, typename T>
-    friend bool operator==(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator==(const basic_string<C, T> &left,
         const C *right);
 
     template <typename C, typename T>
-    friend bool operator!=(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator!=(const basic_string<C, T> &left,
         const basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
@@ -82,15 +92,15 @@ protected:
         const std::basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
-    friend bool operator!=(const C *left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator!=(const C *left,
         const basic_string<C, T> &right);
 
     template <typename C, typename T>
-    friend bool operator!=(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator!=(const basic_string<C, T> &left,
         const C *right);
 
     template <typename C, typename T>
-    friend bool operator<(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator<(const basic_string<C, T> &left,
         const basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
@@ -102,15 +112,15 @@ protected:
         const std::basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
-    friend bool operator<(const C *left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator<(const C *left,
         const basic_string<C, T> &right);
 
     template <typename C, typename T>
-    friend bool operator<(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator<(const basic_string<C, T> &left,
         const C *right);
 
     template <typename C, typename T>
-    friend bool operator<=(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator<=(const basic_string<C, T> &left,
         const basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
@@ -122,15 +132,15 @@ protected:
         const std::basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
-    friend bool operator<=(const C *left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator<=(const C *left,
         const basic_string<C, T> &right);
 
     template <typename C, typename T>
-    friend bool operator<=(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator<=(const basic_string<C, T> &left,
         const C *right);
 
     template <typename C, typename T>
-    friend bool operator>(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator>(const basic_string<C, T> &left,
         const basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
@@ -142,15 +152,15 @@ protected:
         const std::basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
-    friend bool operator>(const C *left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator>(const C *left,
         const basic_string<C, T> &right);
 
     template <typename C, typename T>
-    friend bool operator>(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator>(const basic_string<C, T> &left,
         const C *right);
 
     template <typename C, typename T>
-    friend bool operator>=(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator>=(const basic_string<C, T> &left,
         const basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
@@ -162,11 +172,11 @@ protected:
         const std::basic_string<C, T> &right) noexcept;
 
     template <typename C, typename T>
-    friend bool operator>=(const C *left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator>=(const C *left,
         const basic_string<C, T> &right);
 
     template <typename C, typename T>
-    friend bool operator>=(const basic_string<C, T> &left,
+    friend WTL_CONSTEXPR_DISPATCH bool operator>=(const basic_string<C, T> &left,
         const C *right);
 
 public:
@@ -174,15 +184,15 @@ public:
     // ------------
     typedef Char value_type;
     typedef Traits traits_type;
-    typedef Char& reference;
+    typedef const Char& reference;
     typedef const Char& const_reference;
-    typedef Char* pointer;
+    typedef const Char* pointer;
     typedef const Char* const_pointer;
     typedef std::ptrdiff_t difference_type;
     typedef size_t size_type;
-    typedef pointer iterator;
+    typedef const_pointer iterator;
     typedef const_pointer const_iterator;
-    typedef std::reverse_iterator<pointer> reverse_iterator;
+    typedef std::reverse_iterator<const_pointer> reverse_iterator;
     typedef std::reverse_iterator<const_pointer> const_reverse_iterator;
 
     // MEMBER VARIABLES
@@ -192,49 +202,45 @@ public:
     // MEMBER FUNCTIONS
     // ----------------
     basic_string() = default;
-    basic_string(const basic_string<Char, Traits> &str);
-    basic_string<Char, Traits> & operator=(const basic_string<Char, Traits> &str);
-    basic_string(basic_string<Char, Traits> &&str);
-    basic_string<Char, Traits> & operator=(basic_string<Char, Traits> &&str);
+    basic_string(const basic_string<Char, Traits> &str) = default;
+    basic_string<Char, Traits> & operator=(const basic_string<Char, Traits> &str) = default;
+    basic_string(basic_string<Char, Traits> &&str) = default;
+    basic_string<Char, Traits> & operator=(basic_string<Char, Traits> &&str) = default;
 
     basic_string(const std::basic_string<Char, Traits> &str);
-    basic_string(const basic_string<Char, Traits> &str,
+    WTL_CONSTEXPR14 basic_string(const basic_string<Char, Traits> &str,
         size_type pos,
         size_type len = npos);
     basic_string(const std::basic_string<Char, Traits> &str,
         size_type pos,
         size_type len = npos);
-    basic_string(const Char *str);
-    basic_string(const Char *str,
+    WTL_CONSTEXPR_DISPATCH basic_string(const Char *str);
+    constexpr basic_string(const Char *str,
         size_t n);
-    basic_string(const Char *begin,
+    constexpr basic_string(const Char *begin,
         const Char *end);
     basic_string<Char, Traits> & operator=(const Char *str);
 
     // ITERATORS
-    const_iterator begin() const;
-    const_iterator end() const;
+    constexpr const_iterator begin() const;
+    constexpr const_iterator end() const;
     const_reverse_iterator rbegin() const;
     const_reverse_iterator rend() const;
-    const_iterator cbegin() const;
-    const_iterator cend() const;
+    constexpr const_iterator cbegin() const;
+    constexpr const_iterator cend() const;
     const_reverse_iterator crbegin() const;
     const_reverse_iterator crend() const;
 
     // CAPACITY
-    size_t size() const;
-    size_t length() const;
-    bool empty() const noexcept;
+    constexpr size_t size() const;
+    constexpr size_t length() const;
+    constexpr bool empty() const noexcept;
 
     // ELEMENT ACCESS
-    reference operator[](size_type pos);
-    const_reference operator[](size_type pos) const;
-    reference at(size_type pos);
-    const_reference at(size_type pos) const;
-    reference front();
-    const_reference front() const;
-    reference back();
-    const_reference back() const;
+    WTL_CONSTEXPR14 const_reference operator[](size_type pos) const;
+    WTL_CONSTEXPR14 const_reference at(size_type pos) const;
+    WTL_CONSTEXPR14 const_reference front() const;
+    WTL_CONSTEXPR14 const_reference back() const;
 
     // MODIFIERS
     basic_string<Char, Traits> & assign(const basic_string<Char, Traits> &str);
@@ -261,20 +267,22 @@ public:
     basic_string<Char, Traits> operator-(const size_t shift);
 
     // STRING OPERATIONS
-    const_pointer c_str() const noexcept;
-    const_pointer data() const noexcept;
+    constexpr const_pointer c_str() const noexcept;
+    constexpr const_pointer data() const noexcept;
 
     // FIND
-    size_t find(const basic_string<Char, Traits> &str,
+    WTL_CONSTEXPR_DISPATCH size_t find(const basic_string<Char, Traits> &str,
         size_t pos = 0) const noexcept;
     size_t find(const std::string &str,
         size_t pos = 0) const;
-    size_t find(const char *array,
+    WTL_CONSTEXPR_DISPATCH size_t find(const char *array,
         size_t pos = 0) const;
-    size_t find(const char *cstring,
+    WTL_CONSTEXPR_DISPATCH size_t find(const char *cstring,
         size_t pos,
         size_t length) const;
-    size_t find(char c,
+    WTL_CONSTEXPR_DISPATCH size_t find(char c,
+        size_t pos = 0) const noexcept;
+    size_t find(const basic_searcher<Char, Traits> &searcher,
         size_t pos = 0) const noexcept;
 
     // FIND FIRST OF
@@ -289,6 +297,8 @@ public:
         size_t length) const;
     size_t find_first_of(char c,
         size_t pos = 0) const noexcept;
+    size_t find_first_of(const byteset &set,
+        size_t pos = 0) const noexcept;
 
     // FIND FIRST NOT OF
     size_t find_first_not_of(const basic_string<Char, Traits> &str,
@@ -302,6 +312,8 @@ public:
         size_t length) const;
     size_t find_first_not_of(char c,
         size_t pos = 0) const noexcept;
+    size_t find_first_not_of(const byteset &set,
+        size_t pos = 0) const noexcept;
 
     // RFIND
     size_t rfind(const basic_string<Char, Traits> &str,
@@ -315,6 +327,8 @@ public:
         size_t length) const;
     size_t rfind(char c,
         size_t pos = 0) const noexcept;
+    size_t rfind(const basic_searcher<Char, Traits> &searcher,
+        size_t pos = 0) const noexcept;
 
     // FIND LAST OF
     size_t find_last_of(const basic_string<Char, Traits> &str,
@@ -328,6 +342,8 @@ public:
         size_t length) const;
     size_t find_last_of(char c,
         size_t pos = 0) const noexcept;
+    size_t find_last_of(const byteset &set,
+        size_t pos = 0) const noexcept;
 
     // FIND LAST NOT OF
     size_t find_last_not_of(const basic_string<Char, Traits> &str,
@@ -341,9 +357,18 @@ public:
         size_t length) const;
     size_t find_last_not_of(char c,
         size_t pos = 0) const noexcept;
+    size_t find_last_not_of(const byteset &set,
+        size_t pos = 0) const noexcept;
+
+    // COUNT
+    size_t count(Char c) const noexcept;
+    size_t count(const basic_string<Char, Traits> &str) const noexcept;
+    size_t count_of(const byteset &set) const noexcept;
+    bool contains(Char c) const noexcept;
+    bool contains(const basic_string<Char, Traits> &str) const noexcept;
 
     // COMPARE
-    int compare(const basic_string<Char, Traits> &str) const noexcept;
+    WTL_CONSTEXPR_DISPATCH int compare(const basic_string<Char, Traits> &str) const noexcept;
     int compare(const std::basic_string<Char, Traits> &str) const noexcept;
     int compare(size_t pos,
         size_type len,
@@ -361,7 +386,7 @@ public:
         const std::basic_string<Char, Traits> &str,
         size_type subpos,
         size_type sublen) const;
-    int compare(const Char *s) const;
+    WTL_CONSTEXPR_DISPATCH int compare(const Char *s) const;
     int compare(size_type pos,
         size_type len,
         const Char *s) const;
@@ -370,7 +395,7 @@ public:
         const Char *s,
         size_type n) const;
 
-    basic_string<Char, Traits> substr(size_type pos = 0,
+    WTL_CONSTEXPR14 basic_string<Char, Traits> substr(size_type pos = 0,
         size_type len = npos) const;
 
     // CONVERSIONS
@@ -379,128 +404,6 @@ public:
 };
 
 
-namespace detail
-{
-// DETAIL
-// ------
-
-
-template <typename Char>
-const Char * find(const Char *first,
-    size_t length,
-    const Char *substr,
-    const size_t sublen) noexcept
-{
-    auto *substr_first = substr;
-    auto *substr_last = substr_first + sublen;
-    for (; length >= sublen; --length, ++first) {
-        if (std::equal(substr_first, substr_last, first)) {
-            return first;
-        }
-    }
-    return nullptr;
-}
-
-
-template <typename Char>
-const Char * find_of(const Char *first,
-    size_t length,
-    const Char *substr,
-    const size_t sublen) noexcept
-{
-    auto *substr_first = substr;
-    auto *substr_last = substr_first + sublen;
-    for (; length; --length, ++first) {
-        if (std::any_of(substr_first, substr_last, [first](Char c) {
-            return *first == c;
-        })) {
-            return first;
-        }
-    }
-    return nullptr;
-}
-
-
-template <typename Char>
-const Char * find_not_of(const Char *first,
-    size_t length,
-    const Char *substr,
-    const size_t sublen)
-{
-    auto *substr_first = substr;
-    auto *substr_last = substr_first + sublen;
-    for (; length; --length, ++first) {
-        if (std::none_of(substr_first, substr_last, [first](Char c) {
-            return *first == c;
-        })) {
-            return first;
-        }
-    }
-    return nullptr;
-}
-
-
-template <typename Char>
-const Char * rfind(const Char *last,
-    size_t length,
-    const Char *substr,
-    const size_t sublen)
-{
-    auto *substr_first = substr;
-    auto *substr_last = substr_first + sublen;
-    last -= sublen;
-    for (; length >= sublen; --length) {
-        if (std::equal(substr_first, substr_last, --last)) {
-            return last;
-        }
-    }
-
-    return nullptr;
-}
-
-
-template <typename Char>
-const Char * rfind_of(const Char *last,
-    size_t length,
-    const Char *substr,
-    const size_t sublen)
-{
-    auto *substr_first = substr;
-    auto *substr_last = substr_first + sublen;
-    for (; length; --length) {
-        --last;
-        if (std::any_of(substr_first, substr_last, [last](Char c) {
-            return *last == c;
-        })) {
-            return last;
-        }
-    }
-    return nullptr;
-}
-
-
-template <typename Char>
-const Char * rfind_not_of(const Char *last,
-    size_t length,
-    const Char *substr,
-    const size_t sublen)
-{
-    auto *substr_first = substr;
-    auto *substr_last = substr_first + sublen;
-    for (; length; --length) {
-        --last;
-        if (std::none_of(substr_first, substr_last, [last](Char c) {
-            return *last == c;
-        })) {
-            return last;
-        }
-    }
-    return nullptr;
-}
-
-}   /* detail */
-
-
 // IMPLEMENTATION
 // --------------
 
@@ -515,28 +418,20 @@ void swap(basic_string<C, T> &left,
 }
 
 
-template <typename C, typename T>
-std::basic_istream<C, T> & operator>>(std::basic_istream<C, T> &stream,
-    basic_string<C, T> &str)
-{
-    return stream.read(const_cast<char*>(str.data_), str.length_);
-}
-
-
 template <typename C, typename T>
 std::basic_ostream<C, T> & operator<<(std::basic_ostream<C, T> &stream,
-    basic_string<C, T> &str)
+    const basic_string<C, T> &str)
 {
     return stream.write(str.data(), str.length());
 }
 
 
 template <typename C, typename T>
-bool operator==(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator==(const basic_string<C, T> &left,
     const basic_string<C, T> &right) noexcept
 {
     size_t left_size = left.size();
-    return left_size == right.size() && T::compare(left.data(), right.data(), left_size) == 0;
+    return left_size == right.size() && detail::traits_compare<T>(left.data(), right.data(), left_size) == 0;
 }
 
 
@@ -557,7 +452,7 @@ bool operator==(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator==(const C *left,
+WTL_CONSTEXPR_DISPATCH bool operator==(const C *left,
     const basic_string<C, T> &right)
 {
     return basic_string<C, T>(left) == right;
@@ -565,7 +460,7 @@ bool operator==(const C *left,
 
 
 template <typename C, typename T>
-bool operator==(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator==(const basic_string<C, T> &left,
     const C *right)
 {
     return left == basic_string<C, T>(right);
@@ -573,7 +468,7 @@ bool operator==(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator!=(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator!=(const basic_string<C, T> &left,
     const basic_string<C, T> &right) noexcept
 {
 
@@ -598,7 +493,7 @@ bool operator!=(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator!=(const C *left,
+WTL_CONSTEXPR_DISPATCH bool operator!=(const C *left,
     const basic_string<C, T> &right)
 {
     return !(left == right);
@@ -606,7 +501,7 @@ bool operator!=(const C *left,
 
 
 template <typename C, typename T>
-bool operator!=(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator!=(const basic_string<C, T> &left,
     const C *right)
 {
     return !(left == right);
@@ -614,7 +509,7 @@ bool operator!=(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator<(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator<(const basic_string<C, T> &left,
     const basic_string<C, T> &right) noexcept
 {
     return left.compare(right) < 0;
@@ -638,7 +533,7 @@ bool operator<(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator<(const C *left,
+WTL_CONSTEXPR_DISPATCH bool operator<(const C *left,
     const basic_string<C, T> &right)
 {
     return basic_string<C, T>(left) < right;
@@ -646,7 +541,7 @@ bool operator<(const C *left,
 
 
 template <typename C, typename T>
-bool operator<(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator<(const basic_string<C, T> &left,
     const C *right)
 {
     return left < basic_string<C, T>(right);
@@ -654,7 +549,7 @@ bool operator<(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator<=(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator<=(const basic_string<C, T> &left,
     const basic_string<C, T> &right) noexcept
 {
     return !(right < left);
@@ -678,7 +573,7 @@ bool operator<=(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator<=(const C *left,
+WTL_CONSTEXPR_DISPATCH bool operator<=(const C *left,
     const basic_string<C, T> &right)
 {
     return basic_string<C, T>(left) <= right;
@@ -686,7 +581,7 @@ bool operator<=(const C *left,
 
 
 template <typename C, typename T>
-bool operator<=(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator<=(const basic_string<C, T> &left,
     const C *right)
 {
     return left <= basic_string<C, T>(right);
@@ -694,7 +589,7 @@ bool operator<=(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator>(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator>(const basic_string<C, T> &left,
     const basic_string<C, T> &right) noexcept
 {
     return right < left;
@@ -718,7 +613,7 @@ bool operator>(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator>(const C *left,
+WTL_CONSTEXPR_DISPATCH bool operator>(const C *left,
     const basic_string<C, T> &right)
 {
     return basic_string<C, T>(left) > right;
@@ -726,7 +621,7 @@ bool operator>(const C *left,
 
 
 template <typename C, typename T>
-bool operator>(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator>(const basic_string<C, T> &left,
     const C *right)
 {
     return left > basic_string<C, T>(right);
@@ -734,7 +629,7 @@ bool operator>(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator>=(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator>=(const basic_string<C, T> &left,
     const basic_string<C, T> &right) noexcept
 {
     return !(left < right);
@@ -758,7 +653,7 @@ bool operator>=(const basic_string<C, T> &left,
 
 
 template <typename C, typename T>
-bool operator>=(const C *left,
+WTL_CONSTEXPR_DISPATCH bool operator>=(const C *left,
     const basic_string<C, T> &right)
 {
     return basic_string<C, T>(left) >= right;
@@ -766,44 +661,13 @@ bool operator>=(const C *left,
 
 
 template <typename C, typename T>
-bool operator>=(const basic_string<C, T> &left,
+WTL_CONSTEXPR_DISPATCH bool operator>=(const basic_string<C, T> &left,
     const C *right)
 {
     return left >= basic_string<C, T>(right);
 }
 
 
-template <typename C, typename T>
-basic_string<C, T>::basic_string(const basic_string<C, T> &str):
-    data_(str.data()),
-    length_(str.length())
-{}
-
-
-template <typename C, typename T>
-basic_string<C, T> & basic_string<C, T>::operator=(const basic_string<C, T> &str)
-{
-    data_ = str.data_;
-    length_ = str.length_;
-    return *this;
-}
-
-
-template <typename C, typename T>
-basic_string<C, T>::basic_string(basic_string<C, T> &&str)
-{
-    swap(str);
-}
-
-
-template <typename C, typename T>
-basic_string<C, T> & basic_string<C, T>::operator=(basic_string<C, T> &&str)
-{
-    swap(str);
-    return *this;
-}
-
-
 template <typename C, typename T>
 basic_string<C, T>::basic_string(const std::basic_string<C, T> &str):
     data_(str.data()),
@@ -812,7 +676,7 @@ basic_string<C, T>::basic_string(const std::basic_string<C, T> &str):
 
 
 template <typename C, typename T>
-basic_string<C, T>::basic_string(const basic_string<C, T> &str,
+WTL_CONSTEXPR14 basic_string<C, T>::basic_string(const basic_string<C, T> &str,
     size_type pos,
     size_type len)
 {
@@ -840,24 +704,22 @@ basic_string<C, T>::basic_string(const std::basic_string<C, T> &str,
 
 
 template <typename C, typename T>
-basic_string<C, T>::basic_string(const C *str)
-{
-    data_ = str;
-    length_ = str ? traits_type::length(str) : 0;
-}
+WTL_CONSTEXPR_DISPATCH basic_string<C, T>::basic_string(const C *str):
+    data_(str),
+    length_(str ? detail::traits_length<traits_type>(str) : 0)
+{}
 
 
 template <typename C, typename T>
-basic_string<C, T>::basic_string(const C *str,
-    size_t n)
-{
-    data_ = str;
-    length_ = n;
-}
+constexpr basic_string<C, T>::basic_string(const C *str,
+        size_t n):
+    data_(str),
+    length_(n)
+{}
 
 
 template <typename C, typename T>
-basic_string<C, T>::basic_string(const C *begin,
+constexpr basic_string<C, T>::basic_string(const C *begin,
         const C *end):
     data_(begin),
     length_(end - begin)
@@ -873,7 +735,7 @@ basic_string<C, T> & basic_string<C, T>::operator=(const C *str)
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::begin() const
+constexpr auto basic_string<C, T>::begin() const
     -> const_iterator
 {
     return data_;
@@ -881,7 +743,7 @@ auto basic_string<C, T>::begin() const
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::end() const
+constexpr auto basic_string<C, T>::end() const
     -> const_iterator
 {
     return data_ + length_;
@@ -905,7 +767,7 @@ auto basic_string<C, T>::rend() const
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::cbegin() const
+constexpr auto basic_string<C, T>::cbegin() const
     -> const_iterator
 {
     return begin();
@@ -913,7 +775,7 @@ auto basic_string<C, T>::cbegin() const
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::cend() const
+constexpr auto basic_string<C, T>::cend() const
     -> const_iterator
 {
     return end();
@@ -937,37 +799,28 @@ auto basic_string<C, T>::crend() const
 
 
 template <typename C, typename T>
-size_t basic_string<C, T>::size() const
+constexpr size_t basic_string<C, T>::size() const
 {
     return length_;
 }
 
 
 template <typename C, typename T>
-size_t basic_string<C, T>::length() const
+constexpr size_t basic_string<C, T>::length() const
 {
     return length_;
 }
 
 
 template <typename C, typename T>
-bool basic_string<C, T>::empty() const noexcept
+constexpr bool basic_string<C, T>::empty() const noexcept
 {
     return length_ == 0;
 }
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::operator[](size_type pos)
-    -> reference
-{
-    assert(pos <= size() && "string index out of bounds");
-    return *const_cast<char*>(data_ + pos);
-}
-
-
-template <typename C, typename T>
-auto basic_string<C, T>::operator[](size_type pos) const
+WTL_CONSTEXPR14 auto basic_string<C, T>::operator[](size_type pos) const
     -> const_reference
 {
     assert(pos <= size() && "string index out of bounds");
@@ -976,15 +829,7 @@ auto basic_string<C, T>::operator[](size_type pos) const
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::at(size_type pos)
-    -> reference
-{
-    return operator[](pos);
-}
-
-
-template <typename C, typename T>
-auto basic_string<C, T>::at(size_type pos) const
+WTL_CONSTEXPR14 auto basic_string<C, T>::at(size_type pos) const
     -> const_reference
 {
     return operator[](pos);
@@ -992,16 +837,7 @@ auto basic_string<C, T>::at(size_type pos) const
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::front()
-    -> reference
-{
-    assert(!empty() && "string::front(): string is empty");
-    return *const_cast<char*>(data_);
-}
-
-
-template <typename C, typename T>
-auto basic_string<C, T>::front() const
+WTL_CONSTEXPR14 auto basic_string<C, T>::front() const
     -> const_reference
 {
     assert(!empty() && "string::front(): string is empty");
@@ -1010,16 +846,7 @@ auto basic_string<C, T>::front() const
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::back()
-    -> reference
-{
-    assert(!empty() && "string::back(): string is empty");
-    return *const_cast<char*>(data_ + length_ - 1);
-}
-
-
-template <typename C, typename T>
-auto basic_string<C, T>::back() const
+WTL_CONSTEXPR14 auto basic_string<C, T>::back() const
     -> const_reference
 {
     assert(!empty() && "string::back(): string is empty");
@@ -1179,7 +1006,7 @@ basic_string<C, T> basic_string<C, T>::operator-(const size_t shift)
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::c_str() const noexcept
+constexpr auto basic_string<C, T>::c_str() const noexcept
     -> const_pointer
 {
     return data_;
@@ -1187,7 +1014,7 @@ auto basic_string<C, T>::c_str() const noexcept
 
 
 template <typename C, typename T>
-auto basic_string<C, T>::data() const noexcept
+constexpr auto basic_string<C, T>::data() const noexcept
     -> const_pointer
 {
     return data_;
@@ -1195,9 +1022,15 @@ auto basic_string<C, T>::data() const noexcept
 
 
 template <typename C, typename T>
-size_t basic_string<C, T>::find(const basic_string<C, T> &str,
+WTL_CONSTEXPR_DISPATCH size_t basic_string<C, T>::find(const basic_string<C, T> &str,
     size_t pos) const noexcept
 {
+    if (pos > size()) {
+        return npos;
+    } else if (detail::constant_evaluated()) {
+        auto *found = detail::constexpr_find(data()+pos, size()-pos, str.data(), str.size());
+        return found ? found - data() : npos;
+    }
     auto *found = detail::find(data()+pos, size()-pos, str.data(), str.size());
     return found ? found - data() : npos;
 }
@@ -1207,40 +1040,45 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find(const std::string &str,
     size_t pos) const
 {
-    const char *first = str.data();
-    const size_t length = str.size();
-    auto *found = detail::find(data()+pos, size()-pos, first, length);
-    return found ? found - data() : npos;
+    return find(str.data(), pos, str.size());
 }
 
 
 template <typename C, typename T>
-size_t basic_string<C, T>::find(const char *array,
+WTL_CONSTEXPR_DISPATCH size_t basic_string<C, T>::find(const char *array,
     size_t pos) const
 {
-    const char *first = array;
-    const size_t length = strlen(array);
-    auto *found = detail::find(data()+pos, size()-pos, first, length);
-
-    return found ? found - data() : npos;
+    return find(array, pos, detail::traits_length<std::char_traits<char>>(array));
 }
 
 
 template <typename C, typename T>
-size_t basic_string<C, T>::find(const char *array,
+WTL_CONSTEXPR_DISPATCH size_t basic_string<C, T>::find(const char *array,
     size_t pos,
     size_t length) const
 {
+    if (pos > size()) {
+        return npos;
+    } else if (detail::constant_evaluated()) {
+        auto *found = detail::constexpr_find(data()+pos, size()-pos, array, length);
+        return found ? found - data() : npos;
+    }
     auto *found = detail::find(data()+pos, size()-pos, array, length);
     return found ? found - data() : npos;
 }
 
 
 template <typename C, typename T>
-size_t basic_string<C, T>::find(char c,
+WTL_CONSTEXPR_DISPATCH size_t basic_string<C, T>::find(char c,
     size_t pos) const noexcept
 {
-    auto *found = detail::find(data()+pos, size()-pos, &c, 1);
+    if (pos >= size()) {
+        return npos;
+    } else if (detail::constant_evaluated()) {
+        auto *found = detail::constexpr_find_char(data()+pos, size()-pos, C(c));
+        return found ? found - data() : npos;
+    }
+    auto *found = detail::find_char(data()+pos, size()-pos, c);
     return found ? found - data() : npos;
 }
 
@@ -1249,8 +1087,10 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_first_of(const basic_string<C, T> &str,
     size_t pos) const noexcept
 {
+    if (pos > size()) {
+        return npos;
+    }
     auto *found = detail::find_of(data()+pos, size()-pos, str.data(), str.size());
-
     return found ? found - data() : npos;
 }
 
@@ -1259,11 +1099,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_first_of(const std::string &str,
     size_t pos) const
 {
-    const char *first = str.data();
-    const size_t length = str.size();
-    auto *found = detail::find_of(data()+pos, size()-pos, first, length);
-
-    return found ? found - data() : npos;
+    return find_first_of(str.data(), pos, str.size());
 }
 
 
@@ -1271,11 +1107,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_first_of(const char *array,
     size_t pos) const
 {
-    const char *first = array;
-    const size_t length = strlen(array);
-    auto *found = detail::find_of(data()+pos, size()-pos, first, length);
-
-    return found ? found - data() : npos;
+    return find_first_of(array, pos, strlen(array));
 }
 
 
@@ -1284,6 +1116,9 @@ size_t basic_string<C, T>::find_first_of(const char *array,
     size_t pos,
     size_t length) const
 {
+    if (pos > size()) {
+        return npos;
+    }
     auto *found = detail::find_of(data()+pos, size()-pos, array, length);
     return found ? found - data() : npos;
 }
@@ -1293,7 +1128,22 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_first_of(char c,
     size_t pos) const noexcept
 {
-    auto *found = detail::find_of(data()+pos, size()-pos, &c, 1);
+    if (pos >= size()) {
+        return npos;
+    }
+    auto *found = detail::find_char(data()+pos, size()-pos, c);
+    return found ? found - data() : npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_string<C, T>::find_first_of(const byteset &set,
+    size_t pos) const noexcept
+{
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = set.find_first_of(data()+pos, size()-pos);
     return found ? found - data() : npos;
 }
 
@@ -1302,8 +1152,10 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_first_not_of(const basic_string<C, T> &str,
     size_t pos) const noexcept
 {
+    if (pos > size()) {
+        return npos;
+    }
     auto *found = detail::find_not_of(data()+pos, size()-pos, str.data(), str.size());
-
     return found ? found - data() : npos;
 }
 
@@ -1312,11 +1164,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_first_not_of(const std::string &str,
     size_t pos) const
 {
-    const char *first = str.data();
-    const size_t length = str.size();
-    auto *found = detail::find_not_of(data()+pos, size()-pos, first, length);
-
-    return found ? found - data() : npos;
+    return find_first_not_of(str.data(), pos, str.size());
 }
 
 
@@ -1324,11 +1172,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_first_not_of(const char *array,
     size_t pos) const
 {
-    const char *first = array;
-    const size_t length = strlen(array);
-    auto *found = detail::find_not_of(data()+pos, size()-pos, first, length);
-
-    return found ? found - data() : npos;
+    return find_first_not_of(array, pos, strlen(array));
 }
 
 
@@ -1337,6 +1181,9 @@ size_t basic_string<C, T>::find_first_not_of(const char *array,
     size_t pos,
     size_t length) const
 {
+    if (pos > size()) {
+        return npos;
+    }
     auto *found = detail::find_not_of(data()+pos, size()-pos, array, length);
     return found ? found - data() : npos;
 }
@@ -1346,16 +1193,34 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_first_not_of(char c,
     size_t pos) const noexcept
 {
+    if (pos >= size()) {
+        return npos;
+    }
     auto *found = detail::find_not_of(data()+pos, size()-pos, &c, 1);
     return found ? found - data() : npos;
 }
 
 
+template <typename C, typename T>
+size_t basic_string<C, T>::find_first_not_of(const byteset &set,
+    size_t pos) const noexcept
+{
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = set.find_first_not_of(data()+pos, size()-pos);
+    return found ? found - data() : npos;
+}
+
+
 template <typename C, typename T>
 size_t basic_string<C, T>::rfind(const basic_string<C, T> &str,
     size_t pos) const noexcept
 {
-    auto *found = detail::rfind(end(), size()-pos, str.data(), str.size());
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = detail::rfind(data()+pos, size()-pos, str.data(), str.size());
     return found ? found - data() : npos;
 }
 
@@ -1364,11 +1229,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::rfind(const std::string &str,
     size_t pos) const
 {
-    const char *first = str.data();
-    const size_t length = str.size();
-    auto *found = detail::rfind(end(), size()-pos, first, length);
-
-    return found ? found - data() : npos;
+    return rfind(str.data(), pos, str.size());
 }
 
 
@@ -1376,11 +1237,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::rfind(const char *array,
     size_t pos) const
 {
-    const char *first = array;
-    const size_t length = strlen(array);
-    auto *found = detail::rfind(end(), size()-pos, first, length);
-
-    return found ? found - data() : npos;
+    return rfind(array, pos, strlen(array));
 }
 
 
@@ -1389,7 +1246,10 @@ size_t basic_string<C, T>::rfind(const char *array,
     size_t pos,
     size_t length) const
 {
-    auto *found = detail::rfind(end(), size()-pos, array, length);
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = detail::rfind(data()+pos, size()-pos, array, length);
     return found ? found - data() : npos;
 }
 
@@ -1398,7 +1258,10 @@ template <typename C, typename T>
 size_t basic_string<C, T>::rfind(char c,
     size_t pos) const noexcept
 {
-    auto *found = detail::rfind(end(), size()-pos, &c, 1);
+    if (pos >= size()) {
+        return npos;
+    }
+    auto *found = detail::rfind_char(data()+pos, size()-pos, c);
     return found ? found - data() : npos;
 }
 
@@ -1407,7 +1270,10 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_last_of(const basic_string<C, T> &str,
     size_t pos) const noexcept
 {
-    auto *found = detail::rfind_of(end(), size()-pos, str.data(), str.size());
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = detail::rfind_of(data()+pos, size()-pos, str.data(), str.size());
     return found ? found - data() : npos;
 }
 
@@ -1416,10 +1282,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_last_of(const std::string &str,
     size_t pos) const
 {
-    const char *first = str.data();
-    const size_t length = str.size();
-    auto *found = detail::rfind_of(end(), size()-pos, first, length);
-    return found ? found - data() : npos;
+    return find_last_of(str.data(), pos, str.size());
 }
 
 
@@ -1427,11 +1290,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_last_of(const char *array,
     size_t pos) const
 {
-    const char *first = array;
-    const size_t length = strlen(array);
-    auto *found = detail::rfind_of(end(), size()-pos, first, length);
-
-    return found ? found - data() : npos;
+    return find_last_of(array, pos, strlen(array));
 }
 
 
@@ -1440,7 +1299,10 @@ size_t basic_string<C, T>::find_last_of(const char *array,
     size_t pos,
     size_t length) const
 {
-    auto *found = detail::rfind_of(end(), size()-pos, array, length);
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = detail::rfind_of(data()+pos, size()-pos, array, length);
     return found ? found - data() : npos;
 }
 
@@ -1449,17 +1311,34 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_last_of(char c,
     size_t pos) const noexcept
 {
-    auto *found = detail::rfind_of(end(), size()-pos, &c, 1);
+    if (pos >= size()) {
+        return npos;
+    }
+    auto *found = detail::rfind_char(data()+pos, size()-pos, c);
     return found ? found - data() : npos;
 }
 
 
 template <typename C, typename T>
-size_t basic_string<C, T>::find_last_not_of(const basic_string<C, T> &str,
+size_t basic_string<C, T>::find_last_of(const byteset &set,
     size_t pos) const noexcept
 {
-    auto *found = detail::rfind_not_of(end(), size()-pos, str.data(), str.size());
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = set.find_last_of(data()+pos, size()-pos);
+    return found ? found - data() : npos;
+}
 
+
+template <typename C, typename T>
+size_t basic_string<C, T>::find_last_not_of(const basic_string<C, T> &str,
+    size_t pos) const noexcept
+{
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = detail::rfind_not_of(data()+pos, size()-pos, str.data(), str.size());
     return found ? found - data() : npos;
 }
 
@@ -1468,10 +1347,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_last_not_of(const std::string &str,
     size_t pos) const
 {
-    const char *first = str.data();
-    const size_t length = str.size();
-    auto *found = detail::rfind_not_of(end(), size()-pos, first, length);
-    return found ? found - data() : npos;
+    return find_last_not_of(str.data(), pos, str.size());
 }
 
 
@@ -1479,11 +1355,7 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_last_not_of(const char *array,
     size_t pos) const
 {
-    const char *first = array;
-    const size_t length = strlen(array);
-    auto *found = detail::rfind_not_of(end(), size()-pos, first, length);
-
-    return found ? found - data() : npos;
+    return find_last_not_of(array, pos, strlen(array));
 }
 
 
@@ -1492,7 +1364,10 @@ size_t basic_string<C, T>::find_last_not_of(const char *array,
     size_t pos,
     size_t length) const
 {
-    auto *found = detail::rfind_not_of(end(), size()-pos, array, length);
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = detail::rfind_not_of(data()+pos, size()-pos, array, length);
     return found ? found - data() : npos;
 }
 
@@ -1501,17 +1376,82 @@ template <typename C, typename T>
 size_t basic_string<C, T>::find_last_not_of(char c,
     size_t pos) const noexcept
 {
-    auto *found = detail::rfind_not_of(end(), size()-pos, &c, 1);
+    if (pos >= size()) {
+        return npos;
+    }
+    auto *found = detail::rfind_not_of(data()+pos, size()-pos, &c, 1);
+    return found ? found - data() : npos;
+}
+
+
+template <typename C, typename T>
+size_t basic_string<C, T>::find_last_not_of(const byteset &set,
+    size_t pos) const noexcept
+{
+    if (pos > size()) {
+        return npos;
+    }
+    auto *found = set.find_last_not_of(data()+pos, size()-pos);
     return found ? found - data() : npos;
 }
 
 
 template <typename C, typename T>
-int basic_string<C, T>::compare(const basic_string<C, T> &str) const noexcept
+size_t basic_string<C, T>::count(C c) const noexcept
+{
+    return detail::count_char(data(), size(), c);
+}
+
+
+/** \brief Count non-overlapping occurrences of `str`.
+ *
+ *  As in Python, an empty `str` occurs `size() + 1` times.
+ */
+template <typename C, typename T>
+size_t basic_string<C, T>::count(const basic_string<C, T> &str) const noexcept
+{
+    if (str.empty()) {
+        return size() + 1;
+    }
+
+    size_t count = 0;
+    const C *first = data();
+    const C *last = data() + size();
+    while (const C *found = detail::find(first, last - first, str.data(), str.size())) {
+        ++count;
+        first = found + str.size();
+    }
+    return count;
+}
+
+
+template <typename C, typename T>
+size_t basic_string<C, T>::count_of(const byteset &set) const noexcept
+{
+    return set.count(data(), size());
+}
+
+
+template <typename C, typename T>
+bool basic_string<C, T>::contains(C c) const noexcept
+{
+    return detail::find_value(data(), size(), c) != nullptr;
+}
+
+
+template <typename C, typename T>
+bool basic_string<C, T>::contains(const basic_string<C, T> &str) const noexcept
+{
+    return str.empty() || detail::find(data(), size(), str.data(), str.size()) != nullptr;
+}
+
+
+template <typename C, typename T>
+WTL_CONSTEXPR_DISPATCH int basic_string<C, T>::compare(const basic_string<C, T> &str) const noexcept
 {
     size_t left_size = size();
     size_t right_size = str.size();
-    int result = traits_type::compare(data(), str.data(), std::min(left_size, right_size));
+    int result = detail::traits_compare<traits_type>(data(), str.data(), std::min(left_size, right_size));
     if (result != 0) {
         return result;
     } else if (left_size < right_size) {
@@ -1571,7 +1511,7 @@ int basic_string<C, T>::compare(size_type pos,
 
 
 template <typename C, typename T>
-int basic_string<C, T>::compare(const C *s) const
+WTL_CONSTEXPR_DISPATCH int basic_string<C, T>::compare(const C *s) const
 {
     return compare(basic_string<C, T>(s));
 }
@@ -1597,7 +1537,7 @@ int basic_string<C, T>::compare(size_type pos,
 
 
 template <typename C, typename T>
-basic_string<C, T> basic_string<C, T>::substr(size_type pos,
+WTL_CONSTEXPR14 basic_string<C, T> basic_string<C, T>::substr(size_type pos,
     size_type len) const
 {
     return basic_string<C, T>(*this, pos, len);
@@ -1625,4 +1565,7 @@ typedef basic_string<wchar_t> wstring;
 typedef basic_string<char16_t> u16string;
 typedef basic_string<char32_t> u32string;
 
+static_assert(std::is_trivially_copyable<string>::value, "wtl::string must be trivially copyable.");
+static_assert(sizeof(string) == 2 * sizeof(void*), "wtl::string must be a pointer and a length.");
+
 }   /* wtl */
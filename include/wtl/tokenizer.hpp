@@ -0,0 +1,236 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/byteset.hpp>
+#include <wtl/split.hpp>
+#include <wtl/string.hpp>
+#include <wtl/vector.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace wtl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Batch tokenizer writing every token boundary at once.
+ *
+ *  Tokenizing runs in two stages over chunks of the input. First the
+ *  byteset classifies the chunk into a delimiter bitmap, 64 bytes per
+ *  word. Then the bitmap is scanned for token edges with bit tricks,
+ *  writing an `(offset, length)` pair of `uint32_t` per token. There
+ *  is no per-byte branch, and nothing is allocated.
+ *
+ *  Empty tokens are skipped by default, which suits whitespace, and
+ *  kept with `split_empty::keep`, which suits delimited fields.
+ */
+class tokenizer
+{
+protected:
+    byteset delimiters_;
+    split_empty empty_;
+
+    size_t tokenize_skip(const string &str,
+        uint32_t *offsets,
+        size_t capacity) const;
+    size_t tokenize_keep(const string &str,
+        uint32_t *offsets,
+        size_t capacity) const;
+
+public:
+    // MEMBER FUNCTIONS
+    // ----------------
+    tokenizer(const byteset &delimiters,
+        split_empty empty = split_empty::skip);
+
+    // PROPERTIES
+    const byteset & delimiters() const noexcept;
+    split_empty empty_tokens() const noexcept;
+
+    // TOKENIZE
+    static size_t bound(size_t length) noexcept;
+    size_t tokenize(const string &str,
+        uint32_t *offsets,
+        size_t capacity) const;
+    vector<uint32_t> tokens(const string &str,
+        uint32_t *offsets,
+        size_t capacity) const;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+namespace detail
+{
+// HELPERS
+// -------
+
+static const size_t tokenizer_chunk = 4096;
+
+
+inline void tokenizer_overflow()
+{
+    throw std::length_error("tokenizer::tokenize().");
+}
+
+}   /* detail */
+
+
+inline tokenizer::tokenizer(const byteset &delimiters,
+        split_empty empty):
+    delimiters_(delimiters),
+    empty_(empty)
+{}
+
+
+inline const byteset & tokenizer::delimiters() const noexcept
+{
+    return delimiters_;
+}
+
+
+inline split_empty tokenizer::empty_tokens() const noexcept
+{
+    return empty_;
+}
+
+
+/** \brief Number of `uint32_t` sufficient for any input of `length` bytes.
+ */
+inline size_t tokenizer::bound(size_t length) noexcept
+{
+    return 2 * (length + 1);
+}
+
+
+/** \brief Each edge between delimiter and token bytes starts or ends a token.
+ *
+ *  Edges alternate, so they are written in order, and each end is
+ *  converted to a length by subtracting the preceding start.
+ */
+inline size_t tokenizer::tokenize_skip(const string &str,
+    uint32_t *offsets,
+    size_t capacity) const
+{
+    uint64_t bits[detail::tokenizer_chunk / 64];
+    const size_t length = str.size();
+    size_t count = 0;
+    uint32_t previous = 0;
+    uint64_t carry = 0;
+
+    for (size_t chunk = 0; chunk < length; chunk += detail::tokenizer_chunk) {
+        const size_t size = std::min(length - chunk, detail::tokenizer_chunk);
+        const size_t words = (size + 63) / 64;
+        delimiters_.classify(str.data() + chunk, size, bits);
+
+        for (size_t i = 0; i < words; ++i) {
+            const size_t base = chunk + 64 * i;
+            uint64_t token = ~bits[i];
+            if (length - base < 64) {
+                token &= (uint64_t(1) << (length - base)) - 1;
+            }
+            uint64_t edges = token ^ ((token << 1) | carry);
+            carry = token >> 63;
+            if (capacity - count < 64 && capacity - count < detail::popcount64(edges)) {
+                detail::tokenizer_overflow();
+            }
+            while (edges) {
+                uint32_t position = static_cast<uint32_t>(base + detail::ctz64(edges));
+                offsets[count] = position - ((count & 1) ? previous : 0);
+                previous = position;
+                ++count;
+                edges &= edges - 1;
+            }
+        }
+    }
+
+    if (count & 1) {
+        // the last token ends on a word boundary, so no edge closed it
+        if (count + 1 > capacity) {
+            detail::tokenizer_overflow();
+        }
+        offsets[count] = static_cast<uint32_t>(length) - previous;
+        ++count;
+    }
+    return count / 2;
+}
+
+
+/** \brief Every delimiter ends a token, and the next byte starts one.
+ */
+inline size_t tokenizer::tokenize_keep(const string &str,
+    uint32_t *offsets,
+    size_t capacity) const
+{
+    uint64_t bits[detail::tokenizer_chunk / 64];
+    const size_t length = str.size();
+    size_t count = 0;
+    uint32_t start = 0;
+
+    for (size_t chunk = 0; chunk < length; chunk += detail::tokenizer_chunk) {
+        const size_t size = std::min(length - chunk, detail::tokenizer_chunk);
+        const size_t words = (size + 63) / 64;
+        delimiters_.classify(str.data() + chunk, size, bits);
+
+        for (size_t i = 0; i < words; ++i) {
+            const size_t base = chunk + 64 * i;
+            uint64_t delimiter = bits[i];
+            if (capacity - count < 128 && capacity - count < 2 * detail::popcount64(delimiter)) {
+                detail::tokenizer_overflow();
+            }
+            while (delimiter) {
+                uint32_t position = static_cast<uint32_t>(base + detail::ctz64(delimiter));
+                offsets[count++] = start;
+                offsets[count++] = position - start;
+                start = position + 1;
+                delimiter &= delimiter - 1;
+            }
+        }
+    }
+
+    if (count + 2 > capacity) {
+        detail::tokenizer_overflow();
+    }
+    offsets[count++] = start;
+    offsets[count++] = static_cast<uint32_t>(length) - start;
+    return count / 2;
+}
+
+
+/** \brief Write `(offset, length)` pairs for each token of `str`.
+ *
+ *  Returns the number of tokens, and throws `std::length_error` if
+ *  `str` is 4 GiB or larger, or if the pairs do not fit in `capacity`
+ *  integers. `bound` gives a capacity that always suffices.
+ */
+inline size_t tokenizer::tokenize(const string &str,
+    uint32_t *offsets,
+    size_t capacity) const
+{
+    if (str.size() > UINT32_MAX) {
+        detail::tokenizer_overflow();
+    }
+    if (empty_ == split_empty::skip) {
+        return tokenize_skip(str, offsets, capacity);
+    }
+    return tokenize_keep(str, offsets, capacity);
+}
+
+
+/** \brief Tokenize, returning a view of the pairs written to `offsets`.
+ */
+inline vector<uint32_t> tokenizer::tokens(const string &str,
+    uint32_t *offsets,
+    size_t capacity) const
+{
+    size_t count = tokenize(str, offsets, capacity);
+    return vector<uint32_t>(offsets, 2 * count);
+}
+
+}   /* wtl */
@@ -0,0 +1,593 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#pragma once
+
+#include <wtl/dispatch.hpp>
+#include <wtl/string.hpp>
+#include <wtl/detail/simd.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace wtl
+{
+namespace utf8
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Check UTF-8 fed in chunks, carrying sequences split between them.
+ *
+ *  Up to 3 bytes of a sequence cut by the end of a chunk are kept, and
+ *  completed from the start of the next one. The rest of each chunk is
+ *  checked in place by `validate`.
+ */
+class stream_validator
+{
+protected:
+    char pending_[4];
+    size_t pending_size_ = 0;
+    size_t offset_ = 0;
+    size_t valid_ = 0;
+    bool failed_ = false;
+
+public:
+    // PROPERTIES
+    size_t offset() const noexcept;
+    size_t valid_size() const noexcept;
+    size_t pending() const noexcept;
+    bool failed() const noexcept;
+
+    // STREAM
+    bool feed(const string &chunk) noexcept;
+    bool finish() noexcept;
+    void reset() noexcept;
+};
+
+size_t validate(const string &str) noexcept;
+
+}   /* utf8 */
+
+// IMPLEMENTATION
+// --------------
+
+namespace detail
+{
+// SCALAR
+// ------
+
+
+/** \brief Length of the sequence started by `lead`, or 0 if it cannot start one.
+ */
+inline size_t utf8_length(unsigned char lead) noexcept
+{
+    if (lead < 0x80) {
+        return 1;
+    } else if (lead < 0xC2) {
+        return 0;
+    } else if (lead < 0xE0) {
+        return 2;
+    } else if (lead < 0xF0) {
+        return 3;
+    } else if (lead < 0xF5) {
+        return 4;
+    }
+    return 0;
+}
+
+
+/** \brief Check the second byte of a multibyte sequence.
+ *
+ *  Besides being a continuation byte, it excludes overlong forms after
+ *  `E0` and `F0`, surrogates after `ED`, and code points past U+10FFFF
+ *  after `F4`.
+ */
+inline bool utf8_second_byte(unsigned char lead,
+    unsigned char c) noexcept
+{
+    unsigned char lower = 0x80;
+    unsigned char upper = 0xBF;
+    if (lead == 0xE0) {
+        lower = 0xA0;
+    } else if (lead == 0xED) {
+        upper = 0x9F;
+    } else if (lead == 0xF0) {
+        lower = 0x90;
+    } else if (lead == 0xF4) {
+        upper = 0x8F;
+    }
+    return c >= lower && c <= upper;
+}
+
+
+/** \brief Check the first `length` bytes of a sequence, complete or not.
+ */
+inline bool utf8_prefix(const char *first,
+    size_t length) noexcept
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char*>(first);
+    if (length > 1 && !utf8_second_byte(bytes[0], bytes[1])) {
+        return false;
+    }
+    for (size_t i = 2; i < length; ++i) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/** \brief Length of the valid sequence at `first`, or 0.
+ */
+inline size_t utf8_sequence(const char *first,
+    size_t available) noexcept
+{
+    const size_t length = utf8_length(static_cast<unsigned char>(*first));
+    if (length == 0 || length > available || !utf8_prefix(first, length)) {
+        return 0;
+    }
+    return length;
+}
+
+
+/** \brief Check the bytes are the start of a valid sequence, cut short.
+ */
+inline bool utf8_truncated(const char *first,
+    size_t available) noexcept
+{
+    const size_t length = utf8_length(static_cast<unsigned char>(*first));
+    return length > available && utf8_prefix(first, available);
+}
+
+
+/** \brief Offset of the first invalid sequence, or `length`.
+ *
+ *  Skips 8 bytes at a time while they are ASCII.
+ */
+inline size_t utf8_validate_scalar(const char *first,
+    size_t length) noexcept
+{
+    size_t i = 0;
+    while (i < length) {
+        uint64_t word;
+        if (i + 8 <= length && (std::memcpy(&word, first + i, 8), !(word & 0x8080808080808080))) {
+            i += 8;
+            continue;
+        }
+        const size_t n = utf8_sequence(first + i, length - i);
+        if (n == 0) {
+            return i;
+        }
+        i += n;
+    }
+    return length;
+}
+
+
+/** \brief Find the exact offset of an error in the block at `offset`.
+ *
+ *  Everything before the block is valid, except perhaps a sequence
+ *  started in its last 3 bytes, so the scalar check restarts at the
+ *  first character boundary among them.
+ */
+inline size_t utf8_locate(const char *first,
+    size_t length,
+    size_t offset) noexcept
+{
+    size_t start = offset < 3 ? 0 : offset - 3;
+    while (start < offset && (static_cast<unsigned char>(first[start]) & 0xC0) == 0x80) {
+        ++start;
+    }
+    return start + utf8_validate_scalar(first + start, length - start);
+}
+
+// LOOKUP
+// ------
+
+// Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per
+// Byte". Three 16-entry lookups, on the high and low nibbles of the
+// previous byte and the high nibble of the current one, each map to a
+// set of the errors a byte pair may be part of. A pair is invalid when
+// all three sets share an error. Bit 7 instead marks two consecutive
+// continuation bytes, which must match the third and fourth bytes of
+// the 3 and 4-byte sequences found from the bytes 2 and 3 back.
+
+enum : uint8_t
+{
+    utf8_too_short = 1 << 0,
+    utf8_too_long = 1 << 1,
+    utf8_overlong_3 = 1 << 2,
+    utf8_too_large = 1 << 3,
+    utf8_surrogate = 1 << 4,
+    utf8_overlong_2 = 1 << 5,
+    utf8_too_large_1000 = 1 << 6,
+    utf8_overlong_4 = 1 << 6,
+    utf8_two_conts = 1 << 7,
+    utf8_carry = utf8_too_short | utf8_too_long | utf8_two_conts,
+};
+
+
+/** \brief The three 16-byte lookup tables, then the incomplete-sequence bounds.
+ *
+ *  The last 32 bytes are the largest value of each position that does
+ *  not start a sequence running past a block, for the last 32 or 16
+ *  bytes of a block.
+ */
+inline const uint8_t * utf8_tables() noexcept
+{
+    static const uint8_t tables[80] = {
+        // high nibble of the previous byte
+        utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+        utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+        utf8_two_conts, utf8_two_conts, utf8_two_conts, utf8_two_conts,
+        utf8_too_short | utf8_overlong_2,
+        utf8_too_short,
+        utf8_too_short | utf8_overlong_3 | utf8_surrogate,
+        utf8_too_short | utf8_too_large | utf8_too_large_1000 | utf8_overlong_4,
+
+        // low nibble of the previous byte
+        utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4,
+        utf8_carry | utf8_overlong_2,
+        utf8_carry,
+        utf8_carry,
+        utf8_carry | utf8_too_large,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000 | utf8_surrogate,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+
+        // high nibble of the current byte
+        utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+        utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+        utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large_1000 | utf8_overlong_4,
+        utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large,
+        utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+        utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+        utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+
+        // incomplete-sequence bounds
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+    };
+    return tables;
+}
+
+#if defined(WTL_X86)
+
+/** \brief Keiser-Lemire validation of 16-byte vectors.
+ */
+struct utf8_ssse3
+{
+    __m128i byte_1_high;
+    __m128i byte_1_low;
+    __m128i byte_2_high;
+    __m128i max_value;
+    __m128i prev_input;
+    __m128i prev_incomplete;
+
+    WTL_TARGET_SSSE3
+    utf8_ssse3() noexcept
+    {
+        const uint8_t *tables = utf8_tables();
+        byte_1_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables));
+        byte_1_low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 16));
+        byte_2_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 32));
+        max_value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 64));
+        prev_input = _mm_setzero_si128();
+        prev_incomplete = _mm_setzero_si128();
+    }
+
+    WTL_TARGET_SSSE3
+    static __m128i high_nibble(__m128i v) noexcept
+    {
+        return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+    }
+
+    /** \brief Error bits of the pairs and sequences ending in `input`.
+     */
+    WTL_TARGET_SSSE3
+    __m128i check(__m128i input,
+        __m128i prev) const noexcept
+    {
+        const __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+        const __m128i special = _mm_and_si128(
+            _mm_and_si128(_mm_shuffle_epi8(byte_1_high, high_nibble(prev1)),
+                _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, _mm_set1_epi8(0x0F)))),
+            _mm_shuffle_epi8(byte_2_high, high_nibble(input)));
+
+        const __m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+        const __m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+        const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+        const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+        const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+        return _mm_xor_si128(must23, special);
+    }
+
+    /** \brief Check 64 bytes, returning true on an error.
+     */
+    WTL_TARGET_SSSE3
+    bool block(const char *first) noexcept
+    {
+        const __m128i *data = reinterpret_cast<const __m128i*>(first);
+        const __m128i v0 = _mm_loadu_si128(data);
+        const __m128i v1 = _mm_loadu_si128(data + 1);
+        const __m128i v2 = _mm_loadu_si128(data + 2);
+        const __m128i v3 = _mm_loadu_si128(data + 3);
+        __m128i error;
+        if (!_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3)))) {
+            // ASCII, which only fails if a sequence was left incomplete
+            error = prev_incomplete;
+        } else {
+            error = _mm_or_si128(_mm_or_si128(check(v0, prev_input), check(v1, v0)),
+                _mm_or_si128(check(v2, v1), check(v3, v2)));
+            prev_incomplete = _mm_subs_epu8(v3, max_value);
+        }
+        prev_input = v3;
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF;
+    }
+};
+
+
+/** \brief Keiser-Lemire validation of 32-byte vectors.
+ */
+struct utf8_avx2
+{
+    __m256i byte_1_high;
+    __m256i byte_1_low;
+    __m256i byte_2_high;
+    __m256i max_value;
+    __m256i prev_input;
+    __m256i prev_incomplete;
+
+    WTL_TARGET_AVX2
+    utf8_avx2() noexcept
+    {
+        const uint8_t *tables = utf8_tables();
+        byte_1_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables)));
+        byte_1_low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 16)));
+        byte_2_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 32)));
+        max_value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables + 48));
+        prev_input = _mm256_setzero_si256();
+        prev_incomplete = _mm256_setzero_si256();
+    }
+
+    WTL_TARGET_AVX2
+    static __m256i high_nibble(__m256i v) noexcept
+    {
+        return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+    }
+
+    /** \brief Error bits of the pairs and sequences ending in `input`.
+     *
+     *  The byte shifts cross lanes by aligning against the high lane of
+     *  `prev` and the low lane of `input`.
+     */
+    WTL_TARGET_AVX2
+    __m256i check(__m256i input,
+        __m256i prev) const noexcept
+    {
+        const __m256i shifted = _mm256_permute2x128_si256(prev, input, 0x21);
+        const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+        const __m256i special = _mm256_and_si256(
+            _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, high_nibble(prev1)),
+                _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)))),
+            _mm256_shuffle_epi8(byte_2_high, high_nibble(input)));
+
+        const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+        const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+        const __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+        const __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+        const __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+        return _mm256_xor_si256(must23, special);
+    }
+
+    /** \brief Check 64 bytes, returning true on an error.
+     */
+    WTL_TARGET_AVX2
+    bool block(const char *first) noexcept
+    {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + 32));
+        __m256i error;
+        if (!_mm256_movemask_epi8(_mm256_or_si256(v0, v1))) {
+            // ASCII, which only fails if a sequence was left incomplete
+            error = prev_incomplete;
+        } else {
+            error = _mm256_or_si256(check(v0, prev_input), check(v1, v0));
+            prev_incomplete = _mm256_subs_epu8(v1, max_value);
+        }
+        prev_input = v1;
+        return !_mm256_testz_si256(error, error);
+    }
+};
+
+
+WTL_TARGET_SSSE3
+inline size_t utf8_validate_ssse3(const char *first,
+    size_t length) noexcept
+{
+    utf8_ssse3 validator;
+    size_t offset = 0;
+    for (; offset + 64 <= length; offset += 64) {
+        if (validator.block(first + offset)) {
+            return utf8_locate(first, length, offset);
+        }
+    }
+    // the zeros are ASCII, so they also catch a truncated sequence
+    char tail[64] = {};
+    std::memcpy(tail, first + offset, length - offset);
+    if (validator.block(tail)) {
+        return utf8_locate(first, length, offset);
+    }
+    return length;
+}
+
+
+WTL_TARGET_AVX2
+inline size_t utf8_validate_avx2(const char *first,
+    size_t length) noexcept
+{
+    utf8_avx2 validator;
+    size_t offset = 0;
+    for (; offset + 64 <= length; offset += 64) {
+        if (validator.block(first + offset)) {
+            return utf8_locate(first, length, offset);
+        }
+    }
+    // the zeros are ASCII, so they also catch a truncated sequence
+    char tail[64] = {};
+    std::memcpy(tail, first + offset, length - offset);
+    if (validator.block(tail)) {
+        return utf8_locate(first, length, offset);
+    }
+    return length;
+}
+
+#endif
+
+inline size_t utf8_validate(const char *first,
+    size_t length) noexcept
+{
+    typedef size_t (*kernel)(const char *, size_t);
+#if defined(WTL_X86)
+    static const kernel table[isa_levels] = {
+        &utf8_validate_scalar, &utf8_validate_scalar, &utf8_validate_ssse3, &utf8_validate_avx2, &utf8_validate_avx2,
+    };
+#else
+    static const kernel table[isa_levels] = {
+        &utf8_validate_scalar, &utf8_validate_scalar, &utf8_validate_scalar, &utf8_validate_scalar, &utf8_validate_scalar,
+    };
+#endif
+    return dispatch(table)(first, length);
+}
+
+}   /* detail */
+
+namespace utf8
+{
+
+/** \brief Offset of the first byte not part of a valid UTF-8 sequence.
+ *
+ *  Every byte before the offset is valid UTF-8, and the offset is the
+ *  start of an invalid or truncated sequence. Valid strings return
+ *  `str.size()`.
+ *
+ *  Uses the lookup-table algorithm of Keiser and Lemire, 64 bytes at a
+ *  time, and skips blocks of ASCII with a single test. Only a block
+ *  with an error is checked again, byte by byte, to locate it.
+ */
+inline size_t validate(const string &str) noexcept
+{
+    return detail::utf8_validate(str.data(), str.size());
+}
+
+
+/** \brief Bytes fed since construction or the last `reset`.
+ */
+inline size_t stream_validator::offset() const noexcept
+{
+    return offset_;
+}
+
+
+/** \brief Bytes from the start of the stream known to be valid.
+ *
+ *  After a failure, this is the offset of the first invalid byte.
+ */
+inline size_t stream_validator::valid_size() const noexcept
+{
+    return valid_;
+}
+
+
+/** \brief Bytes of a sequence cut by the end of the last chunk.
+ */
+inline size_t stream_validator::pending() const noexcept
+{
+    return pending_size_;
+}
+
+
+inline bool stream_validator::failed() const noexcept
+{
+    return failed_;
+}
+
+
+/** \brief Feed the next chunk, returning false once the stream is invalid.
+ */
+inline bool stream_validator::feed(const string &chunk) noexcept
+{
+    const char *data = chunk.data();
+    const size_t length = chunk.size();
+    const size_t base = offset_;
+    offset_ += length;
+    if (failed_) {
+        return false;
+    }
+
+    // complete a sequence from earlier chunks
+    size_t i = 0;
+    while (pending_size_ && i < length) {
+        pending_[pending_size_++] = data[i++];
+        if (detail::utf8_sequence(pending_, pending_size_)) {
+            valid_ += pending_size_;
+            pending_size_ = 0;
+        } else if (!detail::utf8_truncated(pending_, pending_size_)) {
+            failed_ = true;
+            return false;
+        }
+    }
+    if (pending_size_) {
+        return true;
+    }
+
+    const size_t rest = length - i;
+    const size_t index = detail::utf8_validate(data + i, rest);
+    valid_ = base + i + index;
+    if (index != rest) {
+        if (detail::utf8_truncated(data + i + index, rest - index)) {
+            pending_size_ = rest - index;
+            std::memcpy(pending_, data + i + index, pending_size_);
+        } else {
+            failed_ = true;
+        }
+    }
+    return !failed_;
+}
+
+
+/** \brief End the stream, returning false if it is invalid or ends mid-sequence.
+ */
+inline bool stream_validator::finish() noexcept
+{
+    failed_ = failed_ || pending_size_ != 0;
+    return !failed_;
+}
+
+
+/** \brief Start a new stream.
+ */
+inline void stream_validator::reset() noexcept
+{
+    pending_size_ = 0;
+    offset_ = 0;
+    valid_ = 0;
+    failed_ = false;
+}
+
+}   /* utf8 */
+}   /* wtl */
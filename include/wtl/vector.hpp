@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <wtl/detail/constexpr.hpp>
+#include <wtl/detail/count.hpp>
+
+#include <type_traits>
 #include <vector>
 
 
@@ -113,56 +117,57 @@ public:
     // MEMBER TYPES
     // ------------
     typedef T value_type;
-    typedef T& reference;
+    typedef const T& reference;
     typedef const T& const_reference;
-    typedef T* pointer;
+    typedef const T* pointer;
     typedef const T* const_pointer;
     typedef std::ptrdiff_t difference_type;
     typedef size_t size_type;
-    typedef pointer iterator;
+    typedef const_pointer iterator;
     typedef const_pointer const_iterator;
-    typedef std::reverse_iterator<pointer> reverse_iterator;
+    typedef std::reverse_iterator<const_pointer> reverse_iterator;
     typedef std::reverse_iterator<const_pointer> const_reverse_iterator;
 
     // MEMBER FUNCTIONS
     // ----------------
     vector() = default;
-    vector(const vector<T> &vector);
-    vector<T> & operator=(const vector<T> &vector);
-    vector(vector<T> &&vector);
-    vector<T> & operator=(vector<T> &&vector);
+    vector(const vector<T> &vector) = default;
+    vector<T> & operator=(const vector<T> &vector) = default;
+    vector(vector<T> &&vector) = default;
+    vector<T> & operator=(vector<T> &&vector) = default;
 
     vector(const std::vector<T> &vector);
     vector<T> & operator=(const std::vector<T> &vector);
-    vector(const T *t,
+    constexpr vector(const T *t,
         size_type n);
-    vector(const T *first,
+    constexpr vector(const T *first,
         const T *last);
 
     // ITERATORS
-    const_iterator begin() const;
-    const_iterator end() const;
+    constexpr const_iterator begin() const;
+    constexpr const_iterator end() const;
     const_reverse_iterator rbegin() const;
     const_reverse_iterator rend() const;
-    const_iterator cbegin() const;
-    const_iterator cend() const;
+    constexpr const_iterator cbegin() const;
+    constexpr const_iterator cend() const;
     const_reverse_iterator crbegin() const;
     const_reverse_iterator crend() const;
 
     // CAPACITY
-    size_t size() const;
-    bool empty() const noexcept;
+    constexpr size_t size() const;
+    constexpr bool empty() const noexcept;
 
     // ELEMENT ACCESS
-    reference operator[](size_type pos);
-    const_reference operator[](size_type pos) const;
-    reference at(size_type pos);
-    const_reference at(size_type pos) const;
-    reference front();
-    const_reference front() const;
-    reference back();
-    const_reference back() const;
-    const_pointer data() const noexcept;
+    WTL_CONSTEXPR14 const_reference operator[](size_type pos) const;
+    WTL_CONSTEXPR14 const_reference at(size_type pos) const;
+    WTL_CONSTEXPR14 const_reference front() const;
+    WTL_CONSTEXPR14 const_reference back() const;
+    constexpr const_pointer data() const noexcept;
+
+    // SEARCH
+    size_t count(const T &value) const noexcept;
+    size_t count_of(const vector<T> &values) const noexcept;
+    bool contains(const T &value) const noexcept;
 
     // MODIFIERS
     void swap(vector<T> &other);
@@ -329,36 +334,6 @@ bool operator>=(const vector<T> &left,
 }
 
 
-template <typename T>
-vector<T>::vector(const vector<T> &vector):
-    data_(vector.data()),
-    size_(vector.size())
-{}
-
-
-template <typename T>
-vector<T> & vector<T>::operator=(const vector<T> &vector)
-{
-    data_ = vector.data();
-    size_ = vector.size();
-    return *this;
-}
-
-
-template <typename T>
-vector<T>::vector(vector<T> &&vector)
-{
-    swap(vector);
-}
-
-
-template <typename T>
-vector<T> & vector<T>::operator=(vector<T> &&vector)
-{
-    swap(vector);
-    return *this;
-}
-
 template <typename T>
 vector<T>::vector(const std::vector<T> &vector):
     data_(vector.data()),
@@ -376,7 +351,7 @@ vector<T> & vector<T>::operator=(const std::vector<T> &vector)
 
 
 template <typename T>
-vector<T>::vector(const T *t,
+constexpr vector<T>::vector(const T *t,
         size_type n):
     data_(t),
     size_(n)
@@ -384,7 +359,7 @@ vector<T>::vector(const T *t,
 
 
 template <typename T>
-vector<T>::vector(const T *first,
+constexpr vector<T>::vector(const T *first,
         const T *last):
     data_(first),
     size_(last - first)
@@ -392,7 +367,7 @@ vector<T>::vector(const T *first,
 
 
 template <typename T>
-auto vector<T>::begin() const
+constexpr auto vector<T>::begin() const
     -> const_iterator
 {
     return data_;
@@ -400,7 +375,7 @@ auto vector<T>::begin() const
 
 
 template <typename T>
-auto vector<T>::end() const
+constexpr auto vector<T>::end() const
     -> const_iterator
 {
     return data_ + size_;
@@ -424,7 +399,7 @@ auto vector<T>::rend() const
 
 
 template <typename T>
-auto vector<T>::cbegin() const
+constexpr auto vector<T>::cbegin() const
     -> const_iterator
 {
     return begin();
@@ -432,7 +407,7 @@ auto vector<T>::cbegin() const
 
 
 template <typename T>
-auto vector<T>::cend() const
+constexpr auto vector<T>::cend() const
     -> const_iterator
 {
     return end();
@@ -456,30 +431,21 @@ auto vector<T>::crend() const
 
 
 template <typename T>
-size_t vector<T>::size() const
+constexpr size_t vector<T>::size() const
 {
     return size_;
 }
 
 
 template <typename T>
-bool vector<T>::empty() const noexcept
+constexpr bool vector<T>::empty() const noexcept
 {
     return size_ == 0;
 }
 
 
 template <typename T>
-auto vector<T>::operator[](size_type pos)
-    -> reference
-{
-    assert(pos <= size() && "vector index out of bounds");
-    return *const_cast<T*>(data_ + pos);
-}
-
-
-template <typename T>
-auto vector<T>::operator[](size_type pos) const
+WTL_CONSTEXPR14 auto vector<T>::operator[](size_type pos) const
     -> const_reference
 {
     assert(pos <= size() && "vector index out of bounds");
@@ -488,62 +454,70 @@ auto vector<T>::operator[](size_type pos) const
 
 
 template <typename T>
-auto vector<T>::at(size_type pos)
-    -> reference
+WTL_CONSTEXPR14 auto vector<T>::at(size_type pos) const
+    -> const_reference
 {
     return operator[](pos);
 }
 
 
 template <typename T>
-auto vector<T>::at(size_type pos) const
+WTL_CONSTEXPR14 auto vector<T>::front() const
     -> const_reference
 {
-    return operator[](pos);
+    assert(!empty() && "vector::front(): vector is empty");
+    return *data_;
 }
 
 
 template <typename T>
-auto vector<T>::front()
-    -> reference
+WTL_CONSTEXPR14 auto vector<T>::back() const
+    -> const_reference
 {
-    assert(!empty() && "vector::front(): vector is empty");
-    return *const_cast<T*>(data_);
+    assert(!empty() && "vector::back(): vector is empty");
+    return *(data_ + size_ - 1);
 }
 
 
 template <typename T>
-auto vector<T>::front() const
-    -> const_reference
+constexpr auto vector<T>::data() const noexcept
+    -> const_pointer
 {
-    assert(!empty() && "vector::front(): vector is empty");
-    return *data_;
+    return data_;
 }
 
 
+/** \brief Count elements equal to `value`, with SIMD for arithmetic types.
+ */
 template <typename T>
-auto vector<T>::back()
-    -> reference
+size_t vector<T>::count(const T &value) const noexcept
 {
-    assert(!empty() && "vector::back(): vector is empty");
-    return *const_cast<T*>(data_ + size_ - 1);
+    return detail::count_value(data(), size(), value);
 }
 
 
+/** \brief Count elements equal to any of `values`.
+ *
+ *  Counts each distinct value in its own SIMD pass, which suits the
+ *  small sets this is meant for.
+ */
 template <typename T>
-auto vector<T>::back() const
-    -> const_reference
+size_t vector<T>::count_of(const vector<T> &values) const noexcept
 {
-    assert(!empty() && "vector::back(): vector is empty");
-    return *(data_ + size_ - 1);
+    size_t count = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!detail::find_value(values.data(), i, values[i])) {
+            count += this->count(values[i]);
+        }
+    }
+    return count;
 }
 
 
 template <typename T>
-auto vector<T>::data() const noexcept
-    -> const_pointer
+bool vector<T>::contains(const T &value) const noexcept
 {
-    return data_;
+    return detail::find_value(data(), size(), value) != nullptr;
 }
 
 
@@ -568,4 +542,10 @@ vector<T>::operator std::vector<T>() const
     return std::vector<T>(begin(), end());
 }
 
+// CHECKS
+// ------
+
+static_assert(std::is_trivially_copyable<vector<int>>::value, "wtl::vector must be trivially copyable.");
+static_assert(sizeof(vector<int>) == 2 * sizeof(void*), "wtl::vector must be a pointer and a size.");
+
 }   /* wtl */
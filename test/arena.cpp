@@ -0,0 +1,117 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/arena.hpp>
+
+// TESTS
+// -----
+
+
+TEST(arena, allocate)
+{
+    wtl::arena arena(256);
+    EXPECT_EQ(arena.blocks(), 0);
+
+    for (size_t alignment: {1, 2, 8, 16, 64}) {
+        void *data = arena.allocate(3, alignment);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % alignment, 0);
+    }
+    EXPECT_EQ(arena.blocks(), 1);
+    EXPECT_EQ(arena.used(), 15);
+
+    // large requests get their own block
+    char *large = static_cast<char*>(arena.allocate(1000));
+    std::memset(large, 'a', 1000);
+    EXPECT_EQ(arena.blocks(), 2);
+
+    // small requests continue in the open block
+    arena.allocate(8);
+    EXPECT_EQ(arena.blocks(), 2);
+    for (size_t i = 0; i < 64; ++i) {
+        arena.allocate(8);
+    }
+    EXPECT_GT(arena.blocks(), 2);
+    EXPECT_GE(arena.reserved(), arena.used());
+}
+
+
+TEST(arena, copy)
+{
+    wtl::arena arena(64);
+    std::string data = "hello world";
+    wtl::string hello = arena.copy(wtl::string(data).substr(0, 5));
+    wtl::string empty = arena.copy(wtl::string());
+
+    data.assign(data.size(), 'x');
+    EXPECT_EQ(hello, "hello");
+    EXPECT_EQ(hello.data()[5], '\0');
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.data()[0], '\0');
+}
+
+
+TEST(arena, reset)
+{
+    wtl::arena arena(128);
+    for (size_t i = 0; i < 100; ++i) {
+        arena.allocate(16);
+    }
+    arena.allocate(4096);
+    EXPECT_GT(arena.blocks(), 1);
+
+    arena.reset();
+    EXPECT_EQ(arena.blocks(), 1);
+    EXPECT_EQ(arena.reserved(), 128);
+    EXPECT_EQ(arena.used(), 0);
+
+    arena.allocate(16);
+    EXPECT_EQ(arena.blocks(), 1);
+
+    wtl::arena moved(std::move(arena));
+    EXPECT_EQ(moved.blocks(), 1);
+    EXPECT_EQ(arena.blocks(), 0);
+}
+
+
+TEST(arena, rewind)
+{
+    wtl::arena arena(128);
+    for (size_t i = 0; i < 100; ++i) {
+        arena.allocate(16);
+    }
+    arena.allocate(4096);
+    size_t blocks = arena.blocks();
+    size_t reserved = arena.reserved();
+
+    // refilling reuses every kept block
+    arena.rewind();
+    EXPECT_EQ(arena.used(), 0);
+    for (size_t i = 0; i < 100; ++i) {
+        arena.allocate(16);
+    }
+    arena.allocate(4096);
+    EXPECT_EQ(arena.blocks(), blocks);
+    EXPECT_EQ(arena.reserved(), reserved);
+    EXPECT_EQ(arena.used(), 100 * 16 + 4096);
+}
+
+
+TEST(arena, bad_alloc)
+{
+    wtl::arena arena(128);
+    arena.allocate(16);
+    EXPECT_THROW(arena.allocate(SIZE_MAX / 2), std::bad_alloc);
+    EXPECT_EQ(arena.used(), 16);
+
+    // sizes that would wrap around with the padding or alignment
+    EXPECT_THROW(arena.allocate(SIZE_MAX - 4, 16), std::bad_alloc);
+    EXPECT_THROW(arena.allocate(SIZE_MAX, 1), std::bad_alloc);
+    EXPECT_EQ(arena.used(), 16);
+    EXPECT_EQ(arena.blocks(), 1);
+
+    wtl::arena fresh(256);
+    EXPECT_THROW(fresh.allocate(SIZE_MAX - 8, 16), std::bad_alloc);
+    EXPECT_EQ(fresh.used(), 0);
+    EXPECT_EQ(fresh.blocks(), 0);
+}
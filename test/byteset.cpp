@@ -0,0 +1,112 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/string.hpp>
+
+#include <random>
+
+// TESTS
+// -----
+
+
+TEST(byteset, constructors)
+{
+    wtl::byteset set(" \t\r\n,;");
+    EXPECT_EQ(set.size(), 6);
+    EXPECT_FALSE(set.empty());
+    EXPECT_TRUE(set.contains(','));
+    EXPECT_FALSE(set.contains('a'));
+
+    set = wtl::byteset(std::string("aab"));
+    EXPECT_EQ(set.size(), 2);
+
+    set = wtl::byteset("\0\xff", 2);
+    EXPECT_TRUE(set.contains('\0'));
+    EXPECT_TRUE(set.contains('\xff'));
+    EXPECT_FALSE(set.contains('\x7f'));
+
+    EXPECT_TRUE(wtl::byteset().empty());
+}
+
+
+TEST(byteset, modifiers)
+{
+    wtl::byteset set;
+    for (int c = 0; c < 256; ++c) {
+        set.insert(static_cast<char>(c));
+    }
+    EXPECT_EQ(set.size(), 256);
+
+    std::string data(100, 'x');
+    EXPECT_EQ(set.find_first_of(data.data(), data.size()), data.data());
+    EXPECT_EQ(set.find_first_not_of(data.data(), data.size()), nullptr);
+}
+
+
+TEST(byteset, string)
+{
+    wtl::byteset delimiters(" \t\r\n,;");
+    std::string line = "key=value,other=thing; trailing words\n";
+    wtl::string str(line);
+
+    EXPECT_EQ(str.find_first_of(delimiters), 9);
+    EXPECT_EQ(str.find_first_of(delimiters, 10), 21);
+    EXPECT_EQ(str.find_first_not_of(delimiters, 21), 23);
+    EXPECT_EQ(str.find_last_of(delimiters), line.size() - 1);
+    EXPECT_EQ(str.find_last_not_of(delimiters), line.size() - 2);
+    EXPECT_EQ(str.find_first_of(delimiters, 100), wtl::string::npos);
+}
+
+
+TEST(byteset, random)
+{
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (size_t setlen: {0, 1, 3, 16, 17, 64, 200}) {
+        std::string members;
+        for (size_t i = 0; i < setlen; ++i) {
+            members.push_back(static_cast<char>(byte(gen)));
+        }
+        for (size_t length: {0, 5, 16, 31, 32, 33, 100, 1000}) {
+            std::string haystack;
+            for (size_t i = 0; i < length; ++i) {
+                haystack.push_back(static_cast<char>(byte(gen)));
+            }
+
+            wtl::byteset set(members);
+            wtl::string str(haystack);
+            EXPECT_EQ(str.find_first_of(set), haystack.find_first_of(members));
+            EXPECT_EQ(str.find_first_not_of(set), haystack.find_first_not_of(members));
+            EXPECT_EQ(str.find_last_of(set), haystack.find_last_of(members));
+            EXPECT_EQ(str.find_last_not_of(set), haystack.find_last_not_of(members));
+            EXPECT_EQ(str.find_first_of(members), haystack.find_first_of(members));
+            EXPECT_EQ(str.find_last_not_of(members), haystack.find_last_not_of(members));
+        }
+    }
+}
+
+
+TEST(byteset, classify)
+{
+    std::mt19937 gen(23);
+    std::string data(300, '\0');
+    for (char &c: data) {
+        c = static_cast<char>(gen());
+    }
+    for (size_t setlen: {3, 40}) {
+        wtl::byteset set(data.data(), setlen);
+        for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+            wtl::set_isa(static_cast<wtl::isa>(i));
+            for (size_t length: {0, 1, 63, 64, 65, 300}) {
+                uint64_t bits[5] = {~uint64_t(0), ~uint64_t(0), ~uint64_t(0), ~uint64_t(0), ~uint64_t(0)};
+                set.classify(data.data(), length, bits);
+                for (size_t j = 0; j < (length + 63) / 64 * 64; ++j) {
+                    bool member = j < length && set.contains(data[j]);
+                    EXPECT_EQ((bits[j / 64] >> (j % 64)) & 1, member) << j;
+                }
+            }
+        }
+        wtl::reset_isa();
+    }
+}
@@ -0,0 +1,191 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/csv.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// HELPERS
+// -------
+
+typedef std::vector<std::string> row;
+typedef std::vector<row> table;
+
+
+static table collect(const wtl::string &str,
+    const wtl::csv_dialect &dialect = wtl::csv_dialect())
+{
+    wtl::arena scratch;
+    wtl::csv_reader reader(str, dialect, &scratch);
+    wtl::vector<wtl::string> fields;
+    table rows;
+    while (reader.next(fields)) {
+        rows.emplace_back();
+        for (const wtl::string &field: fields) {
+            rows.back().emplace_back(field.data(), field.size());
+        }
+    }
+    return rows;
+}
+
+
+/** \brief Byte-at-a-time reference parser.
+ */
+static table reference(const std::string &str)
+{
+    table rows;
+    row fields;
+    std::string field;
+    bool inside = false;
+    bool quoted = false;
+    for (size_t i = 0; i < str.size(); ++i) {
+        const char c = str[i];
+        if (inside) {
+            if (c == '"' && i + 1 < str.size() && str[i + 1] == '"') {
+                field.push_back('"');
+                ++i;
+            } else if (c == '"') {
+                inside = false;
+            } else {
+                field.push_back(c);
+            }
+        } else if (c == '"' && field.empty() && !quoted) {
+            inside = quoted = true;
+        } else if (c == ',' || c == '\n') {
+            if (c == '\n' && !quoted && !field.empty() && field.back() == '\r') {
+                field.pop_back();
+            }
+            fields.push_back(field);
+            field.clear();
+            quoted = false;
+            if (c == '\n') {
+                rows.push_back(fields);
+                fields.clear();
+            }
+        } else {
+            field.push_back(c);
+        }
+    }
+    if (!field.empty() || !fields.empty() || quoted) {
+        fields.push_back(field);
+        rows.push_back(fields);
+    }
+    return rows;
+}
+
+// TESTS
+// -----
+
+
+TEST(csv, reader)
+{
+    EXPECT_EQ(collect(""), table {});
+    EXPECT_EQ(collect("a"), (table {{"a"}}));
+    EXPECT_EQ(collect("a,b\n"), (table {{"a", "b"}}));
+    EXPECT_EQ(collect("a,b\r\nc,d"), (table {{"a", "b"}, {"c", "d"}}));
+    EXPECT_EQ(collect("\n,\n"), (table {{""}, {"", ""}}));
+    EXPECT_EQ(collect("a,"), (table {{"a", ""}}));
+    EXPECT_EQ(collect("\"a,b\",\"c\nd\"\n"), (table {{"a,b", "c\nd"}}));
+    EXPECT_EQ(collect("\"\",\"x\"\r\n"), (table {{"", "x"}}));
+    EXPECT_EQ(collect("\"say \"\"hi\"\"\",\"\"\"\"\n"), (table {{"say \"hi\"", "\""}}));
+
+    // TSV, and a custom quote
+    wtl::csv_dialect tsv('\t', '\'');
+    EXPECT_EQ(collect("a,b\t'c\td'\n", tsv), (table {{"a,b", "c\td"}}));
+
+    // fields view the input unless they are unescaped
+    std::string data("ab,\"cd\",\"e\"\"f\"\n");
+    wtl::arena scratch;
+    wtl::csv_reader reader(data, wtl::csv_dialect(), &scratch);
+    wtl::vector<wtl::string> fields;
+    EXPECT_TRUE(reader.next(fields));
+    ASSERT_EQ(fields.size(), 3);
+    EXPECT_EQ(fields[0].data(), data.data());
+    EXPECT_EQ(fields[1].data(), data.data() + 4);
+    EXPECT_EQ(fields[2], "e\"f");
+    EXPECT_EQ(scratch.used(), 4);
+    EXPECT_EQ(reader.offset(), data.size());
+    EXPECT_FALSE(reader.next(fields));
+    EXPECT_FALSE(reader.next(fields));
+
+    // unescaping requires an arena
+    wtl::csv_reader unowned("\"a\"\"\"\n");
+    EXPECT_THROW(unowned.next(fields), std::logic_error);
+}
+
+
+TEST(csv, chunks)
+{
+    // quoted fields and records spanning words and chunks
+    std::mt19937 gen(7);
+    const char alphabet[] = "ab,,\n\"\"\r";
+    for (size_t length: {63, 64, 65, 200, 4095, 4096, 4097, 10000}) {
+        std::string data;
+        for (size_t i = 0; i < length; ++i) {
+            data.push_back(alphabet[gen() % 8]);
+        }
+        // keep only well-formed quoting, by removing unmatched quotes
+        std::string input;
+        table rows = reference(data);
+        for (const row &fields: rows) {
+            for (size_t i = 0; i < fields.size(); ++i) {
+                input += i ? "," : "";
+                if (gen() % 2) {
+                    input += '"';
+                    for (char c: fields[i]) {
+                        input += c == '"' ? std::string("\"\"") : std::string(1, c);
+                    }
+                    input += '"';
+                } else {
+                    for (char c: fields[i]) {
+                        input += c == '"' || c == '\r' || c == ',' || c == '\n' ? 'x' : c;
+                    }
+                }
+            }
+            input += '\n';
+        }
+
+        const table expected = reference(input);
+        for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+            wtl::set_isa(static_cast<wtl::isa>(i));
+            EXPECT_EQ(collect(input), expected) << length;
+        }
+        wtl::reset_isa();
+    }
+}
+
+
+TEST(csv, parallel)
+{
+    std::string data;
+    for (size_t i = 0; i < 2000; ++i) {
+        data += std::to_string(i) + ",\"x\ny,\"\"" + std::to_string(i) + "\"\"\"\n";
+    }
+    const table expected = collect(data);
+
+    for (size_t shards: {1, 2, 3, 7, 64}) {
+        std::vector<wtl::string> parts = wtl::csv_split(data, shards);
+        EXPECT_LE(parts.size(), shards);
+        table rows;
+        size_t offset = 0;
+        for (const wtl::string &part: parts) {
+            EXPECT_EQ(part.data(), data.data() + offset);
+            offset += part.size();
+            table shard = collect(part);
+            rows.insert(rows.end(), shard.begin(), shard.end());
+        }
+        EXPECT_EQ(offset, data.size());
+        EXPECT_EQ(rows, expected) << shards;
+    }
+
+    std::vector<size_t> counts(1, 0);
+    wtl::csv_parallel(data, 4, [&](size_t i, const wtl::string &shard) {
+        EXPECT_EQ(i, 0);
+        counts[i] = collect(shard).size();
+    });
+    EXPECT_EQ(counts[0], 2000);
+}
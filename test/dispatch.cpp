@@ -0,0 +1,77 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/dispatch.hpp>
+#include <wtl/string.hpp>
+
+#include <random>
+
+// HELPERS
+// -------
+
+
+static std::string random_string(std::mt19937 &gen,
+    size_t length,
+    char lo,
+    char hi)
+{
+    std::uniform_int_distribution<int> dist(lo, hi);
+    std::string str;
+    for (size_t i = 0; i < length; ++i) {
+        str.push_back(static_cast<char>(dist(gen)));
+    }
+    return str;
+}
+
+// TESTS
+// -----
+
+
+TEST(dispatch, names)
+{
+    for (size_t i = 0; i < wtl::isa_levels; ++i) {
+        wtl::isa level = static_cast<wtl::isa>(i);
+        wtl::isa parsed;
+        EXPECT_TRUE(wtl::parse_isa(wtl::isa_name(level), parsed));
+        EXPECT_EQ(parsed, level);
+    }
+
+    wtl::isa parsed = wtl::isa::sse2;
+    EXPECT_FALSE(wtl::parse_isa("neon", parsed));
+    EXPECT_EQ(parsed, wtl::isa::sse2);
+}
+
+
+TEST(dispatch, levels)
+{
+    EXPECT_LE(wtl::active_isa(), wtl::detected_isa());
+    EXPECT_EQ(wtl::set_isa(wtl::isa::scalar), wtl::isa::scalar);
+    EXPECT_EQ(wtl::active_isa(), wtl::isa::scalar);
+    EXPECT_EQ(wtl::set_isa(wtl::isa::avx512), wtl::detected_isa());
+    wtl::reset_isa();
+    EXPECT_LE(wtl::active_isa(), wtl::detected_isa());
+}
+
+
+TEST(dispatch, kernels)
+{
+    std::mt19937 gen(23);
+    const wtl::byteset set(" ,;\n\xe2\x80");
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::set_isa(static_cast<wtl::isa>(i));
+        for (size_t length: {0, 15, 33, 100, 1000}) {
+            std::string haystack = random_string(gen, length, 'a', 'd');
+            haystack += " ,;\n";
+            wtl::string str(haystack);
+            for (size_t sublen: {1, 2, 5, 40}) {
+                std::string needle = random_string(gen, sublen, 'a', 'd');
+                EXPECT_EQ(str.find(needle), haystack.find(needle)) << wtl::isa_name(wtl::active_isa());
+                EXPECT_EQ(str.rfind(needle), haystack.rfind(needle)) << wtl::isa_name(wtl::active_isa());
+            }
+            EXPECT_EQ(str.find_first_of(set), haystack.find_first_of(" ,;\n\xe2\x80"));
+            EXPECT_EQ(str.find_last_not_of(set), haystack.find_last_not_of(" ,;\n\xe2\x80"));
+        }
+    }
+    wtl::reset_isa();
+}
@@ -0,0 +1,159 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/flat_string_map.hpp>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+
+// HELPERS
+// -------
+
+/** \brief Value whose move may throw, and whose copy throws on demand.
+ */
+struct throwing_value
+{
+    static int copies_left;
+    int value;
+
+    throwing_value(int v):
+        value(v)
+    {}
+
+    throwing_value(const throwing_value &other):
+        value(other.value)
+    {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy");
+        }
+    }
+
+    throwing_value(throwing_value &&other):
+        throwing_value(static_cast<const throwing_value&>(other))
+    {}
+};
+
+int throwing_value::copies_left = -1;
+
+// TESTS
+// -----
+
+
+TEST(flat_string_map, lookup)
+{
+    wtl::flat_string_map<int> map = {{"alpha", 1}, {"beta", 2}};
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at("alpha"), 1);
+    EXPECT_TRUE(map.contains("beta"));
+    EXPECT_FALSE(map.contains("gamma"));
+    EXPECT_EQ(map.count("gamma"), 0);
+    EXPECT_EQ(map.find("gamma"), map.end());
+    EXPECT_THROW(map.at("gamma"), std::out_of_range);
+
+    // keys compare by contents, not by address
+    std::string owned = "beta";
+    EXPECT_EQ(map.find(owned)->second, 2);
+
+    map["gamma"] = 3;
+    ++map["alpha"];
+    EXPECT_EQ(map.at("alpha"), 2);
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_FALSE(map.insert({"gamma", 4}).second);
+    EXPECT_EQ(map.at("gamma"), 3);
+}
+
+
+TEST(flat_string_map, random)
+{
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> dist(0, 2000);
+    std::vector<std::string> keys;
+    for (int i = 0; i <= 2000; ++i) {
+        keys.push_back("key" + std::to_string(i));
+    }
+
+    wtl::flat_string_map<int> map;
+    std::map<std::string, int> expected;
+    for (int i = 0; i < 20000; ++i) {
+        const std::string &key = keys[dist(gen)];
+        if (i % 3 == 0) {
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+        } else {
+            map[key] = i;
+            expected[key] = i;
+        }
+    }
+
+    EXPECT_EQ(map.size(), expected.size());
+    EXPECT_LE(map.load_factor(), 0.875);
+    size_t visited = 0;
+    for (const auto &item: map) {
+        EXPECT_EQ(expected.at(std::string(item.first)), item.second);
+        ++visited;
+    }
+    EXPECT_EQ(visited, expected.size());
+    for (const std::string &key: keys) {
+        EXPECT_EQ(map.count(key), expected.count(key));
+    }
+}
+
+
+TEST(flat_string_map, modifiers)
+{
+    wtl::flat_string_map<std::string> map(100);
+    EXPECT_GE(map.capacity(), 128);
+    map.emplace("a", 3, 'x');
+    map.emplace("b", "value");
+    EXPECT_EQ(map.at("a"), "xxx");
+
+    wtl::flat_string_map<std::string> copy(map);
+    wtl::flat_string_map<std::string> moved(std::move(map));
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(moved.at("b"), "value");
+
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(copy.begin(), copy.end());
+    copy["c"] = "again";
+    EXPECT_EQ(copy.size(), 1);
+
+    // empty keys match whether or not their data is null
+    wtl::flat_string_map<int> empty;
+    empty[wtl::string()] = 1;
+    EXPECT_EQ(empty.at(wtl::string("")), 1);
+    empty[wtl::string("")] = 2;
+    EXPECT_EQ(empty.size(), 1);
+    EXPECT_EQ(empty.at(wtl::string()), 2);
+}
+
+
+TEST(flat_string_map, exception_safety)
+{
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < 14; ++i) {
+        keys.push_back(std::to_string(i));
+    }
+
+    wtl::flat_string_map<throwing_value> map;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        map.emplace(wtl::string(keys[i]), static_cast<int>(i));
+    }
+    size_t capacity = map.capacity();
+
+    // a failed rehash leaves every entry in the old table
+    throwing_value::copies_left = 5;
+    EXPECT_THROW(map.reserve(100), std::runtime_error);
+    throwing_value::copies_left = -1;
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_EQ(map.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(map.at(wtl::string(keys[i])).value, static_cast<int>(i));
+    }
+
+    map.reserve(100);
+    EXPECT_GE(map.capacity(), 100);
+    EXPECT_EQ(map.at("13").value, 13);
+}
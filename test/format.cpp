@@ -0,0 +1,195 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/format.hpp>
+#include <wtl/parse.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#   if __has_include(<charconv>)
+#       include <charconv>
+#   endif
+#endif
+
+// HELPERS
+// -------
+
+
+template <typename T>
+static std::string shortest(T value)
+{
+    char data[64];
+    wtl::format_buffer buffer(data, sizeof(data));
+    buffer << value;
+    return std::string(buffer.str());
+}
+
+
+template <typename T>
+static void check_integers()
+{
+    typedef std::numeric_limits<T> limits;
+    char data[256];
+    for (T value: {limits::min(), limits::max(), T(0), T(1), T(9), T(10), T(99), T(100), T(limits::max() / 3)}) {
+        wtl::format_buffer buffer(data, sizeof(data));
+        buffer << value;
+        EXPECT_EQ(buffer.str(), std::to_string(value));
+    }
+}
+
+// TESTS
+// -----
+
+
+TEST(format, integer)
+{
+    check_integers<signed char>();
+    check_integers<unsigned char>();
+    check_integers<short>();
+    check_integers<unsigned short>();
+    check_integers<int>();
+    check_integers<unsigned>();
+    check_integers<long long>();
+    check_integers<unsigned long long>();
+
+    std::mt19937_64 gen(9);
+    char data[128];
+    for (size_t i = 0; i < 10000; ++i) {
+        const int64_t value = static_cast<int64_t>(gen()) >> (gen() % 64);
+        wtl::format_buffer buffer(data, sizeof(data));
+        buffer << value;
+        EXPECT_EQ(buffer.str(), std::to_string(value));
+    }
+
+    wtl::format_buffer buffer(data, sizeof(data));
+    EXPECT_EQ(buffer.append(255, wtl::format_type::hex).str(), "ff");
+    buffer.clear();
+    EXPECT_EQ(buffer.append(-255, wtl::format_type::upper_hex).str(), "-FF");
+    buffer.clear();
+    EXPECT_EQ(buffer.append(8u, wtl::format_type::octal).str(), "10");
+    buffer.clear();
+    EXPECT_EQ(buffer.append(INT64_MIN, wtl::format_type::binary).str(), "-1" + std::string(63, '0'));
+    buffer.clear();
+    EXPECT_EQ(buffer.append(0, wtl::format_type::binary).str(), "0");
+    buffer.clear();
+    EXPECT_EQ(buffer.append(UINT64_MAX, wtl::format_type::hex).str(), "ffffffffffffffff");
+}
+
+
+TEST(format, floating)
+{
+    EXPECT_EQ(shortest(0.0), "0");
+    EXPECT_EQ(shortest(-0.0), "-0");
+    EXPECT_EQ(shortest(1.0), "1");
+    EXPECT_EQ(shortest(0.1), "0.1");
+    EXPECT_EQ(shortest(-1.5), "-1.5");
+    EXPECT_EQ(shortest(100.0), "100");
+    EXPECT_EQ(shortest(123456.0), "123456");
+    EXPECT_EQ(shortest(1e22), "1e+22");
+    EXPECT_EQ(shortest(1e-7), "1e-07");
+    EXPECT_EQ(shortest(0.001), "0.001");
+    EXPECT_EQ(shortest(1.5e300), "1.5e+300");
+    EXPECT_EQ(shortest(5e-324), "5e-324");
+    EXPECT_EQ(shortest(1.7976931348623157e308), "1.7976931348623157e+308");
+    EXPECT_EQ(shortest(2.2250738585072014e-308), "2.2250738585072014e-308");
+    EXPECT_EQ(shortest(9007199254740993.0), "9007199254740992");
+    EXPECT_EQ(shortest(1152921504606846976.0), "1152921504606846976");
+    EXPECT_EQ(shortest(1e21), "1e+21");
+    EXPECT_EQ(shortest(886070464.0f), "886070464");
+    EXPECT_EQ(shortest(0.3f), "0.3");
+    EXPECT_EQ(shortest(16777216.0f), "16777216");
+    EXPECT_EQ(shortest(1e-45f), "1e-45");
+    EXPECT_EQ(shortest(3.4028235e38f), "3.4028235e+38");
+    EXPECT_EQ(shortest(std::numeric_limits<double>::infinity()), "inf");
+    EXPECT_EQ(shortest(-std::numeric_limits<float>::infinity()), "-inf");
+    EXPECT_EQ(shortest(std::numeric_limits<double>::quiet_NaN()), "nan");
+
+    // shortest representations round-trip
+    std::mt19937_64 gen(13);
+    for (size_t i = 0; i < 100000; ++i) {
+        const uint64_t bits = gen();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (std::isnan(value)) {
+            continue;
+        }
+        const std::string str = shortest(value);
+        EXPECT_EQ(wtl::parse<double>(str).value, value) << str;
+        float single;
+        const uint32_t low = static_cast<uint32_t>(bits);
+        std::memcpy(&single, &low, sizeof(single));
+        if (!std::isnan(single)) {
+            const std::string narrow = shortest(single);
+            EXPECT_EQ(wtl::parse<float>(narrow).value, single) << narrow;
+        }
+
+#if defined(__cpp_lib_to_chars)
+        // and match the digits and notation of std::to_chars
+        char expected[64];
+        std::to_chars_result result = std::to_chars(expected, expected + sizeof(expected), value);
+        EXPECT_EQ(str, std::string(expected, result.ptr)) << str;
+        if (!std::isnan(single)) {
+            result = std::to_chars(expected, expected + sizeof(expected), single);
+            EXPECT_EQ(shortest(single), std::string(expected, result.ptr));
+        }
+#endif
+    }
+}
+
+
+TEST(format, buffer)
+{
+    // fixed buffers throw when a value does not fit
+    char data[8];
+    wtl::format_buffer fixed(data, sizeof(data));
+    fixed << "abc" << 'd' << wtl::string("ef");
+    EXPECT_EQ(fixed.str(), "abcdef");
+    EXPECT_EQ(fixed.capacity(), 8);
+    EXPECT_THROW(fixed << 1.5, std::length_error);
+    EXPECT_EQ(fixed.size(), 6);
+    fixed.clear();
+    EXPECT_TRUE(fixed.empty());
+    fixed << true << ' ' << 42;
+    EXPECT_EQ(fixed.str(), "true 42");
+
+    // arena buffers grow, keeping their contents
+    wtl::arena scratch;
+    wtl::format_buffer growable(scratch, 4);
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        growable << i << ',';
+        expected += std::to_string(i) + ",";
+    }
+    EXPECT_EQ(growable.str(), expected);
+    EXPECT_GE(growable.capacity(), expected.size());
+}
+
+
+TEST(format, spec)
+{
+    wtl::arena scratch;
+    wtl::format_buffer buffer(scratch, 16);
+    wtl::string name("price");
+    wtl::string first = wtl::format(buffer, WTL_FORMAT("{}={} ({:x}, {:b}) {{}}"), name, 2.5, 255, 5u);
+    EXPECT_EQ(first, "price=2.5 (ff, 101) {}");
+    wtl::string second = wtl::format(buffer, WTL_FORMAT("{:X}|{}|{}|{:o}|{}"), -255, "text", 'c', 8, false);
+    EXPECT_EQ(second, "-FF|text|c|10|false");
+    EXPECT_EQ(buffer.str(), "price=2.5 (ff, 101) {}-FF|text|c|10|false");
+    EXPECT_EQ(wtl::format(buffer, WTL_FORMAT("")), "");
+    EXPECT_EQ(wtl::format(buffer, WTL_FORMAT("}}{}{{"), 1), "}1{");
+
+    static_assert(wtl::detail::format_fields("a{}b{:x}c{{}}") == 2, "");
+    static_assert(wtl::detail::format_fields("{") == wtl::detail::format_error, "");
+    static_assert(wtl::detail::format_fields("{:y}") == wtl::detail::format_error, "");
+    static_assert(wtl::detail::format_fields("}") == wtl::detail::format_error, "");
+    static_assert(wtl::detail::format_type_at("{}{:o}", 1) == 'o', "");
+}
@@ -0,0 +1,173 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/gather.hpp>
+
+#include <string>
+#include <thread>
+
+#if defined(WTL_POSIX)
+
+#include <signal.h>
+#include <sys/time.h>
+
+// HELPERS
+// -------
+
+
+/** \brief Write with `writer` through a pipe, and read everything back.
+ */
+static std::string write_pipe(wtl::gather_writer &writer)
+{
+    int fds[2];
+    EXPECT_EQ(::pipe(fds), 0);
+
+    std::string output;
+    std::thread reader([&output, &fds]() {
+        char buffer[4096];
+        ssize_t count;
+        while ((count = ::read(fds[0], buffer, sizeof(buffer))) > 0) {
+            output.append(buffer, static_cast<size_t>(count));
+        }
+    });
+    EXPECT_EQ(writer.write(fds[1]), writer.bytes());
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+    return output;
+}
+
+
+static void ignore_signal(int)
+{}
+
+// TESTS
+// -----
+
+
+TEST(gather_writer, append)
+{
+    std::string data = "header: value\r\n";
+    std::vector<char> body = {'b', 'o', 'd', 'y'};
+
+    wtl::gather_writer writer;
+    EXPECT_TRUE(writer.empty());
+    writer << wtl::string(data.data(), 6) << wtl::string(data.data() + 6, 9);
+    EXPECT_EQ(writer.size(), 1);
+    writer << wtl::string() << wtl::vector<char>(body);
+    EXPECT_EQ(writer.size(), 2);
+    EXPECT_EQ(writer.bytes(), 19);
+
+    wtl::segmented_string segmented = {"ab", "cd"};
+    writer.append(segmented);
+    EXPECT_EQ(writer.size(), 4);
+    EXPECT_EQ(writer.data()[3].iov_len, 2);
+    EXPECT_EQ(write_pipe(writer), "header: value\r\nbodyabcd");
+
+    size_t capacity = writer.capacity();
+    writer.clear();
+    EXPECT_TRUE(writer.empty());
+    EXPECT_EQ(writer.size(), 0);
+    EXPECT_EQ(writer.capacity(), capacity);
+}
+
+
+TEST(gather_writer, batches)
+{
+    // more entries than a single writev accepts, and more bytes than
+    // the pipe buffer holds
+    std::string data;
+    for (size_t i = 0; i < 200000; ++i) {
+        data.push_back(static_cast<char>('a' + i % 26));
+    }
+
+    wtl::gather_writer writer(data.size() / 2);
+    std::string expected;
+    for (size_t i = 0; i < data.size(); i += 2) {
+        writer << wtl::string(data.data() + i, 1);
+        expected.push_back(data[i]);
+    }
+    EXPECT_EQ(writer.size(), data.size() / 2);
+    EXPECT_EQ(write_pipe(writer), expected);
+}
+
+
+TEST(gather_writer, short_writes)
+{
+    // a timer signal without SA_RESTART interrupts blocking writes
+    // into a slowly drained pipe, so writes return partway through an
+    // entry and the rest of that entry is resumed with `write`
+    std::string data;
+    for (size_t i = 0; i < (1 << 20); ++i) {
+        data.push_back(static_cast<char>('a' + i % 26));
+    }
+    wtl::gather_writer writer;
+    for (size_t i = 0; i < data.size(); i += data.size() / 4) {
+        writer << wtl::string(data.data() + i, data.size() / 4);
+        writer << wtl::string("|");
+    }
+
+    struct sigaction action = {};
+    struct sigaction previous;
+    action.sa_handler = ignore_signal;
+    sigemptyset(&action.sa_mask);
+    ASSERT_EQ(::sigaction(SIGALRM, &action, &previous), 0);
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    std::string output;
+    std::thread reader([&output, &fds]() {
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGALRM);
+        ::pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+
+        char buffer[4096];
+        ssize_t count;
+        while ((count = ::read(fds[0], buffer, sizeof(buffer))) > 0) {
+            output.append(buffer, static_cast<size_t>(count));
+            ::usleep(20);
+        }
+    });
+
+    struct itimerval timer = {{0, 500}, {0, 500}};
+    ::setitimer(ITIMER_REAL, &timer, nullptr);
+    EXPECT_EQ(writer.write(fds[1]), writer.bytes());
+    timer = {{0, 0}, {0, 0}};
+    ::setitimer(ITIMER_REAL, &timer, nullptr);
+    ::sigaction(SIGALRM, &previous, nullptr);
+
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+
+    std::string expected;
+    for (size_t i = 0; i < data.size(); i += data.size() / 4) {
+        expected.append(data, i, data.size() / 4);
+        expected.push_back('|');
+    }
+    EXPECT_EQ(output, expected);
+}
+
+
+TEST(gather_writer, flush)
+{
+    wtl::gather_writer writer;
+    EXPECT_THROW(writer.append("x", 1).write(-1), std::system_error);
+
+    FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    int fd = ::fileno(file);
+    writer.clear();
+    writer << wtl::string("gather") << wtl::string(" ") << wtl::string("write");
+    EXPECT_EQ(writer.flush(fd), 12);
+    EXPECT_TRUE(writer.empty());
+
+    char buffer[16] = {};
+    EXPECT_EQ(::pread(fd, buffer, sizeof(buffer), 0), 12);
+    EXPECT_EQ(std::string(buffer), "gather write");
+    std::fclose(file);
+}
+
+#endif
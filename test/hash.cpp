@@ -0,0 +1,103 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/hash.hpp>
+
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+// TESTS
+// -----
+
+
+TEST(hash, bytes)
+{
+    std::string data(2000, '\0');
+    std::mt19937 gen(7);
+    for (char &c: data) {
+        c = static_cast<char>(gen());
+    }
+
+    std::unordered_set<uint64_t> seen;
+    for (size_t length = 0; length <= data.size(); length += 1 + length / 8) {
+        uint64_t value = wtl::hash_bytes(data.data(), length);
+        EXPECT_EQ(value, wtl::hash_bytes(data.data(), length));
+        EXPECT_NE(value, wtl::hash_bytes(data.data(), length, 1));
+        EXPECT_TRUE(seen.insert(value).second) << length;
+    }
+
+    // a single flipped bit changes the hash at every length class
+    for (size_t length: {1, 4, 16, 17, 49, 256, 257, 511, 512, 513, 2000}) {
+        std::string copy = data.substr(0, length);
+        uint64_t value = wtl::hash_bytes(copy.data(), length);
+        copy[length / 2] ^= 1;
+        EXPECT_NE(value, wtl::hash_bytes(copy.data(), length)) << length;
+    }
+}
+
+
+TEST(hash, isa)
+{
+    std::string data(5000, '\0');
+    std::mt19937 gen(11);
+    for (char &c: data) {
+        c = static_cast<char>(gen());
+    }
+
+    std::vector<uint64_t> expected;
+    wtl::set_isa(wtl::isa::scalar);
+    for (size_t length: {257, 320, 511, 512, 513, 1024, 4999, 5000}) {
+        expected.push_back(wtl::hash_bytes(data.data(), length, 3));
+    }
+    for (size_t i = 1; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::set_isa(static_cast<wtl::isa>(i));
+        size_t j = 0;
+        for (size_t length: {257, 320, 511, 512, 513, 1024, 4999, 5000}) {
+            EXPECT_EQ(wtl::hash_bytes(data.data(), length, 3), expected[j++]) << wtl::isa_name(wtl::active_isa());
+        }
+    }
+    wtl::reset_isa();
+}
+
+
+TEST(hash, specialization)
+{
+    std::string data = "alpha beta alpha";
+    wtl::string str(data);
+    std::unordered_set<wtl::string> words = {str.substr(0, 5), str.substr(6, 4), str.substr(11, 5)};
+    EXPECT_EQ(words.size(), 2);
+    EXPECT_EQ(std::hash<wtl::string>()(str.substr(0, 5)), std::hash<wtl::string>()(str.substr(11, 5)));
+
+    std::vector<int> ints = {1, 2, 3};
+    std::vector<double> doubles = {0.0, 1.5};
+    std::vector<double> negative = {-0.0, 1.5};
+    std::hash<wtl::vector<int>> int_hash;
+    std::hash<wtl::vector<double>> double_hash;
+    EXPECT_EQ(int_hash(wtl::vector<int>(ints)), int_hash(wtl::vector<int>(ints.data(), 3)));
+    EXPECT_NE(int_hash(wtl::vector<int>(ints)), int_hash(wtl::vector<int>(ints.data(), 2)));
+    EXPECT_EQ(double_hash(wtl::vector<double>(doubles)), double_hash(wtl::vector<double>(negative)));
+}
+
+
+TEST(hash, transparent)
+{
+    wtl::string_hash hasher;
+    wtl::string_equal equal;
+    std::string owned = "token";
+    wtl::string view(owned);
+    EXPECT_EQ(hasher(owned), hasher(view));
+    EXPECT_EQ(hasher("token"), hasher(view));
+    EXPECT_TRUE(equal(owned, view));
+    EXPECT_TRUE(equal(view, "token"));
+    EXPECT_FALSE(equal(view, "tokens"));
+
+    std::unordered_map<std::string, int, wtl::string_hash, wtl::string_equal> map = {{"token", 1}};
+#if defined(__cpp_lib_generic_unordered_lookup)
+    EXPECT_EQ(map.find(view)->second, 1);
+    EXPECT_EQ(map.count(wtl::string("missing")), 0);
+#else
+    EXPECT_EQ(map.find(owned)->second, 1);
+#endif
+}
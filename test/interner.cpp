@@ -0,0 +1,103 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/interner.hpp>
+
+#include <string>
+
+// TESTS
+// -----
+
+
+TEST(interner, intern)
+{
+    wtl::interner interner(64);
+    EXPECT_TRUE(interner.empty());
+
+    std::string data = "alpha beta alpha gamma";
+    wtl::string str(data);
+    EXPECT_EQ(interner.id(str.substr(0, 5)), 0);
+    EXPECT_EQ(interner.id(str.substr(6, 4)), 1);
+    EXPECT_EQ(interner.id(str.substr(11, 5)), 0);
+    EXPECT_EQ(interner.id(str.substr(17, 5)), 2);
+    EXPECT_EQ(interner.size(), 3);
+
+    // views point into the arena, not the source
+    wtl::string alpha = interner.intern(str.substr(0, 5));
+    EXPECT_NE(alpha.data(), data.data());
+    data.assign(data.size(), 'x');
+    EXPECT_EQ(alpha, "alpha");
+    EXPECT_EQ(interner[1], "beta");
+    EXPECT_EQ(interner.at(2), "gamma");
+    EXPECT_EQ(interner.at(2).data()[5], '\0');
+    EXPECT_THROW(interner.at(3), std::out_of_range);
+
+    // views stay valid as the arena grows
+    const char *first = interner[0].data();
+    for (size_t i = 0; i < 1000; ++i) {
+        interner.id(wtl::string(std::to_string(i)));
+    }
+    EXPECT_EQ(interner[0].data(), first);
+    EXPECT_EQ(interner[0], "alpha");
+    EXPECT_EQ(interner.size(), 1003);
+}
+
+
+TEST(interner, lookup)
+{
+    wtl::interner interner;
+    interner.id("one");
+    interner.id("two");
+
+    uint32_t id = 100;
+    EXPECT_TRUE(interner.find("two", id));
+    EXPECT_EQ(id, 1);
+    EXPECT_FALSE(interner.find("three", id));
+    EXPECT_EQ(id, 1);
+    EXPECT_TRUE(interner.contains("one"));
+    EXPECT_FALSE(interner.contains("on"));
+}
+
+
+TEST(interner, bulk)
+{
+    std::vector<wtl::string> words = {"a", "b", "a", "", "b", "c", ""};
+    wtl::interner interner;
+    std::vector<uint32_t> ids = interner.intern(wtl::vector<wtl::string>(words));
+    EXPECT_EQ(ids, (std::vector<uint32_t> {0, 1, 0, 2, 1, 3, 2}));
+    EXPECT_EQ(interner.size(), 4);
+    EXPECT_EQ(interner[2], "");
+}
+
+
+TEST(interner, reset)
+{
+    wtl::interner interner(128);
+    for (size_t i = 0; i < 500; ++i) {
+        interner.id(wtl::string(std::to_string(i)));
+    }
+    wtl::interner_stats stats = interner.stats();
+    EXPECT_EQ(stats.strings, 500);
+    EXPECT_GT(stats.blocks, 1);
+    EXPECT_GE(stats.reserved, stats.used);
+    EXPECT_GE(stats.index_capacity, 500);
+
+    // blocks are kept for refilling, the index is released
+    size_t blocks = stats.blocks;
+    interner.reset();
+    stats = interner.stats();
+    EXPECT_TRUE(interner.empty());
+    EXPECT_EQ(stats.blocks, blocks);
+    EXPECT_EQ(stats.used, 0);
+    EXPECT_EQ(stats.index_capacity, 0);
+    EXPECT_FALSE(interner.contains("1"));
+
+    EXPECT_EQ(interner.id("1"), 0);
+    EXPECT_EQ(interner[0], "1");
+    for (size_t i = 0; i < 500; ++i) {
+        interner.id(wtl::string(std::to_string(i)));
+    }
+    EXPECT_EQ(interner.size(), 500);
+    EXPECT_EQ(interner.stats().blocks, blocks);
+}
@@ -0,0 +1,106 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/lines.hpp>
+
+#include <random>
+#include <vector>
+
+// HELPERS
+// -------
+
+typedef std::vector<std::string> list;
+
+
+static list collect(const wtl::string &str)
+{
+    list lines;
+    for (const wtl::string &line: wtl::lines(str)) {
+        lines.emplace_back(line.data(), line.size());
+    }
+    return lines;
+}
+
+
+static list collect(const wtl::line_index &index)
+{
+    list lines;
+    for (size_t i = 0; i < index.size(); ++i) {
+        lines.emplace_back(index[i].data(), index[i].size());
+    }
+    return lines;
+}
+
+// TESTS
+// -----
+
+
+TEST(lines, range)
+{
+    EXPECT_EQ(collect(""), list {});
+    EXPECT_EQ(collect("a"), list {"a"});
+    EXPECT_EQ(collect("a\n"), list {"a"});
+    EXPECT_EQ(collect("\n"), list {""});
+    EXPECT_EQ(collect("a\nb"), (list {"a", "b"}));
+    EXPECT_EQ(collect("a\r\n\r\nb\r\n"), (list {"a", "", "b"}));
+    EXPECT_EQ(collect("a\n\nb\r"), (list {"a", "", "b\r"}));
+
+    wtl::u16string wide(u"x\r\ny");
+    auto range = wtl::lines(wide);
+    EXPECT_EQ(std::distance(range.begin(), range.end()), 2);
+    EXPECT_EQ(*range.begin(), wtl::u16string(u"x"));
+}
+
+
+TEST(lines, index)
+{
+    for (const char *data: {"", "a", "a\n", "\n", "a\nb", "a\r\n\r\nb\r\n", "a\n\nb\r"}) {
+        wtl::line_index index(data);
+        EXPECT_EQ(collect(index), collect(data)) << data;
+    }
+
+    wtl::line_index index("ab\ncd\r\n\nefg");
+    EXPECT_EQ(index.size(), 4);
+    EXPECT_EQ(index.offset(1), 3);
+    EXPECT_EQ(index.offset(3), 8);
+    EXPECT_EQ(index.line_of(0), 0);
+    EXPECT_EQ(index.line_of(2), 0);
+    EXPECT_EQ(index.line_of(3), 1);
+    EXPECT_EQ(index.line_of(7), 2);
+    EXPECT_EQ(index.line_of(10), 3);
+    EXPECT_EQ(index.at(3), "efg");
+    EXPECT_THROW(index.at(4), std::out_of_range);
+    EXPECT_TRUE(wtl::line_index().empty());
+}
+
+
+TEST(lines, parallel)
+{
+    std::mt19937 gen(3);
+    std::string data(3 * wtl::line_index::min_shard + 12345, 'x');
+    for (char &c: data) {
+        unsigned value = gen() % 64;
+        c = value == 0 ? '\n' : value == 1 ? '\r' : 'x';
+    }
+    wtl::string str(data);
+    list expected = collect(str);
+
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::set_isa(static_cast<wtl::isa>(i));
+        for (size_t threads: {1, 2, 3, 8}) {
+            wtl::line_index index(str, threads);
+            EXPECT_EQ(collect(index), expected) << threads;
+        }
+    }
+    wtl::reset_isa();
+}
+
+
+TEST(lines, shard)
+{
+    wtl::line_index index("0\n1\n2\n3\n4\n5\n6\n");
+    EXPECT_EQ(index.shard(0, 3), std::make_pair(size_t(0), size_t(3)));
+    EXPECT_EQ(index.shard(2, 3), std::make_pair(size_t(5), size_t(7)));
+    EXPECT_EQ(index.shard(0, 1), std::make_pair(size_t(0), size_t(7)));
+}
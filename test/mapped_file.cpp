@@ -0,0 +1,123 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/mapped_file.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#if defined(WTL_POSIX)
+
+// HELPERS
+// -------
+
+
+/** \brief Temporary file removed at the end of the test.
+ */
+struct temporary_file
+{
+    char path[32] = "/tmp/wtl_mapped_XXXXXX";
+
+    temporary_file(const std::string &contents)
+    {
+        int fd = mkstemp(path);
+        close(fd);
+        std::ofstream stream(path, std::ios::binary);
+        stream.write(contents.data(), contents.size());
+    }
+
+    ~temporary_file()
+    {
+        std::remove(path);
+    }
+};
+
+// TESTS
+// -----
+
+
+TEST(mapped_file, read_only)
+{
+    temporary_file temp("first line\nsecond line\n");
+    wtl::mapped_file file(temp.path);
+    EXPECT_TRUE(file.is_open());
+    EXPECT_EQ(file.mode(), wtl::map_mode::read_only);
+    EXPECT_EQ(file.size(), 23);
+    EXPECT_EQ(file.str().find("second"), 11);
+    EXPECT_THROW(file.mutable_data(), std::logic_error);
+
+    wtl::mapped_file moved(std::move(file));
+    EXPECT_FALSE(file.is_open());
+    EXPECT_TRUE(file.empty());
+    EXPECT_EQ(moved.str().substr(0, 5), "first");
+
+    moved.close();
+    EXPECT_FALSE(moved.is_open());
+    EXPECT_THROW(wtl::mapped_file("/nonexistent/wtl"), std::system_error);
+}
+
+
+TEST(mapped_file, private_write)
+{
+    temporary_file temp("abcdef");
+    {
+        wtl::mapped_file file(temp.path, wtl::map_mode::private_write);
+        file.mutable_data()[0] = 'X';
+        EXPECT_EQ(file.str(), "Xbcdef");
+    }
+
+    // edits are never written back
+    wtl::mapped_file file(temp.path);
+    EXPECT_EQ(file.str(), "abcdef");
+}
+
+
+TEST(mapped_file, empty)
+{
+    temporary_file temp("");
+    wtl::mapped_file file(temp.path);
+    EXPECT_FALSE(file.is_open());
+    EXPECT_TRUE(file.str().empty());
+    EXPECT_TRUE(file.as_vector<uint32_t>().empty());
+    EXPECT_FALSE(file.advise(wtl::map_advice::sequential));
+}
+
+
+TEST(mapped_file, as_vector)
+{
+    const uint32_t values[] = {1, 2, 3, 4, 5};
+    temporary_file temp(std::string(reinterpret_cast<const char*>(values), sizeof(values)));
+    wtl::mapped_file file(temp.path);
+
+    wtl::vector<uint32_t> all = file.as_vector<uint32_t>();
+    EXPECT_EQ(all.size(), 5);
+    EXPECT_EQ(all[4], 5);
+
+    wtl::vector<uint32_t> part = file.as_vector<uint32_t>(8, 3);
+    EXPECT_EQ(part.front(), 3);
+    EXPECT_EQ(part.back(), 5);
+    EXPECT_EQ(file.as_vector<uint16_t>(2, 1).front(), 0);
+
+    EXPECT_THROW(file.as_vector<uint64_t>(), std::invalid_argument);
+    EXPECT_THROW(file.as_vector<uint32_t>(2, 1), std::invalid_argument);
+    EXPECT_THROW(file.as_vector<uint32_t>(8, 4), std::out_of_range);
+    EXPECT_THROW(file.as_vector<uint32_t>(24, 0), std::out_of_range);
+}
+
+
+TEST(mapped_file, advise)
+{
+    temporary_file temp(std::string(10000, 'a'));
+    wtl::mapped_file file(temp.path);
+    EXPECT_TRUE(file.advise(wtl::map_advice::sequential));
+    EXPECT_TRUE(file.advise(wtl::map_advice::willneed, 5000, 100));
+    EXPECT_TRUE(file.advise(wtl::map_advice::normal, 100, 1 << 20));
+    EXPECT_FALSE(file.advise(wtl::map_advice::random, 10000, 1));
+
+    // transparent huge pages may be unavailable for file mappings
+    file.advise(wtl::map_advice::hugepage);
+    EXPECT_EQ(file.str().size(), 10000);
+}
+
+#endif
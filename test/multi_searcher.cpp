@@ -0,0 +1,94 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/multi_searcher.hpp>
+
+#include <random>
+
+// TESTS
+// -----
+
+
+TEST(multi_searcher, constructors)
+{
+    wtl::multi_searcher empty;
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_FALSE(empty.contains("anything"));
+
+    std::vector<std::string> words = {"he", "she", "his", "hers"};
+    wtl::multi_searcher searcher(words);
+    EXPECT_EQ(searcher.size(), 4);
+    EXPECT_EQ(searcher.states(), 10);
+
+    wtl::multi_searcher range(words.begin(), words.end());
+    EXPECT_EQ(range.size(), 4);
+}
+
+
+TEST(multi_searcher, find_all)
+{
+    wtl::multi_searcher searcher = {"he", "she", "his", "hers"};
+    auto matches = searcher.find_all("ushers");
+
+    ASSERT_EQ(matches.size(), 3);
+    EXPECT_EQ(matches[0].pattern, 1);
+    EXPECT_EQ(matches[0].offset, 1);
+    EXPECT_EQ(matches[1].pattern, 0);
+    EXPECT_EQ(matches[1].offset, 2);
+    EXPECT_EQ(matches[2].pattern, 3);
+    EXPECT_EQ(matches[2].offset, 2);
+
+    size_t count = 0;
+    searcher.find_all("he he", [&count](const wtl::multi_searcher::match &) {
+        ++count;
+    });
+    EXPECT_EQ(count, 2);
+}
+
+
+TEST(multi_searcher, find_first)
+{
+    wtl::multi_searcher searcher = {"error", "warn", "", "fatal"};
+    wtl::multi_searcher::match match;
+
+    EXPECT_TRUE(searcher.find_first("level=warn msg=error", match));
+    EXPECT_EQ(match.pattern, 1);
+    EXPECT_EQ(match.offset, 6);
+    EXPECT_FALSE(searcher.find_first("level=info", match));
+    EXPECT_TRUE(searcher.contains("fatal"));
+}
+
+
+TEST(multi_searcher, random)
+{
+    std::mt19937 gen(23);
+    std::uniform_int_distribution<int> letter('a', 'd');
+    std::uniform_int_distribution<int> size(1, 6);
+
+    std::vector<std::string> needles(50);
+    for (std::string &needle: needles) {
+        needle.resize(size(gen));
+        for (char &c: needle) {
+            c = static_cast<char>(letter(gen));
+        }
+    }
+    std::string haystack(500, '\0');
+    for (char &c: haystack) {
+        c = static_cast<char>(letter(gen));
+    }
+
+    // every (pattern, offset) pair must match a brute-force scan
+    size_t expected = 0;
+    for (size_t id = 0; id < needles.size(); ++id) {
+        for (size_t pos = haystack.find(needles[id]); pos != std::string::npos; pos = haystack.find(needles[id], pos + 1)) {
+            ++expected;
+        }
+    }
+    wtl::multi_searcher searcher(needles);
+    auto matches = searcher.find_all(haystack);
+    EXPECT_EQ(matches.size(), expected);
+    for (const auto &match: matches) {
+        EXPECT_EQ(haystack.compare(match.offset, needles[match.pattern].size(), needles[match.pattern]), 0);
+    }
+}
@@ -0,0 +1,118 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/dispatch.hpp>
+#include <wtl/mutable_string.hpp>
+
+#include <sstream>
+
+// TESTS
+// -----
+
+
+TEST(mutable_string, constructors)
+{
+    std::string data = "mutable";
+    wtl::mutable_string str(data);
+    EXPECT_EQ(str.size(), 7);
+    EXPECT_EQ(str.data(), &data[0]);
+    EXPECT_EQ(wtl::mutable_string(&data[0], 3).size(), 3);
+    EXPECT_EQ(wtl::mutable_string(&data[1], &data[4]).length(), 3);
+
+    wtl::mutable_string other;
+    EXPECT_TRUE(other.empty());
+    wtl::swap(str, other);
+    EXPECT_EQ(other.size(), 7);
+    EXPECT_FALSE(bool(str));
+}
+
+
+TEST(mutable_string, element)
+{
+    std::string data = "string";
+    wtl::mutable_string str(data);
+    str[0] = 'S';
+    str.at(1) = 'T';
+    str.back() = 'G';
+    EXPECT_EQ(data, "STrinG");
+    EXPECT_EQ(str.front(), 'S');
+    EXPECT_THROW(str.at(6), std::out_of_range);
+
+    std::u32string wide = U"wide";
+    wtl::mutable_u32string u32(wide);
+    u32[0] = U'W';
+    EXPECT_EQ(wide, U"Wide");
+}
+
+
+TEST(mutable_string, algorithms)
+{
+    std::string data = "hello";
+    wtl::mutable_string str(data);
+    str.reverse();
+    EXPECT_EQ(data, "olleh");
+    str.sort();
+    EXPECT_EQ(data, "ehllo");
+    str.transform([](char c) { return static_cast<char>(c + 1); });
+    EXPECT_EQ(data, "fimmp");
+    wtl::mutable_string(&data[1], 3).fill('-');
+    EXPECT_EQ(data, "f---p");
+}
+
+
+TEST(mutable_string, case_fold)
+{
+    std::string text;
+    for (int c = 0; c < 256; ++c) {
+        text.push_back(static_cast<char>(c));
+    }
+    text += "The Quick Brown Fox @[`{ Jumps";
+
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::set_isa(static_cast<wtl::isa>(i));
+        for (size_t length: {0, 1, 15, 16, 17, 33, 64, 200, 286}) {
+            std::string lower = text;
+            std::string upper = text;
+            wtl::mutable_string(&lower[0], length).to_lower();
+            wtl::mutable_string(&upper[0], length).to_upper();
+            for (size_t j = 0; j < text.size(); ++j) {
+                char c = text[j];
+                bool ascii = static_cast<unsigned char>(c) < 128;
+                EXPECT_EQ(lower[j], j < length && ascii ? static_cast<char>(std::tolower(c)) : c);
+                EXPECT_EQ(upper[j], j < length && ascii ? static_cast<char>(std::toupper(c)) : c);
+            }
+        }
+    }
+    wtl::reset_isa();
+
+    std::u16string wide = u"MiXeD É";
+    wtl::mutable_u16string(wide).to_lower();
+    EXPECT_EQ(wide, u"mixed É");
+}
+
+
+TEST(mutable_string, conversions)
+{
+    std::string data = "view";
+    wtl::mutable_string str(data);
+    wtl::string view = str;
+    EXPECT_EQ(view.data(), data.data());
+    EXPECT_EQ(view, wtl::string("view"));
+    EXPECT_EQ(str.str().find('e'), 2);
+    EXPECT_EQ(std::string(str), "view");
+}
+
+
+TEST(mutable_string, stream)
+{
+    std::string data(5, ' ');
+    wtl::mutable_string str(data);
+    std::istringstream input("input stream");
+    input >> str;
+    EXPECT_EQ(data, "input");
+
+    std::ostringstream output;
+    output << str << wtl::string(" ok");
+    EXPECT_EQ(output.str(), "input ok");
+}
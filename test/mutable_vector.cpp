@@ -0,0 +1,121 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/dispatch.hpp>
+#include <wtl/mutable_vector.hpp>
+
+#include <random>
+
+// HELPERS
+// -------
+
+
+/** \brief Compare the SIMD byte swap against a byte-reversing loop.
+ */
+template <typename T>
+static void check_byteswap(std::mt19937_64 &gen)
+{
+    std::vector<T> data(100);
+    for (T &value: data) {
+        value = static_cast<T>(gen());
+    }
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::set_isa(static_cast<wtl::isa>(i));
+        for (size_t length: {0, 1, 3, 15, 16, 17, 100}) {
+            std::vector<T> copy(data);
+            wtl::mutable_vector<T>(copy.data(), length).byteswap();
+            for (size_t j = 0; j < data.size(); ++j) {
+                T expected = data[j];
+                if (j < length) {
+                    char *bytes = reinterpret_cast<char*>(&expected);
+                    std::reverse(bytes, bytes + sizeof(T));
+                }
+                EXPECT_EQ(copy[j], expected);
+            }
+        }
+    }
+    wtl::reset_isa();
+}
+
+// TESTS
+// -----
+
+
+TEST(mutable_vector, constructors)
+{
+    std::vector<int> data = {0, 1, 2, 3, 4, 5};
+    wtl::mutable_vector<int> vector(data);
+    EXPECT_EQ(vector.size(), 6);
+    EXPECT_EQ(vector.data(), data.data());
+    EXPECT_EQ(wtl::mutable_vector<int>(data.data(), 2).size(), 2);
+    EXPECT_EQ(wtl::mutable_vector<int>(data.data() + 1, data.data() + 4).size(), 3);
+
+    wtl::mutable_vector<int> other;
+    EXPECT_TRUE(other.empty());
+    wtl::swap(vector, other);
+    EXPECT_EQ(other.size(), 6);
+    EXPECT_FALSE(bool(vector));
+}
+
+
+TEST(mutable_vector, element)
+{
+    std::vector<int> data = {0, 1, 2, 3, 4, 5};
+    wtl::mutable_vector<int> vector(data);
+    vector[0] = 10;
+    vector.at(1) = 11;
+    vector.back() = 15;
+    ++vector.front();
+    EXPECT_EQ(data, (std::vector<int> {11, 11, 2, 3, 4, 15}));
+    EXPECT_THROW(vector.at(6), std::out_of_range);
+
+    for (int &value: vector) {
+        value = -value;
+    }
+    EXPECT_EQ(data[2], -2);
+}
+
+
+TEST(mutable_vector, algorithms)
+{
+    std::vector<int> data = {3, 1, 4, 1, 5, 9, 2, 6};
+    wtl::mutable_vector<int> vector(data);
+
+    vector.sort();
+    EXPECT_EQ(data, (std::vector<int> {1, 1, 2, 3, 4, 5, 6, 9}));
+    vector.sort([](int left, int right) { return left > right; });
+    EXPECT_EQ(data, (std::vector<int> {9, 6, 5, 4, 3, 2, 1, 1}));
+    vector.reverse();
+    EXPECT_EQ(data, (std::vector<int> {1, 1, 2, 3, 4, 5, 6, 9}));
+    vector.transform([](int value) { return value * 2; });
+    EXPECT_EQ(data, (std::vector<int> {2, 2, 4, 6, 8, 10, 12, 18}));
+    wtl::mutable_vector<int>(data.data() + 2, 3).fill(7);
+    EXPECT_EQ(data, (std::vector<int> {2, 2, 7, 7, 7, 10, 12, 18}));
+}
+
+
+TEST(mutable_vector, byteswap)
+{
+    std::mt19937_64 gen(5);
+    check_byteswap<uint16_t>(gen);
+    check_byteswap<int32_t>(gen);
+    check_byteswap<uint64_t>(gen);
+    check_byteswap<double>(gen);
+
+    std::vector<uint32_t> data = {0x01020304};
+    wtl::mutable_vector<uint32_t>(data).byteswap();
+    EXPECT_EQ(data[0], 0x04030201);
+}
+
+
+TEST(mutable_vector, conversions)
+{
+    std::vector<int> data = {0, 1, 2};
+    wtl::mutable_vector<int> vector(data);
+    wtl::vector<int> view = vector;
+    EXPECT_EQ(view.data(), data.data());
+    EXPECT_EQ(view.size(), 3);
+    EXPECT_TRUE(wtl::vector<int>(vector).contains(2));
+    EXPECT_EQ(std::vector<int>(vector), data);
+}
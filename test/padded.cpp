@@ -0,0 +1,153 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/padded.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#if defined(WTL_POSIX)
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+// HELPERS
+// -------
+
+typedef std::vector<char, wtl::padded_allocator<char>> padded_buffer;
+
+
+static padded_buffer random_buffer(std::mt19937 &gen,
+    size_t length)
+{
+    std::uniform_int_distribution<int> dist('a', 'd');
+    padded_buffer buffer;
+    for (size_t i = 0; i < length; ++i) {
+        buffer.push_back(static_cast<char>(dist(gen)));
+    }
+    return buffer;
+}
+
+// TESTS
+// -----
+
+
+TEST(padded, allocator)
+{
+    padded_buffer buffer(100, 'x');
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) % 64, 0);
+    for (size_t i = 0; i < wtl::simd_padding; ++i) {
+        EXPECT_EQ(buffer.data()[buffer.capacity() + i], '\0');
+    }
+
+    std::vector<int, wtl::padded_allocator<int>> ints = {1, 2, 3};
+    wtl::padded_vector<int> vector(ints);
+    EXPECT_EQ(vector.size(), 3);
+    EXPECT_EQ(vector[2], 3);
+}
+
+
+TEST(padded, string)
+{
+    std::string data = "key=value,other=thing; trailing words\n";
+    padded_buffer buffer(data.begin(), data.end());
+    wtl::padded_string str(buffer);
+    wtl::byteset delimiters(" \t\r\n,;");
+
+    EXPECT_EQ(str.find("other"), 10);
+    EXPECT_EQ(str.find('='), 3);
+    EXPECT_EQ(str.rfind('='), 15);
+    EXPECT_EQ(str.rfind("thing"), 16);
+    EXPECT_EQ(str.find("missing"), wtl::string::npos);
+    EXPECT_EQ(str.find_first_of(delimiters), 9);
+    EXPECT_EQ(str.find_last_not_of(delimiters), data.size() - 2);
+    EXPECT_EQ(str.find_first_of("=,"), 3);
+
+    wtl::padded_string sub = str.substr(4, 5);
+    EXPECT_EQ(sub, "value");
+    EXPECT_EQ(sub.find('e'), 4);
+    EXPECT_EQ(sub.find("thing"), wtl::string::npos);
+}
+
+
+TEST(padded, random)
+{
+    std::mt19937 gen(31);
+    wtl::byteset set("ab");
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::set_isa(static_cast<wtl::isa>(i));
+        for (size_t length: {0, 1, 15, 16, 17, 31, 33, 64, 100, 1000}) {
+            padded_buffer buffer = random_buffer(gen, length);
+            std::string haystack(buffer.begin(), buffer.end());
+            wtl::padded_string str(buffer);
+            for (size_t sublen: {1, 2, 3, 8, 40}) {
+                padded_buffer bytes = random_buffer(gen, sublen);
+                std::string needle(bytes.begin(), bytes.end());
+                EXPECT_EQ(str.find(needle), haystack.find(needle));
+                EXPECT_EQ(str.rfind(needle), haystack.rfind(needle));
+            }
+            EXPECT_EQ(str.find('d'), haystack.find('d'));
+            EXPECT_EQ(str.rfind('d'), haystack.rfind('d'));
+            EXPECT_EQ(str.find_first_not_of(set), haystack.find_first_not_of("ab"));
+            EXPECT_EQ(str.find_last_of(set), haystack.find_last_of("ab"));
+        }
+    }
+    wtl::reset_isa();
+}
+
+#if defined(WTL_POSIX)
+
+TEST(padded, guard_page)
+{
+    // place the data so its padding ends exactly at an inaccessible page
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *region = static_cast<char*>(mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0));
+    ASSERT_NE(region, MAP_FAILED);
+    ASSERT_EQ(mprotect(region + page, page, PROT_NONE), 0);
+
+    for (size_t length: {1, 17, 100}) {
+        char *first = region + page - wtl::simd_padding - length;
+        std::memset(first, 'a', length + wtl::simd_padding);
+        wtl::padded_string str(first, length, wtl::assume_padded);
+        for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+            wtl::set_isa(static_cast<wtl::isa>(i));
+            EXPECT_EQ(str.find('b'), wtl::string::npos);
+            EXPECT_EQ(str.rfind("ab"), wtl::string::npos);
+            EXPECT_EQ(str.find("ab"), wtl::string::npos);
+            EXPECT_EQ(str.find_first_not_of(wtl::byteset("a")), wtl::string::npos);
+        }
+    }
+    wtl::reset_isa();
+    munmap(region, 2 * page);
+}
+
+
+TEST(padded, file)
+{
+    char path[] = "/tmp/wtl_padded_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    {
+        std::ofstream stream(path);
+        stream << "first line\nsecond line\n";
+    }
+
+    wtl::padded_file file(path);
+    EXPECT_EQ(file.size(), 23);
+    wtl::padded_string str = file.str();
+    EXPECT_EQ(str.find("second"), 11);
+    EXPECT_EQ(str.rfind('\n'), 22);
+    EXPECT_EQ(file.data()[file.size()], '\0');
+
+    wtl::padded_file moved(std::move(file));
+    EXPECT_TRUE(file.empty());
+    EXPECT_EQ(moved.str(), str);
+
+    std::remove(path);
+    EXPECT_THROW(wtl::padded_file("/nonexistent/wtl"), std::system_error);
+}
+
+#endif
@@ -0,0 +1,240 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/parse.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+template <typename T>
+static void check_limits()
+{
+    typedef std::numeric_limits<T> limits;
+    const std::string max = std::to_string(limits::max());
+    const std::string min = std::to_string(limits::min());
+    EXPECT_EQ(wtl::parse<T>(max).value, limits::max()) << max;
+    EXPECT_EQ(wtl::parse<T>(min).value, limits::min()) << min;
+    EXPECT_EQ(wtl::parse<T>("0").value, T(0));
+    EXPECT_EQ(wtl::parse<T>("00000000000000000000000042").value, T(42));
+
+    // one past each limit
+    std::string above = max;
+    for (size_t i = above.size(); i-- > 0; ) {
+        if (above[i] != '9') {
+            ++above[i];
+            break;
+        }
+        above[i] = '0';
+        if (i == 0) {
+            above.insert(above.begin(), '1');
+        }
+    }
+    EXPECT_EQ(wtl::parse<T>(above).error, wtl::parse_error::out_of_range) << above;
+    EXPECT_EQ(wtl::parse<T>(max + "0").error, wtl::parse_error::out_of_range);
+    EXPECT_EQ(wtl::parse<T>("123456789012345678901234567890").error, wtl::parse_error::out_of_range);
+    if (limits::is_signed) {
+        EXPECT_EQ(wtl::parse<T>(min + "0").error, wtl::parse_error::out_of_range);
+    } else {
+        EXPECT_EQ(wtl::parse<T>("-1").error, wtl::parse_error::invalid_argument);
+        EXPECT_EQ(wtl::parse<T>("-0").error, wtl::parse_error::invalid_argument);
+    }
+}
+
+// TESTS
+// -----
+
+
+TEST(parse, integer)
+{
+    check_limits<int8_t>();
+    check_limits<uint8_t>();
+    check_limits<int16_t>();
+    check_limits<uint16_t>();
+    check_limits<int32_t>();
+    check_limits<uint32_t>();
+    check_limits<int64_t>();
+    check_limits<uint64_t>();
+
+    EXPECT_TRUE(wtl::parse<int>("-17"));
+    EXPECT_EQ(wtl::parse<int>("-17").value, -17);
+    EXPECT_EQ(wtl::parse<uint64_t>("1234567890123456789").value, 1234567890123456789ULL);
+    EXPECT_EQ(wtl::parse<uint64_t>("12345678").value, 12345678ULL);
+
+    // whole string, with no whitespace or '+'
+    for (const char *data: {"", "-", "+1", " 1", "1 ", "1a", "0x10", "--1", "123456789012345678x", "1234567890123456789012x"}) {
+        wtl::parse_result<int64_t> result = wtl::parse<int64_t>(data);
+        EXPECT_FALSE(result) << data;
+        EXPECT_EQ(result.error, wtl::parse_error::invalid_argument) << data;
+        EXPECT_EQ(result.value, 0) << data;
+    }
+    // non-digits at each position of the 8 and 16-digit runs
+    for (size_t i = 0; i < 19; ++i) {
+        std::string data(19, '1');
+        data[i] = '/';
+        EXPECT_EQ(wtl::parse<uint64_t>(data).error, wtl::parse_error::invalid_argument) << data;
+        data[i] = ':';
+        EXPECT_EQ(wtl::parse<uint64_t>(data).error, wtl::parse_error::invalid_argument) << data;
+    }
+}
+
+
+TEST(parse, base)
+{
+    EXPECT_EQ(wtl::parse<uint32_t>("ff", 16).value, 255u);
+    EXPECT_EQ(wtl::parse<uint32_t>("DeadBeef", 16).value, 0xDEADBEEFu);
+    EXPECT_EQ(wtl::parse<int32_t>("-80000000", 16).value, INT32_MIN);
+    EXPECT_EQ(wtl::parse<int32_t>("80000000", 16).error, wtl::parse_error::out_of_range);
+    EXPECT_EQ(wtl::parse<uint64_t>("ffffffffffffffff", 16).value, UINT64_MAX);
+    EXPECT_EQ(wtl::parse<uint64_t>("10000000000000000", 16).error, wtl::parse_error::out_of_range);
+    EXPECT_EQ(wtl::parse<uint64_t>("1000000000000000000000", 8).value, 1ULL << 63);
+    EXPECT_EQ(wtl::parse<uint64_t>("2000000000000000000000", 8).error, wtl::parse_error::out_of_range);
+    EXPECT_EQ(wtl::parse<int>("777", 8).value, 511);
+    EXPECT_EQ(wtl::parse<int>("8", 8).error, wtl::parse_error::invalid_argument);
+    EXPECT_EQ(wtl::parse<int>("g", 16).error, wtl::parse_error::invalid_argument);
+    EXPECT_EQ(wtl::parse<int>("z", 36).value, 35);
+    EXPECT_EQ(wtl::parse<uint8_t>("100000000g", 2).error, wtl::parse_error::invalid_argument);
+}
+
+
+TEST(parse, column)
+{
+    std::mt19937_64 gen(11);
+    std::vector<std::string> strings;
+    std::vector<int64_t> expected;
+    for (size_t i = 0; i < 2000; ++i) {
+        int64_t value = static_cast<int64_t>(gen()) >> (gen() % 64);
+        expected.push_back(value);
+        strings.push_back(std::to_string(value));
+    }
+    std::vector<wtl::string> views(strings.begin(), strings.end());
+    const wtl::vector<wtl::string> column(views);
+
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::set_isa(static_cast<wtl::isa>(i));
+        std::vector<int64_t> out(column.size());
+        EXPECT_EQ(wtl::parse(column, out.data()), column.size());
+        EXPECT_EQ(out, expected);
+
+        // stops at the first error
+        views[1500] = "12345678901234567x";
+        EXPECT_EQ(wtl::parse(wtl::vector<wtl::string>(views), out.data()), 1500);
+        views[1500] = strings[1500];
+    }
+    wtl::reset_isa();
+
+    std::vector<uint16_t> small(2);
+    const std::vector<wtl::string> hex = {"fFfF", "10000"};
+    EXPECT_EQ(wtl::parse(wtl::vector<wtl::string>(hex), small.data(), 16), 1);
+    EXPECT_EQ(small[0], 0xFFFF);
+}
+
+
+TEST(parse, floating)
+{
+    // hard cases: halfway points, subnormals, limits and long mantissas
+    const char *corpus[] = {
+        "0", "-0", "1", "-1", "0.1", ".5", "5.", "1e0", "1E+2", "1e-2", "123.456e-7",
+        "9007199254740992", "9007199254740993", "9007199254740995",
+        "9007199254740993.0000000000000000001",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124",
+        "1.00000000000000011102230246251565404236316680908203126",
+        "1.7976931348623157e308", "1.7976931348623158e308", "1.797693134862315807e308",
+        "2.2250738585072011e-308", "2.2250738585072012e-308", "2.2250738585072014e-308",
+        "4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+        "1e-400", "0.000000000000000000000000000000000000000000001e-300",
+        "7.038531e-26", "3.4028234664e38", "1.17549435e-38", "1.4e-45",
+        "123456789012345678901234567890", "0.1234567890123456789012345678901234567890",
+        "00000000000000000000000000000000000000000000000000123.25",
+        "8.98846567431157953864652595394512366e307", "4.503599627370496e15",
+        "3.0540873829237665e-294", "1448997445238699", "5.5626846462680035e-309",
+        "2.470328229206232720882e-324", "18014398509481993", "1e22", "1e23", "8.589973e9",
+        "0.0000000000000000000000000000000000000000000000000000000000000000000001",
+    };
+    for (const char *data: corpus) {
+        const wtl::parse_result<double> d = wtl::parse<double>(data);
+        EXPECT_TRUE(d) << data;
+        EXPECT_EQ(d.value, std::strtod(data, nullptr)) << data;
+        EXPECT_EQ(std::signbit(d.value), std::signbit(std::strtod(data, nullptr))) << data;
+
+        const wtl::parse_result<float> f = wtl::parse<float>(data);
+        if (std::isinf(std::strtof(data, nullptr))) {
+            EXPECT_EQ(f.error, wtl::parse_error::out_of_range) << data;
+        } else {
+            EXPECT_EQ(f.value, std::strtof(data, nullptr)) << data;
+        }
+    }
+
+    // the view does not need a null terminator
+    const char buffer[] = "1.25e2999";
+    EXPECT_EQ(wtl::parse<double>(wtl::string(buffer, 6)).value, 125.0);
+
+    EXPECT_TRUE(std::isinf(wtl::parse<double>("-Infinity").value));
+    EXPECT_LT(wtl::parse<double>("-inf").value, 0);
+    EXPECT_TRUE(std::isnan(wtl::parse<float>("NaN").value));
+    EXPECT_EQ(wtl::parse<double>("1e309").error, wtl::parse_error::out_of_range);
+    EXPECT_EQ(wtl::parse<double>("-1e99999999999999").error, wtl::parse_error::out_of_range);
+    EXPECT_EQ(wtl::parse<double>("1e-99999999999999").value, 0);
+    for (const char *data: {"", "-", ".", "e5", "1e", "1e+", "+1", " 1", "1 ", "1.2.3", "0x1p3", "in", "nana", "1,5"}) {
+        EXPECT_EQ(wtl::parse<double>(data).error, wtl::parse_error::invalid_argument) << data;
+    }
+}
+
+
+TEST(parse, floating_random)
+{
+    std::mt19937_64 gen(5);
+    char buffer[128];
+    for (size_t i = 0; i < 20000; ++i) {
+        // shortest-ish and over-long representations of random doubles
+        uint64_t bits = gen();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+        std::snprintf(buffer, sizeof(buffer), "%.*e", static_cast<int>(gen() % 25), value);
+        EXPECT_EQ(wtl::parse<double>(buffer).value, std::strtod(buffer, nullptr)) << buffer;
+
+        // random digits, around the halfway points of floats
+        std::string digits;
+        for (size_t j = 0, n = 1 + gen() % 30; j < n; ++j) {
+            digits.push_back(static_cast<char>('0' + gen() % 10));
+        }
+        digits += "e" + std::to_string(static_cast<int>(gen() % 90) - 60);
+        const float expected = std::strtof(digits.data(), nullptr);
+        if (!std::isinf(expected)) {
+            EXPECT_EQ(wtl::parse<float>(digits).value, expected) << digits;
+        }
+    }
+}
+
+
+TEST(parse, floating_column)
+{
+    std::mt19937_64 gen(3);
+    std::vector<std::string> strings;
+    std::vector<double> expected;
+    for (size_t i = 0; i < 1000; ++i) {
+        strings.push_back(std::to_string(static_cast<int64_t>(gen() % 2000000) - 1000000) + "." + std::to_string(gen() % 1000) + "e" + std::to_string(gen() % 40));
+        expected.push_back(std::strtod(strings.back().data(), nullptr));
+    }
+    strings.push_back("x");
+    std::vector<wtl::string> views(strings.begin(), strings.end());
+    std::vector<double> out(views.size());
+    EXPECT_EQ(wtl::parse(wtl::vector<wtl::string>(views), out.data()), 1000);
+    out.pop_back();
+    EXPECT_EQ(out, expected);
+}
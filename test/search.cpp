@@ -0,0 +1,199 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/string.hpp>
+
+#include <random>
+
+// HELPERS
+// -------
+
+
+static std::string random_string(std::mt19937 &gen,
+    size_t length,
+    char alphabet)
+{
+    std::uniform_int_distribution<int> dist('a', 'a' + alphabet - 1);
+    std::string str(length, '\0');
+    for (char &c: str) {
+        c = static_cast<char>(dist(gen));
+    }
+    return str;
+}
+
+// TESTS
+// -----
+
+
+TEST(search, find_char)
+{
+    std::string haystack(100, 'a');
+    haystack[77] = 'b';
+    wtl::string str(haystack);
+
+    EXPECT_EQ(str.find('b'), 77);
+    EXPECT_EQ(str.find('b', 77), 77);
+    EXPECT_EQ(str.find('b', 78), wtl::string::npos);
+    EXPECT_EQ(str.find('b', 200), wtl::string::npos);
+    EXPECT_EQ(wtl::string().find('b'), wtl::string::npos);
+}
+
+
+TEST(search, find_edges)
+{
+    wtl::string str("abcabcabd");
+    EXPECT_EQ(str.find(""), 0);
+    EXPECT_EQ(str.find("", 4), 4);
+    EXPECT_EQ(str.find("abd"), 6);
+    EXPECT_EQ(str.find("abcabcabd"), 0);
+    EXPECT_EQ(str.find("abcabcabdx"), wtl::string::npos);
+    EXPECT_EQ(str.find("abc", 10), wtl::string::npos);
+}
+
+
+TEST(search, find_periodic)
+{
+    // long, periodic needles exercise both Two-Way branches
+    std::string needle(100, 'a');
+    std::string haystack(1000, 'a');
+    haystack[500] = 'b';
+    wtl::string str(haystack);
+
+    EXPECT_EQ(str.find(needle), 0);
+    EXPECT_EQ(str.find(needle, 401), 501);
+    needle.back() = 'b';
+    EXPECT_EQ(str.find(needle), 401);
+}
+
+
+TEST(search, find_random)
+{
+    std::mt19937 gen(7);
+    for (size_t sublen: {2, 3, 5, 8, 16, 17, 31, 40, 64, 65, 100, 300}) {
+        for (char alphabet: {2, 4, 26}) {
+            for (int trial = 0; trial < 20; ++trial) {
+                std::string haystack = random_string(gen, 1000, alphabet);
+                std::string needle = random_string(gen, sublen, alphabet);
+                if (trial % 2) {
+                    haystack.replace(trial * 30, sublen, needle);
+                }
+                wtl::string str(haystack);
+                for (size_t pos: {0, 1, 33, 500}) {
+                    EXPECT_EQ(str.find(needle, pos), haystack.find(needle, pos));
+                }
+            }
+        }
+    }
+}
+
+
+TEST(search, find_pathological)
+{
+    // every position is a filter candidate but never a match
+    std::string haystack(5000, 'a');
+    std::string needle = std::string(30, 'a');
+    needle[15] = 'b';
+    haystack.replace(4000, needle.size(), needle);
+    wtl::string str(haystack);
+
+    EXPECT_EQ(str.find(needle), 4000);
+}
+
+
+TEST(search, find_wide)
+{
+    std::wstring haystack = L"the quick brown fox jumps over the lazy dog";
+    wtl::wstring str(haystack);
+    wtl::wstring needle(L"the lazy");
+
+    EXPECT_EQ(str.find(needle), haystack.find(L"the lazy"));
+    EXPECT_EQ(str.find(wtl::wstring(L"cat")), wtl::wstring::npos);
+}
+
+
+TEST(search, rfind_char)
+{
+    std::string haystack(100, 'a');
+    haystack[3] = 'b';
+    haystack[77] = 'b';
+    wtl::string str(haystack);
+
+    EXPECT_EQ(str.rfind('b'), 77);
+    EXPECT_EQ(str.rfind('b', 77), 77);
+    EXPECT_EQ(str.rfind('b', 78), wtl::string::npos);
+    EXPECT_EQ(str.rfind('c'), wtl::string::npos);
+    EXPECT_EQ(wtl::string().rfind('b'), wtl::string::npos);
+    EXPECT_EQ(wtl::string("ab").rfind('a'), 0);
+}
+
+
+TEST(search, rfind_edges)
+{
+    wtl::string str("abdabcabc");
+    EXPECT_EQ(str.rfind(""), 9);
+    EXPECT_EQ(str.rfind("abc"), 6);
+    EXPECT_EQ(str.rfind("abd"), 0);
+    EXPECT_EQ(str.rfind("abd", 1), wtl::string::npos);
+    EXPECT_EQ(str.rfind("abdabcabc"), 0);
+    EXPECT_EQ(str.rfind("xabdabcabc"), wtl::string::npos);
+}
+
+
+TEST(search, rfind_random)
+{
+    std::mt19937 gen(11);
+    for (size_t sublen: {1, 2, 3, 8, 17, 40, 65, 300}) {
+        for (char alphabet: {2, 4, 26}) {
+            for (int trial = 0; trial < 20; ++trial) {
+                std::string haystack = random_string(gen, 1000, alphabet);
+                std::string needle = random_string(gen, sublen, alphabet);
+                if (trial % 2) {
+                    haystack.replace(trial * 30, sublen, needle);
+                }
+                wtl::string str(haystack);
+                size_t expected = haystack.rfind(needle);
+                for (size_t pos: {0, 1, 33, 500}) {
+                    size_t found = expected != std::string::npos && expected >= pos ? expected : wtl::string::npos;
+                    EXPECT_EQ(str.rfind(needle, pos), found);
+                }
+            }
+        }
+    }
+
+    std::wstring wide = L"path/to/some/file";
+    EXPECT_EQ(wtl::wstring(wide).rfind(wtl::wstring(L"/so")), 7);
+}
+
+
+TEST(search, rfind_pathological)
+{
+    std::string haystack(5000, 'a');
+    std::string needle = std::string(30, 'a');
+    needle[15] = 'b';
+    haystack.replace(100, needle.size(), needle);
+    wtl::string str(haystack);
+
+    EXPECT_EQ(str.rfind(needle), 100);
+}
+
+
+TEST(search, find_last_of_random)
+{
+    std::mt19937 gen(13);
+    for (std::string set: {"", "/", "aeiou", " \t\r\n,;", "abcdefghijklmnopqrstuvwxy"}) {
+        for (size_t length: {0, 1, 15, 16, 33, 100, 1000}) {
+            std::string haystack = random_string(gen, length, 26);
+            wtl::string str(haystack);
+            for (size_t pos: {0, 1, 40}) {
+                size_t of = haystack.find_last_of(set);
+                size_t not_of = haystack.find_last_not_of(set);
+                if (pos > length) {
+                    of = not_of = wtl::string::npos;
+                }
+                EXPECT_EQ(str.find_last_of(set, pos), of != std::string::npos && of >= pos ? of : wtl::string::npos);
+                EXPECT_EQ(str.find_last_not_of(set, pos), not_of != std::string::npos && not_of >= pos ? not_of : wtl::string::npos);
+            }
+        }
+    }
+}
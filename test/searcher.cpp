@@ -0,0 +1,111 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/searcher.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// TESTS
+// -----
+
+
+TEST(searcher, strategy)
+{
+    std::string periodic(40, 'a');
+    std::string random = "the quick brown fox jumps over the lazy dog";
+
+    EXPECT_EQ(wtl::searcher("").strategy(), wtl::search_strategy::empty);
+    EXPECT_EQ(wtl::searcher("a").strategy(), wtl::search_strategy::character);
+    EXPECT_EQ(wtl::searcher("fox").strategy(), wtl::search_strategy::filter);
+    EXPECT_EQ(wtl::searcher(random).strategy(), wtl::search_strategy::horspool);
+    EXPECT_EQ(wtl::searcher(periodic).strategy(), wtl::search_strategy::two_way);
+    EXPECT_EQ(wtl::wsearcher(L"fox").strategy(), wtl::search_strategy::two_way);
+}
+
+
+TEST(searcher, string)
+{
+    std::string data = "GET /index.html HTTP/1.1 GET /favicon.ico HTTP/1.1";
+    wtl::string str(data);
+    wtl::searcher get("GET ");
+    wtl::searcher missing("POST ");
+
+    EXPECT_EQ(str.find(get), 0);
+    EXPECT_EQ(str.find(get, 1), data.find("GET ", 1));
+    EXPECT_EQ(str.rfind(get), data.rfind("GET "));
+    EXPECT_EQ(str.find(missing), wtl::string::npos);
+    EXPECT_EQ(str.rfind(missing), wtl::string::npos);
+    EXPECT_EQ(str.find(get, 100), wtl::string::npos);
+}
+
+
+TEST(searcher, std_search)
+{
+    std::string data = "abcabcabd";
+    std::vector<char> bytes(data.begin(), data.end());
+    wtl::searcher needle("abd");
+
+    auto range = needle(data.begin(), data.end());
+    EXPECT_EQ(range.first - data.begin(), 6);
+    EXPECT_EQ(range.second, data.end());
+    EXPECT_EQ(needle(bytes.begin(), bytes.end()).first - bytes.begin(), 6);
+    EXPECT_EQ(wtl::searcher("abx")(data.begin(), data.end()).first, data.end());
+    EXPECT_EQ(wtl::searcher("")(data.begin(), data.end()).first, data.begin());
+
+#if __cplusplus >= 201703L
+    EXPECT_EQ(std::search(data.begin(), data.end(), needle) - data.begin(), 6);
+#endif
+}
+
+
+TEST(searcher, random)
+{
+    std::mt19937 gen(19);
+    std::uniform_int_distribution<int> letter('a', 'h');
+    for (size_t sublen: {1, 2, 5, 32, 33, 50, 200}) {
+        for (int trial = 0; trial < 20; ++trial) {
+            std::string haystack(2000, '\0');
+            std::string needle(sublen, '\0');
+            for (char &c: haystack) {
+                c = static_cast<char>(letter(gen));
+            }
+            for (char &c: needle) {
+                c = static_cast<char>(letter(gen));
+            }
+            if (trial % 2) {
+                haystack.replace(trial * 50, sublen, needle);
+                haystack.replace(1000 + trial * 20, sublen, needle);
+            }
+
+            wtl::searcher searcher(needle);
+            wtl::string str(haystack);
+            size_t last = haystack.rfind(needle);
+            for (size_t pos: {0, 3, 999}) {
+                EXPECT_EQ(str.find(searcher, pos), haystack.find(needle, pos));
+                EXPECT_EQ(str.rfind(searcher, pos), last != std::string::npos && last >= pos ? last : wtl::string::npos);
+            }
+        }
+    }
+}
+
+
+TEST(searcher, pathological)
+{
+    // a long aperiodic needle whose shifts are all 1 over a run of its
+    // own prefix, which Horspool alone scans in O(n*m)
+    std::string needle = std::string(20000, 'a') + "b" + std::string(10, 'a');
+    std::string haystack(1 << 22, 'a');
+    wtl::searcher searcher(needle);
+    EXPECT_EQ(searcher.strategy(), wtl::search_strategy::horspool);
+
+    wtl::string str(haystack);
+    EXPECT_EQ(str.find(searcher), wtl::string::npos);
+
+    haystack.replace(haystack.size() - needle.size() - 5, needle.size(), needle);
+    str = wtl::string(haystack);
+    EXPECT_EQ(str.find(searcher), haystack.size() - needle.size() - 5);
+    EXPECT_EQ(str.find(searcher, 100), haystack.size() - needle.size() - 5);
+}
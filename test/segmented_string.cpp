@@ -0,0 +1,181 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/segmented_string.hpp>
+
+#include <random>
+
+// HELPERS
+// -------
+
+
+/** \brief Split `str` at random points, including empty segments.
+ */
+static wtl::segmented_string split_random(const std::string &str,
+    std::mt19937 &gen,
+    size_t max_segment)
+{
+    wtl::segmented_string segmented;
+    for (size_t i = 0; i < str.size();) {
+        size_t length = std::min<size_t>(gen() % (max_segment + 1), str.size() - i);
+        segmented.push_back(wtl::string(str.data() + i, length));
+        i += length;
+    }
+    return segmented;
+}
+
+// TESTS
+// -----
+
+
+TEST(segmented_string, constructors)
+{
+    wtl::segmented_string empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_EQ(empty.begin(), empty.end());
+
+    wtl::segmented_string str = {"ring", "", "buf", "fer"};
+    EXPECT_EQ(str.size(), 10);
+    EXPECT_EQ(str.segments().size(), 3);
+    EXPECT_EQ(str.segment_offset(1), 4);
+    EXPECT_EQ(str.segment_offset(2), 7);
+    EXPECT_EQ(std::string(str), "ringbuffer");
+
+    str.clear();
+    EXPECT_TRUE(str.empty());
+    EXPECT_TRUE(str.segments().empty());
+}
+
+
+TEST(segmented_string, element_access)
+{
+    wtl::segmented_string str = {"ab", "c", "def"};
+    EXPECT_EQ(str[0], 'a');
+    EXPECT_EQ(str[2], 'c');
+    EXPECT_EQ(str[5], 'f');
+    EXPECT_EQ(str.at(3), 'd');
+    EXPECT_EQ(str.front(), 'a');
+    EXPECT_EQ(str.back(), 'f');
+    EXPECT_THROW(str.at(6), std::out_of_range);
+}
+
+
+TEST(segmented_string, iterator)
+{
+    wtl::segmented_string str = {"ab", "c", "def"};
+    EXPECT_EQ(std::string(str.begin(), str.end()), "abcdef");
+    EXPECT_EQ(std::string(str.rbegin(), str.rend()), "fedcba");
+    EXPECT_EQ(str.end() - str.begin(), 6);
+
+    auto it = str.begin() + 4;
+    EXPECT_EQ(*it, 'e');
+    EXPECT_EQ(it[-2], 'c');
+    it -= 3;
+    EXPECT_EQ(*it, 'b');
+    EXPECT_EQ(*--str.end(), 'f');
+    EXPECT_TRUE(str.begin() < it);
+    EXPECT_EQ(std::find(str.begin(), str.end(), 'd') - str.begin(), 3);
+}
+
+
+TEST(segmented_string, find)
+{
+    wtl::segmented_string str = {"a nee", "d", "le and a nee", "dle"};
+    EXPECT_EQ(str.find("needle"), 2);
+    EXPECT_EQ(str.find("needle", 3), 15);
+    EXPECT_EQ(str.find("needle", 16), wtl::segmented_string::npos);
+    EXPECT_EQ(str.find("and"), 9);
+    EXPECT_EQ(str.find(""), 0);
+    EXPECT_EQ(str.find("", 21), 21);
+    EXPECT_EQ(str.find("", 22), wtl::segmented_string::npos);
+    EXPECT_EQ(str.find('d'), 5);
+    EXPECT_EQ(str.find('d', 6), 11);
+    EXPECT_EQ(str.find('z'), wtl::segmented_string::npos);
+    EXPECT_TRUE(str.contains("dle and"));
+    EXPECT_FALSE(str.contains("needles"));
+}
+
+
+TEST(segmented_string, find_random)
+{
+    std::mt19937 gen(7);
+    std::string haystack;
+    for (size_t i = 0; i < 2000; ++i) {
+        haystack.push_back("ab"[gen() % 2]);
+    }
+
+    for (const std::string needle: {"a", "ab", "abba", "aabab", "bbbbbbbb", "abababababab"}) {
+        for (size_t max_segment: {1, 3, 7, 64}) {
+            wtl::segmented_string str = split_random(haystack, gen, max_segment);
+            for (size_t pos = 0; pos < haystack.size(); pos += 97) {
+                EXPECT_EQ(str.find(wtl::string(needle), pos), haystack.find(needle, pos));
+            }
+        }
+    }
+}
+
+
+TEST(segmented_string, compare)
+{
+    wtl::segmented_string str = {"ab", "c", "def"};
+    wtl::segmented_string other = {"abc", "de", "f"};
+    EXPECT_EQ(str.compare(other), 0);
+    EXPECT_EQ(str, other);
+    EXPECT_EQ(str, wtl::string("abcdef"));
+    EXPECT_EQ(wtl::string("abcdef"), str);
+    EXPECT_NE(str, wtl::string("abcde"));
+    EXPECT_LT(str.compare(wtl::string("abcdeg")), 0);
+    EXPECT_GT(str.compare(wtl::string("abcde")), 0);
+    EXPECT_LT(str.compare(wtl::string("abcdefg")), 0);
+
+    wtl::segmented_string longer = {"abc", "defg"};
+    EXPECT_LT(str, longer);
+    EXPECT_GT(longer.compare(str), 0);
+}
+
+
+TEST(segmented_string, substr)
+{
+    wtl::segmented_string str = {"ab", "c", "def"};
+    wtl::segmented_string sub = str.substr(1, 4);
+    EXPECT_EQ(sub, wtl::string("bcde"));
+    EXPECT_EQ(sub.segments().size(), 3);
+    EXPECT_EQ(str.substr(3), wtl::string("def"));
+    EXPECT_EQ(str.substr(3).segments().size(), 1);
+    EXPECT_TRUE(str.substr(6).empty());
+    EXPECT_THROW(str.substr(7), std::out_of_range);
+
+    char buffer[8] = {};
+    EXPECT_EQ(str.copy(buffer, 4, 1), 4);
+    EXPECT_EQ(std::string(buffer), "bcde");
+    EXPECT_EQ(str.copy(buffer, 8, 4), 2);
+}
+
+
+TEST(segmented_string, wide)
+{
+    wtl::u32segmented_string str = {U"ne", U"ed", U"le"};
+    EXPECT_EQ(str.find(U"edl"), 2);
+    EXPECT_EQ(str.find(U'l'), 4);
+    EXPECT_EQ(str, wtl::u32string(U"needle"));
+}
+
+#if defined(WTL_POSIX)
+
+TEST(segmented_string, iovec)
+{
+    wtl::u16segmented_string str = {u"ab", u"cde"};
+    std::vector<struct iovec> iov = str.to_iovec();
+    ASSERT_EQ(iov.size(), 2);
+    EXPECT_EQ(iov[0].iov_base, str.segments()[0].data());
+    EXPECT_EQ(iov[0].iov_len, 4);
+    EXPECT_EQ(iov[1].iov_len, 6);
+
+    struct iovec one[1];
+    EXPECT_EQ(str.to_iovec(one, 1), 1);
+    EXPECT_EQ(one[0].iov_len, 4);
+}
+
+#endif
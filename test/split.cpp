@@ -0,0 +1,97 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/split.hpp>
+
+#include <algorithm>
+#include <vector>
+
+// HELPERS
+// -------
+
+template <typename Range>
+static std::vector<std::string> tokens(const Range &range)
+{
+    std::vector<std::string> list;
+    for (const wtl::string &token: range) {
+        list.emplace_back(token.data(), token.size());
+    }
+    return list;
+}
+
+typedef std::vector<std::string> list;
+
+// TESTS
+// -----
+
+
+TEST(split, character)
+{
+    std::string data = "a,bc,,d,";
+    wtl::string str(data);
+    EXPECT_EQ(tokens(wtl::split(str, ',')), (list {"a", "bc", "", "d", ""}));
+    EXPECT_EQ(tokens(wtl::split(str, ',', wtl::split_empty::skip)), (list {"a", "bc", "d"}));
+    EXPECT_EQ(tokens(wtl::split(str, ';')), (list {"a,bc,,d,"}));
+    EXPECT_EQ(tokens(wtl::split(wtl::string(""), ',')), (list {""}));
+    EXPECT_EQ(tokens(wtl::split(wtl::string(), ',')), (list {""}));
+    EXPECT_EQ(tokens(wtl::split(wtl::string(), "::")), (list {""}));
+    EXPECT_EQ(tokens(wtl::split(wtl::string(), ',', wtl::split_empty::skip)), list {});
+    EXPECT_EQ(tokens(wtl::split(wtl::string(""), ',', wtl::split_empty::skip)), list {});
+    EXPECT_EQ(tokens(wtl::split(wtl::string(",,"), ',', wtl::split_empty::skip)), list {});
+
+    // tokens are views into the source
+    auto range = wtl::split(str, ',');
+    EXPECT_EQ(range.begin()->data(), data.data());
+    EXPECT_EQ(std::next(range.begin())->data(), data.data() + 2);
+}
+
+
+TEST(split, substr)
+{
+    wtl::string str("one::two:three::::four");
+    EXPECT_EQ(tokens(wtl::split(str, "::")), (list {"one", "two:three", "", "four"}));
+    EXPECT_EQ(tokens(wtl::split(str, std::string("::"), wtl::split_empty::skip)), (list {"one", "two:three", "four"}));
+    EXPECT_EQ(tokens(wtl::split(str, "")), (list {"one::two:three::::four"}));
+    EXPECT_EQ(tokens(wtl::split(str, "four")), (list {"one::two:three::::", ""}));
+
+    wtl::u32string wide(U"x--y--z");
+    auto range = wtl::split(wide, U"--");
+    EXPECT_EQ(std::distance(range.begin(), range.end()), 3);
+    EXPECT_EQ(*std::next(range.begin(), 2), wtl::u32string(U"z"));
+}
+
+
+TEST(split, byteset)
+{
+    std::string data(100, 'x');
+    data[10] = ' ';
+    data[11] = '\t';
+    data[50] = '\n';
+    data[99] = ' ';
+    wtl::string str(data);
+    wtl::byteset whitespace(" \t\n");
+    EXPECT_EQ(tokens(wtl::split(str, whitespace)), (list {std::string(10, 'x'), "", std::string(38, 'x'), std::string(48, 'x'), ""}));
+    EXPECT_EQ(tokens(wtl::split(str, whitespace, wtl::split_empty::skip)).size(), 3);
+}
+
+
+TEST(split, algorithm)
+{
+    wtl::string str("b a c a");
+    auto range = wtl::split(str, ' ');
+    EXPECT_EQ(std::count(range.begin(), range.end(), wtl::string("a")), 2);
+    EXPECT_EQ(std::find(range.begin(), range.end(), wtl::string("c"))->data(), str.data() + 4);
+
+    std::vector<wtl::string> words(range.begin(), range.end());
+    std::sort(words.begin(), words.end());
+    EXPECT_EQ(words.front(), "a");
+    EXPECT_EQ(words.back(), "c");
+
+    auto it = range.begin();
+    auto copy = it++;
+    EXPECT_EQ(*copy, "b");
+    EXPECT_EQ(*it, "a");
+    EXPECT_TRUE(copy != it);
+    EXPECT_TRUE(++copy == it);
+}
@@ -0,0 +1,129 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/stream_searcher.hpp>
+
+#include <random>
+
+// HELPERS
+// -------
+
+
+/** \brief Offsets of every match, overlapping ones included.
+ */
+static std::vector<size_t> find_all(const std::string &haystack,
+    const std::string &needle)
+{
+    std::vector<size_t> offsets;
+    for (size_t i = haystack.find(needle); i != std::string::npos; i = haystack.find(needle, i + 1)) {
+        offsets.push_back(i);
+    }
+    return offsets;
+}
+
+
+/** \brief Split `haystack` at random points and feed each chunk.
+ */
+static std::vector<size_t> feed_chunks(wtl::stream_searcher &searcher,
+    const std::string &haystack,
+    std::mt19937 &gen,
+    size_t max_chunk)
+{
+    std::vector<size_t> offsets;
+    for (size_t i = 0; i < haystack.size();) {
+        size_t length = std::min<size_t>(gen() % (max_chunk + 1), haystack.size() - i);
+        searcher.feed(wtl::string(haystack.data() + i, length), [&offsets](size_t offset) {
+            offsets.push_back(offset);
+        });
+        i += length;
+    }
+    return offsets;
+}
+
+// TESTS
+// -----
+
+
+TEST(stream_searcher, boundary)
+{
+    wtl::stream_searcher searcher("needle");
+    EXPECT_TRUE(searcher.feed("a nee").empty());
+    EXPECT_EQ(searcher.pending(), 3);
+    EXPECT_TRUE(searcher.feed("d").empty());
+    EXPECT_EQ(searcher.feed("le and a needle"), (std::vector<size_t> {2, 15}));
+    EXPECT_EQ(searcher.offset(), 21);
+
+    searcher.reset();
+    EXPECT_EQ(searcher.pending(), 0);
+    EXPECT_EQ(searcher.feed("needle"), std::vector<size_t> {0});
+
+    wtl::stream_searcher empty("");
+    EXPECT_TRUE(empty.feed("abc").empty());
+}
+
+
+TEST(stream_searcher, overlapping)
+{
+    wtl::stream_searcher searcher("aa");
+    EXPECT_EQ(searcher.feed("a"), std::vector<size_t> {});
+    EXPECT_EQ(searcher.feed("aa"), (std::vector<size_t> {0, 1}));
+    EXPECT_EQ(searcher.feed(""), std::vector<size_t> {});
+    EXPECT_EQ(searcher.feed("xa"), std::vector<size_t> {});
+    EXPECT_EQ(searcher.feed("a"), std::vector<size_t> {4});
+}
+
+
+TEST(stream_searcher, random)
+{
+    std::mt19937 gen(13);
+    for (size_t trial = 0; trial < 200; ++trial) {
+        std::string haystack(500, 'a');
+        for (char &c: haystack) {
+            c = static_cast<char>('a' + gen() % 2);
+        }
+        std::string needle(1 + gen() % 8, 'a');
+        for (char &c: needle) {
+            c = static_cast<char>('a' + gen() % 2);
+        }
+
+        wtl::stream_searcher searcher(needle);
+        for (size_t max_chunk: {1, 3, 16, 100}) {
+            searcher.reset();
+            EXPECT_EQ(feed_chunks(searcher, haystack, gen, max_chunk), find_all(haystack, needle)) << needle;
+        }
+    }
+}
+
+
+TEST(stream_searcher, wide)
+{
+    wtl::u32stream_searcher searcher(U"xy");
+    EXPECT_TRUE(searcher.feed(U"abx").empty());
+    EXPECT_EQ(searcher.feed(U"yxy"), (std::vector<size_t> {2, 4}));
+}
+
+
+TEST(stream_searcher, multi)
+{
+    wtl::multi_searcher searcher({"he", "she", "his", "hers"});
+    wtl::multi_stream_searcher stream(searcher);
+    std::string haystack = "ushers and his shed";
+
+    std::vector<wtl::multi_searcher::match> expected = searcher.find_all(haystack);
+    std::vector<wtl::multi_searcher::match> matches;
+    for (size_t i = 0; i < haystack.size(); i += 2) {
+        for (const auto &m: stream.feed(wtl::string(haystack).substr(i, 2))) {
+            matches.push_back(m);
+        }
+    }
+    ASSERT_EQ(matches.size(), expected.size());
+    for (size_t i = 0; i < matches.size(); ++i) {
+        EXPECT_EQ(matches[i].pattern, expected[i].pattern);
+        EXPECT_EQ(matches[i].offset, expected[i].offset);
+    }
+    EXPECT_EQ(stream.offset(), haystack.size());
+
+    stream.reset();
+    EXPECT_EQ(stream.feed("she").size(), 2);
+}
@@ -26,10 +26,14 @@ TEST(string, constructors)
     str = wtl::string(STR.data(), STR.size());
     EXPECT_EQ(str.size(), 14);
 
-    str = std::move(other);
-    EXPECT_EQ(str.size(), 0);
+    // moving a view copies it, and leaves the source unchanged
+    other = std::move(str);
+    EXPECT_EQ(str.size(), 14);
     EXPECT_EQ(other.size(), 14);
 
+    str = wtl::string();
+    EXPECT_EQ(str.size(), 0);
+
     str = other;
     EXPECT_EQ(str.size(), 14);
     EXPECT_EQ(other.size(), 14);
@@ -264,6 +268,35 @@ TEST(string, operations)
 }
 
 
+TEST(string, count)
+{
+    std::string data(1000, 'a');
+    for (size_t i = 0; i < data.size(); i += 7) {
+        data[i] = '\n';
+    }
+    data[500] = ',';
+    wtl::string str(data);
+
+    EXPECT_EQ(str.count('\n'), 143);
+    EXPECT_EQ(str.count(','), 1);
+    EXPECT_EQ(str.substr(1, 6).count('\n'), 0);
+    EXPECT_EQ(str.count_of(wtl::byteset(",\n")), 144);
+    EXPECT_EQ(str.count_of("ab"), 856);
+    EXPECT_TRUE(str.contains(','));
+    EXPECT_FALSE(str.contains('b'));
+
+    wtl::string text("aaaa abab");
+    EXPECT_EQ(text.count("aa"), 2);
+    EXPECT_EQ(text.count("ab"), 2);
+    EXPECT_EQ(text.count("abc"), 0);
+    EXPECT_EQ(text.count(""), 10);
+    EXPECT_TRUE(text.contains("a ab"));
+    EXPECT_TRUE(text.contains(""));
+    EXPECT_FALSE(text.contains("aaaaa"));
+    EXPECT_TRUE(wtl::string().contains(""));
+}
+
+
 TEST(string, conversions)
 {
     wtl::string str(STR);
@@ -274,3 +307,33 @@ TEST(string, conversions)
     EXPECT_EQ(std::string(str), STR);
     EXPECT_EQ(std::string(other), "");
 }
+
+
+TEST(string, constexpr)
+{
+    static_assert(std::is_trivially_copyable<wtl::string>::value, "");
+    static_assert(std::is_trivially_copyable<wtl::u32string>::value, "");
+
+    constexpr wtl::string literal("constexpr literal", 9);
+    static_assert(literal.size() == 9, "");
+    static_assert(!literal.empty(), "");
+    static_assert(literal.end() - literal.begin() == 9, "");
+    EXPECT_EQ(literal, wtl::string("constexpr"));
+
+#if __cplusplus >= 201402L
+    static_assert(literal[0] == 'c' && literal.back() == 'r', "");
+    static_assert(literal.substr(3, 3).size() == 3, "");
+#endif
+
+#if defined(WTL_HAS_CONSTEXPR_DISPATCH)
+    constexpr wtl::string str("needle in a haystack");
+    static_assert(str.size() == 20, "");
+    static_assert(str.find("hay") == 12, "");
+    static_assert(str.find("hey") == wtl::string::npos, "");
+    static_assert(str.find('i') == 7, "");
+    static_assert(str.substr(0, 6) == "needle", "");
+    static_assert(str < "needles", "");
+    static_assert(str.compare("needle") > 0, "");
+    static_assert(wtl::u16string(u"wide") != u"wider", "");
+#endif
+}
@@ -0,0 +1,85 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/tokenizer.hpp>
+
+#include <random>
+#include <vector>
+
+// HELPERS
+// -------
+
+/** \brief Tokenize with `split` as the reference.
+ */
+static std::vector<uint32_t> expected(const wtl::string &str,
+    const wtl::byteset &set,
+    wtl::split_empty empty)
+{
+    std::vector<uint32_t> offsets;
+    for (const wtl::string &token: wtl::split(str, set, empty)) {
+        offsets.push_back(static_cast<uint32_t>(token.data() - str.data()));
+        offsets.push_back(static_cast<uint32_t>(token.size()));
+    }
+    return offsets;
+}
+
+// TESTS
+// -----
+
+
+TEST(tokenizer, tokenize)
+{
+    wtl::tokenizer whitespace(" \t\n");
+    std::vector<uint32_t> buffer(64);
+    auto tokens = whitespace.tokens("  ab c\t\tdef\n", buffer.data(), buffer.size());
+    EXPECT_EQ(std::vector<uint32_t>(tokens.begin(), tokens.end()), (std::vector<uint32_t> {2, 2, 5, 1, 8, 3}));
+    EXPECT_EQ(whitespace.tokenize("", buffer.data(), buffer.size()), 0);
+    EXPECT_EQ(whitespace.tokenize("   ", buffer.data(), buffer.size()), 0);
+    EXPECT_EQ(whitespace.tokenize("x", buffer.data(), buffer.size()), 1);
+
+    wtl::tokenizer comma(",", wtl::split_empty::keep);
+    tokens = comma.tokens("a,,bc,", buffer.data(), buffer.size());
+    EXPECT_EQ(std::vector<uint32_t>(tokens.begin(), tokens.end()), (std::vector<uint32_t> {0, 1, 2, 0, 3, 2, 6, 0}));
+    EXPECT_EQ(comma.tokenize("", buffer.data(), buffer.size()), 1);
+}
+
+
+TEST(tokenizer, random)
+{
+    std::mt19937 gen(5);
+    const char alphabet[] = "abc ,\t";
+    wtl::byteset set(" ,\t");
+    for (size_t length: {1, 63, 64, 65, 127, 128, 4095, 4096, 4097, 10000}) {
+        for (size_t density: {2, 6}) {
+            std::string data(length, 'a');
+            for (char &c: data) {
+                c = alphabet[gen() % density];
+            }
+            wtl::string str(data);
+            for (wtl::split_empty empty: {wtl::split_empty::skip, wtl::split_empty::keep}) {
+                std::vector<uint32_t> buffer(wtl::tokenizer::bound(length));
+                wtl::tokenizer tokenizer(set, empty);
+                for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+                    wtl::set_isa(static_cast<wtl::isa>(i));
+                    auto tokens = tokenizer.tokens(str, buffer.data(), buffer.size());
+                    EXPECT_EQ(std::vector<uint32_t>(tokens.begin(), tokens.end()), expected(str, set, empty)) << length;
+                }
+                wtl::reset_isa();
+            }
+        }
+    }
+}
+
+
+TEST(tokenizer, capacity)
+{
+    wtl::tokenizer whitespace(" ");
+    std::vector<uint32_t> buffer(4);
+    EXPECT_EQ(whitespace.tokenize("a b", buffer.data(), buffer.size()), 2);
+    EXPECT_THROW(whitespace.tokenize("a b c", buffer.data(), buffer.size()), std::length_error);
+
+    std::string data(64, 'a');
+    EXPECT_THROW(whitespace.tokenize(data, buffer.data(), 1), std::length_error);
+    EXPECT_EQ(whitespace.tokenize(data, buffer.data(), 2), 1);
+}
@@ -0,0 +1,192 @@
+//  :copyright: (c) 2017 Alex Huszagh.
+//  :license: BSD-like or MIT, see LICENSE.md for more details.
+
+#include <gtest/gtest.h>
+#include <wtl/utf8.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+/** \brief Offset of the first invalid sequence, decoding code points.
+ */
+static size_t reference(const std::string &str)
+{
+    size_t i = 0;
+    while (i < str.size()) {
+        const unsigned char c = static_cast<unsigned char>(str[i]);
+        size_t length;
+        uint32_t code;
+        uint32_t minimum;
+        if (c < 0x80) {
+            ++i;
+            continue;
+        } else if ((c & 0xE0) == 0xC0) {
+            length = 2;
+            code = c & 0x1F;
+            minimum = 0x80;
+        } else if ((c & 0xF0) == 0xE0) {
+            length = 3;
+            code = c & 0x0F;
+            minimum = 0x800;
+        } else if ((c & 0xF8) == 0xF0) {
+            length = 4;
+            code = c & 0x07;
+            minimum = 0x10000;
+        } else {
+            return i;
+        }
+        if (i + length > str.size()) {
+            return i;
+        }
+        for (size_t j = 1; j < length; ++j) {
+            const unsigned char next = static_cast<unsigned char>(str[i + j]);
+            if ((next & 0xC0) != 0x80) {
+                return i;
+            }
+            code = (code << 6) | (next & 0x3F);
+        }
+        if (code < minimum || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+            return i;
+        }
+        i += length;
+    }
+    return str.size();
+}
+
+
+/** \brief Random mix of ASCII, valid sequences and stray bytes.
+ */
+static std::string random_text(std::mt19937_64 &gen,
+    size_t size,
+    unsigned errors)
+{
+    static const char *samples[] = {
+        "a", "Z", "\n", "\xC2\x80", "\xDF\xBF", "\xC3\xA9", "\xE0\xA0\x80", "\xE2\x82\xAC",
+        "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF",
+    };
+    std::string str;
+    while (str.size() < size) {
+        if (gen() % 1000 < errors) {
+            str.push_back(static_cast<char>(gen()));
+        } else if (gen() % 4) {
+            str.push_back(static_cast<char>('a' + gen() % 26));
+        } else {
+            str += samples[gen() % (sizeof(samples) / sizeof(samples[0]))];
+        }
+    }
+    return str;
+}
+
+// TESTS
+// -----
+
+
+TEST(utf8, validate)
+{
+    const std::vector<std::pair<std::string, size_t>> cases = {
+        {"", 0},
+        {"hello", 5},
+        {"\xC3\xA9t\xC3\xA9", 5},
+        {"\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E", 9},
+        {"\xF0\x9F\x98\x80", 4},
+        {"\xF4\x8F\xBF\xBF", 4},
+        {"\x80", 0},
+        {"a\xBF", 1},
+        {"\xC0\x80", 0},
+        {"\xC1\xBF", 0},
+        {"\xC2", 0},
+        {"ab\xC2z", 2},
+        {"\xE0\x9F\xBF", 0},
+        {"\xE0\xA0", 0},
+        {"\xED\xA0\x80", 0},
+        {"\xED\x9F\xBF", 3},
+        {"\xF0\x8F\xBF\xBF", 0},
+        {"\xF4\x90\x80\x80", 0},
+        {"\xF5\x80\x80\x80", 0},
+        {"\xFF", 0},
+        {"abc\xF0\x9F\x98", 3},
+        {"\xE2\x82\xAC\x80", 3},
+    };
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::set_isa(static_cast<wtl::isa>(i));
+        for (const auto &item: cases) {
+            EXPECT_EQ(wtl::utf8::validate(item.first), item.second) << item.first;
+            EXPECT_EQ(reference(item.first), item.second) << item.first;
+
+            // at every position relative to the 64-byte blocks
+            std::mt19937_64 gen(i);
+            for (size_t pad = 1; pad < 130; ++pad) {
+                const std::string ascii = std::string(pad, 'x') + item.first;
+                EXPECT_EQ(wtl::utf8::validate(ascii), pad + item.second) << pad << item.first;
+                const std::string text = random_text(gen, pad, 0) + item.first + "tail";
+                EXPECT_EQ(wtl::utf8::validate(text), reference(text)) << pad << item.first;
+            }
+        }
+    }
+    wtl::reset_isa();
+}
+
+
+TEST(utf8, random)
+{
+    std::mt19937_64 gen(17);
+    for (size_t i = 0; i < 3000; ++i) {
+        const std::string str = random_text(gen, gen() % 300, static_cast<unsigned>(gen() % 4));
+        const size_t expected = reference(str);
+        for (size_t j = 0; j <= static_cast<size_t>(wtl::detected_isa()); ++j) {
+            wtl::set_isa(static_cast<wtl::isa>(j));
+            EXPECT_EQ(wtl::utf8::validate(str), expected);
+        }
+    }
+    wtl::reset_isa();
+}
+
+
+TEST(utf8, stream)
+{
+    std::mt19937_64 gen(23);
+    for (size_t i = 0; i < 2000; ++i) {
+        const std::string str = random_text(gen, gen() % 200, static_cast<unsigned>(gen() % 3));
+        const size_t expected = reference(str);
+
+        // random chunks, including empty ones and single bytes
+        wtl::utf8::stream_validator validator;
+        bool valid = true;
+        size_t offset = 0;
+        while (offset < str.size()) {
+            const size_t size = std::min<size_t>(str.size() - offset, gen() % 6 == 0 ? 0 : gen() % 70);
+            valid = validator.feed(wtl::string(str.data() + offset, size)) && valid;
+            offset += size;
+        }
+        valid = validator.finish() && valid;
+        EXPECT_EQ(valid, expected == str.size()) << i;
+        EXPECT_EQ(validator.failed(), !valid);
+        EXPECT_EQ(validator.valid_size(), expected) << i;
+        EXPECT_EQ(validator.offset(), str.size());
+    }
+
+    wtl::utf8::stream_validator validator;
+    EXPECT_TRUE(validator.feed("ab\xF0\x9F"));
+    EXPECT_EQ(validator.pending(), 2);
+    EXPECT_EQ(validator.valid_size(), 2);
+    EXPECT_TRUE(validator.feed("\x98"));
+    EXPECT_TRUE(validator.feed("\x80z"));
+    EXPECT_EQ(validator.pending(), 0);
+    EXPECT_EQ(validator.valid_size(), 7);
+    EXPECT_TRUE(validator.feed("\xE2"));
+    EXPECT_FALSE(validator.finish());
+    EXPECT_EQ(validator.valid_size(), 7);
+
+    validator.reset();
+    EXPECT_TRUE(validator.feed("\xED"));
+    EXPECT_FALSE(validator.feed("\xA0\x80"));
+    EXPECT_FALSE(validator.feed("a"));
+    EXPECT_EQ(validator.valid_size(), 0);
+    EXPECT_EQ(validator.offset(), 4);
+}
@@ -2,8 +2,12 @@
 //  :license: BSD-like or MIT, see LICENSE.md for more details.
 
 #include <gtest/gtest.h>
+#include <wtl/dispatch.hpp>
 #include <wtl/vector.hpp>
 
+#include <cmath>
+#include <random>
+
 // DATA
 // ----
 
@@ -26,10 +30,14 @@ TEST(vector, constructors)
     vector = wtl::vector<int>(VEC.data(), VEC.size());
     EXPECT_EQ(vector.size(), 6);
 
-    vector = std::move(other);
-    EXPECT_EQ(vector.size(), 0);
+    // moving a view copies it, and leaves the source unchanged
+    other = std::move(vector);
+    EXPECT_EQ(vector.size(), 6);
     EXPECT_EQ(other.size(), 6);
 
+    vector = wtl::vector<int>();
+    EXPECT_EQ(vector.size(), 0);
+
     vector = other;
     EXPECT_EQ(vector.size(), 6);
     EXPECT_EQ(other.size(), 6);
@@ -134,6 +142,58 @@ TEST(vector, modifier)
 }
 
 
+/** \brief Compare the SIMD `count` and `contains` against the STL.
+ */
+template <typename T>
+static void check_search(std::mt19937 &gen)
+{
+    std::vector<T> data(1000);
+    for (T &value: data) {
+        value = static_cast<T>(gen() % 5);
+    }
+    for (size_t i = 0; i <= static_cast<size_t>(wtl::detected_isa()); ++i) {
+        wtl::set_isa(static_cast<wtl::isa>(i));
+        for (size_t length: {0, 1, 7, 31, 32, 33, 200, 1000}) {
+            wtl::vector<T> vector(data.data(), length);
+            for (T value: {T(0), T(3), T(9)}) {
+                EXPECT_EQ(vector.count(value), size_t(std::count(data.begin(), data.begin() + length, value)));
+                EXPECT_EQ(vector.contains(value), std::find(data.begin(), data.begin() + length, value) != data.begin() + length);
+            }
+        }
+    }
+    wtl::reset_isa();
+}
+
+
+TEST(vector, search)
+{
+    std::mt19937 gen(9);
+    check_search<char>(gen);
+    check_search<uint16_t>(gen);
+    check_search<int32_t>(gen);
+    check_search<int64_t>(gen);
+    check_search<float>(gen);
+    check_search<double>(gen);
+
+    // 64-bit lanes must match both halves
+    std::vector<uint64_t> wide = {1, uint64_t(1) << 32, (uint64_t(1) << 32) | 1, 1};
+    EXPECT_EQ(wtl::vector<uint64_t>(wide).count(1), 2);
+
+    // IEEE equality, as with operator==
+    std::vector<double> floats(40, 0.0);
+    floats[3] = -0.0;
+    floats[5] = NAN;
+    wtl::vector<double> vector(floats);
+    EXPECT_EQ(vector.count(0.0), 39);
+    EXPECT_EQ(vector.count(NAN), 0);
+    EXPECT_FALSE(vector.contains(NAN));
+
+    std::vector<int> values = {3, 1, 3};
+    EXPECT_EQ(wtl::vector<int>(VEC).count_of(values), 2);
+    EXPECT_EQ(wtl::vector<int>(VEC).count_of(EMPTY), 0);
+}
+
+
 TEST(vector, conversions)
 {
     wtl::vector<int> vector(VEC);
@@ -145,3 +205,21 @@ TEST(vector, conversions)
     EXPECT_EQ(std::vector<int>(vector), VEC);
     EXPECT_EQ(std::vector<int>(other), EMPTY);
 }
+
+
+TEST(vector, constexpr)
+{
+    static_assert(std::is_trivially_copyable<wtl::vector<int>>::value, "");
+    static_assert(std::is_trivially_copyable<wtl::vector<double>>::value, "");
+
+    static constexpr int array[] = {1, 2, 3, 4};
+    constexpr wtl::vector<int> vector(array, 4);
+    static_assert(vector.size() == 4, "");
+    static_assert(vector.data() == array, "");
+    static_assert(vector.end() - vector.begin() == 4, "");
+    static_assert(wtl::vector<int>(array, array + 2).size() == 2, "");
+#if __cplusplus >= 201402L
+    static_assert(vector[1] == 2 && vector.front() == 1 && vector.back() == 4, "");
+#endif
+    EXPECT_EQ(vector.count(3), 1);
+}